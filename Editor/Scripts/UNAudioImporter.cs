@@ -27,6 +27,17 @@ namespace UNAudio.Editor
             // Read raw file bytes
             byte[] audioData = File.ReadAllBytes(ctx.assetPath);
 
+            // ADPCM clips are transcoded here so players skip the work at load time.
+            // If the native decoder can't read the source, the runtime transcodes instead.
+            if (compressionMode == AudioLoadType.ADPCM)
+            {
+                byte[] adpcm = UNAudioBridge.TranscodeADPCM(audioData);
+                if (adpcm != null)
+                    audioData = adpcm;
+                else
+                    ctx.LogImportWarning($"[UNAudio] ADPCM transcode failed for {ctx.assetPath}; deferring to load time.");
+            }
+
             // Create the clip ScriptableObject
             var clip = ScriptableObject.CreateInstance<UNAudioClip>();
             clip.name = Path.GetFileNameWithoutExtension(ctx.assetPath);
@@ -38,7 +49,8 @@ namespace UNAudio.Editor
                 ch:   2,
                 bps:  16,
                 len:  0f,
-                data: audioData
+                data: audioData,
+                type: compressionMode
             );
 
             ctx.AddObjectToAsset("main", clip);
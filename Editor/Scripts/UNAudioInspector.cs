@@ -6,7 +6,7 @@ namespace UNAudio.Editor
 {
     /// <summary>
     /// Custom Inspector for <see cref="UNAudioClip"/> assets.
-    /// Shows metadata, memory usage, and playback controls.
+    /// Shows metadata, memory usage, waveform, and playback controls.
     /// </summary>
     [CustomEditor(typeof(UNAudioClip))]
     public class UNAudioInspector : UnityEditor.Editor
@@ -31,6 +31,8 @@ namespace UNAudio.Editor
 
             EditorGUILayout.Space();
 
+            DrawWaveform(clip);
+
             // Preview controls
             EditorGUILayout.LabelField("Preview", EditorStyles.boldLabel);
 
@@ -47,6 +49,58 @@ namespace UNAudio.Editor
                 }
             }
         }
+
+        // ── Waveform ─────────────────────────────────────────────
+
+        private const float WaveformHeight = 64f;
+        private static readonly Color WaveformPeak = new Color(1.0f, 0.55f, 0.1f);
+        private static readonly Color WaveformRms  = new Color(1.0f, 0.75f, 0.35f);
+
+        private UNAudioPeakBin[] peaks;
+        private int peaksLevel = -1;
+
+        private void DrawWaveform(UNAudioClip clip)
+        {
+            if (!clip.IsLoaded) return;
+
+            EditorGUILayout.LabelField("Waveform", EditorStyles.boldLabel);
+            Rect rect = GUILayoutUtility.GetRect(0f, WaveformHeight, GUILayout.ExpandWidth(true));
+            EditorGUILayout.Space();
+            if (Event.current.type != EventType.Repaint || rect.width < 1f) return;
+            EditorGUI.DrawRect(rect, new Color(0.15f, 0.15f, 0.15f));
+
+            // Coarsest level that still has at least one bin per pixel column.
+            int columns = Mathf.FloorToInt(rect.width);
+            int level = UNAudioClip.WaveformBinFrames.Length - 1;
+            while (level > 0 && UNAudioBridge.GetWaveformPeaks(clip.NativeHandle, level, 0, 0, null) < columns)
+                --level;
+            if (peaks == null || peaksLevel != level)
+            {
+                peaks = clip.GetWaveformPeaks(level);
+                peaksLevel = level;
+            }
+            if (peaks == null || peaks.Length == 0) return;
+
+            float mid = rect.y + rect.height * 0.5f;
+            float scale = rect.height * 0.5f;
+            for (int x = 0; x < columns; x++)
+            {
+                int first = (int)((long)x * peaks.Length / columns);
+                int last = Mathf.Max(first + 1, (int)((long)(x + 1) * peaks.Length / columns));
+                float lo = 0f, hi = 0f, rms = 0f;
+                for (int i = first; i < last && i < peaks.Length; i++)
+                {
+                    lo = Mathf.Min(lo, peaks[i].min);
+                    hi = Mathf.Max(hi, peaks[i].max);
+                    rms = Mathf.Max(rms, peaks[i].rms);
+                }
+                float top = mid - Mathf.Clamp01(hi) * scale;
+                float bottom = mid - Mathf.Clamp(lo, -1f, 0f) * scale;
+                EditorGUI.DrawRect(new Rect(rect.x + x, top, 1f, Mathf.Max(1f, bottom - top)), WaveformPeak);
+                float r = Mathf.Clamp01(rms) * scale;
+                EditorGUI.DrawRect(new Rect(rect.x + x, mid - r, 1f, Mathf.Max(1f, 2f * r)), WaveformRms);
+            }
+        }
     }
 }
 #endif
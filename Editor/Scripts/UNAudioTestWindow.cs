@@ -68,6 +68,9 @@ namespace UNAudio.Editor
                 var stats = UNAudioDebug.GetPerformanceStats();
                 EditorGUILayout.LabelField("Latency",       $"{stats.latencyMs:F1} ms");
                 EditorGUILayout.LabelField("Master Volume",  $"{stats.masterVolume:F2}");
+                string budget = stats.memoryBudget > 0 ? $" / {stats.memoryBudget / 1024} KB" : "";
+                EditorGUILayout.LabelField("Memory",         $"{stats.memoryUsage / 1024} KB{budget}");
+                EditorGUILayout.LabelField("Demoted Clips",  stats.demotedClips.ToString());
             }
             else
             {
@@ -0,0 +1,70 @@
+#ifndef UNAUDIO_AUDIO_CLIP_H
+#define UNAUDIO_AUDIO_CLIP_H
+
+#include "AudioTypes.h"
+#include "../Decoder/AudioDecoder.h"
+#include "../Decoder/DecoderFactory.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class ClipBank;
+class WaveformPeaks;
+
+/// Work item for a clip load.  Shared between the clip and the worker so the
+/// status stays queryable after the clip is published.
+struct LoadTask {
+    std::vector<uint8_t> data;       // owned copy of the encoded clip (if not banked)
+    std::shared_ptr<const ClipBank> bank;
+    const uint8_t* encoded = nullptr;   // points into data or the bank mapping
+    size_t encodedSize = 0;
+    AudioFileFormat format = AudioFileFormat::Unknown;   // from the bank index, else sniffed once
+    UNAudioCompressionMode mode = UNAUDIO_COMPRESS_IN_MEMORY;
+    std::atomic<UNAudioLoadStatus> status{UNAUDIO_LOAD_PENDING};
+    std::atomic<bool> cancelled{false};
+
+    // Results, moved into the clip when the load is published
+    std::unique_ptr<AudioDecoder> decoder;
+    std::vector<float> pcm;
+    UNAudioClipInfo clipInfo{};
+};
+
+/// First frames of a compressed clip, kept decoded for zero-latency starts.
+struct AttackCache {
+    std::vector<float> pcm;
+    int64_t frames = 0;
+};
+
+/// Loaded audio shared by every voice that plays it.  All fields are
+/// immutable once load->status is LOADED, except attackCache, pcm, peaks and
+/// the budget bookkeeping, which change under the engine lock (voices
+/// snapshot attackCache and pcm on start).
+struct AudioClip {
+    std::shared_ptr<LoadTask> load;
+    std::vector<uint8_t> data;       // encoded clip data (decoders read from here)
+    std::shared_ptr<const ClipBank> bank;   // keeps a banked clip's mapping alive
+    const uint8_t* encoded = nullptr;
+    size_t encodedSize = 0;
+    AudioFileFormat format = AudioFileFormat::Unknown;   // of encoded; decoders skip detection
+    std::shared_ptr<const std::vector<float>> pcm;   // DECOMPRESS_ON_LOAD samples; null while demoted
+    UNAudioClipInfo clipInfo{};
+    std::shared_ptr<const AttackCache> attackCache;
+    std::shared_ptr<const WaveformPeaks> peaks;   // built on first query or loaded from a sidecar
+
+    // Memory budget bookkeeping
+    uint64_t lastUsed = 0;    // engine use clock at the last load / start
+    bool promoting = false;   // re-decode of a demoted clip is queued
+
+    /// clipInfo and data are published before the status store, so a true
+    /// result orders every later read of them.
+    bool IsLoaded() const {
+        return load->status.load(std::memory_order_acquire) == UNAUDIO_LOAD_LOADED;
+    }
+
+    /// Whether voices play through a decoder.  DECOMPRESS_ON_LOAD clips read
+    /// pcm instead, falling back to a decoder while the memory budget has
+    /// them demoted.
+    bool NeedsDecoder() const { return clipInfo.compressionMode != UNAUDIO_DECOMPRESS_ON_LOAD; }
+};
+
+#endif // UNAUDIO_AUDIO_CLIP_H
@@ -1,9 +1,77 @@
 #include "AudioEngine.h"
 #include "../Decoder/AudioDecoder.h"
 #include "../Mixer/AudioMixer.h"
+#include "../Mixer/OutputConverter.h"
+#include "../Mixer/Reverb.h"
+#include "../Decoder/ADPCMCodec.h"
+#include "../Decoder/DecoderFactory.h"
 #include "../Platform/AudioOutput.h"
+#include "CallTrace.h"
+#include "ClipBank.h"
+#include "DecodeScheduler.h"
+#include "ThreadPool.h"
+#include "WaveformPeaks.h"
+#include "ZoneTrace.h"
+#include <algorithm>
 #include <cstring>
 
+namespace {
+
+// Frames decoded per step when fully decompressing a clip.  Cancellation is
+// checked between steps.
+constexpr int kDecodeChunkFrames = 4096;
+
+bool IsLoadComplete(UNAudioLoadStatus status) {
+    return status == UNAUDIO_LOAD_LOADED || status == UNAUDIO_LOAD_FAILED ||
+           status == UNAUDIO_LOAD_CANCELLED;
+}
+
+// Decode the remainder of a clip into interleaved float.
+// Returns false if the load was cancelled part-way.
+bool DecodeAll(AudioDecoder& decoder, const std::atomic<bool>& cancelled,
+               std::vector<float>& pcm) {
+    const size_t channels = static_cast<size_t>(decoder.GetFormat().channels);
+    if (decoder.GetTotalFrames() > 0)
+        pcm.reserve(static_cast<size_t>(decoder.GetTotalFrames()) * channels);
+
+    size_t frames = 0;
+    for (;;) {
+        if (cancelled.load(std::memory_order_relaxed)) return false;
+        pcm.resize((frames + kDecodeChunkFrames) * channels);
+        int decoded = decoder.Decode(pcm.data() + frames * channels, kDecodeChunkFrames);
+        if (decoded <= 0) break;
+        frames += static_cast<size_t>(decoded);
+    }
+    pcm.resize(frames * channels);
+    pcm.shrink_to_fit();
+    return true;
+}
+
+std::unique_ptr<AudioDecoder> OpenDecoder(const AudioClip& clip) {
+    return CreateDecoder(clip.format, clip.encoded, clip.encodedSize);
+}
+
+int64_t SampleBytes(const std::vector<float>& samples) {
+    return static_cast<int64_t>(samples.size() * sizeof(float));
+}
+
+int64_t TotalBytes(const UNAudioMemoryUsage& usage) {
+    return usage.compressedBytes + usage.pcmBytes + usage.streamBytes + usage.decoderBytes;
+}
+
+/// Add (sign 1) or take away (sign -1) the buffers a clip owns.  Bank clips
+/// decode from the file mapping, which the OS can page out, so only copies
+/// owned by the clip count as compressed data.
+void CountClip(const AudioClip& clip, int64_t sign, UNAudioMemoryUsage& usage) {
+    const int64_t owned = static_cast<int64_t>(clip.data.size());
+    if (clip.clipInfo.compressionMode == UNAUDIO_STREAMING) usage.streamBytes += sign * owned;
+    else usage.compressedBytes += sign * owned;
+    if (clip.pcm) usage.pcmBytes += sign * SampleBytes(*clip.pcm);
+    if (clip.attackCache) usage.pcmBytes += sign * SampleBytes(clip.attackCache->pcm);
+}
+
+} // namespace
+
 // ── Singleton ────────────────────────────────────────────────────
 
 AudioEngine& AudioEngine::Instance() {
@@ -17,25 +85,59 @@ AudioEngine::~AudioEngine() { Shutdown(); }
 // ── Lifecycle ────────────────────────────────────────────────────
 
 UNAudioResult AudioEngine::Initialize(const UNAudioOutputConfig& config) {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
     if (initialized_) return UNAUDIO_ERROR_ALREADY_INITIALIZED;
 
+    std::lock_guard<std::mutex> lock(mutex_);
     config_ = config;
 
     // TODO: Create platform-specific AudioOutput
-    // TODO: Create AudioMixer
+    mixer_ = std::make_unique<AudioMixer>(config_.sampleRate);
+    mixer_->SetMasterVolume(masterVolume_);
+    mixer_->SetVoiceMetering(voiceMetering_);
+    // RenderDevice scratch, sized here so the output callback never allocates.
+    converter_ = std::make_unique<OutputConverter>();
+    deviceMix_.assign(static_cast<size_t>(std::max(config_.bufferSize, 0)) *
+                          std::max(config_.channels, 1), 0.0f);
+    loadPool_ = std::make_shared<ThreadPool>(0, "Load worker");
+    const int32_t decodeThreads = decodeThreads_ < 0 ? DecodeScheduler::DefaultWorkerCount()
+                                                     : decodeThreads_.load();
+    if (decodeThreads > 0)
+        decodeAhead_ = std::make_unique<DecodeScheduler>(decodeThreads, config_.bufferSize);
+    demotions_ = 0;
+    promotions_ = 0;
 
     initialized_ = true;
     return UNAUDIO_OK;
 }
 
 void AudioEngine::Shutdown() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex_);
     if (!initialized_) return;
 
+    // Calls that queue pool work check initialized_ under mutex_, so once it
+    // is clear nothing new reaches the pool.
+    std::shared_ptr<ThreadPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        initialized_ = false;
+        for (auto& source : sources_)
+            if (source) source->clip->load->cancelled = true;
+        pool = std::move(loadPool_);
+    }
+    // Joining the pool must happen unlocked: in-flight loads publish under mutex_.
+    // A waveform build still borrowing the pool joins it when done instead.
+    pool.reset();
+
     std::lock_guard<std::mutex> lock(mutex_);
-    sources_.clear();
     output_.reset();
     mixer_.reset();
-    initialized_ = false;
+    sources_.clear();
+    clipMemory_ = {};
+    voiceSlots_.clear();
+    freeVoiceSlots_.clear();
+    banks_.clear();
+    decodeAhead_.reset();   // after the voices, which detach as they go
 }
 
 bool AudioEngine::IsInitialized() const { return initialized_; }
@@ -44,13 +146,38 @@ bool AudioEngine::IsInitialized() const { return initialized_; }
 
 UNAudioSourceHandle AudioEngine::LoadAudio(const uint8_t* data, size_t size,
                                            UNAudioCompressionMode mode) {
-    if (!initialized_) return -1;
+    if (!initialized_ || !data || size == 0) return -1;
+
+    // Decode outside the engine lock so other API calls are not stalled.
+    auto task = MakeLoadTask(data, size, mode);
+    if (!RunLoad(*task)) return -1;
 
     std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) return -1;   // shut down while decoding
+    UNAudioSourceHandle handle = AddSource(task, mode);
+    PublishLoad(handle, task);
+    return handle;
+}
+
+void AudioEngine::UnloadAudio(UNAudioSourceHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (AudioSource* source = FindSource(handle)) {
+        // Instances still playing keep the clip alive until they are reaped.
+        source->clip->load->cancelled = true;
+        if (mixer_) mixer_->RemoveSource(source->voice.get());
+        CountClip(*source->clip, -1, clipMemory_);
+        sources_[handle].reset();
+    }
+}
 
+UNAudioSourceHandle AudioEngine::AddSource(std::shared_ptr<LoadTask> task,
+                                           UNAudioCompressionMode mode) {
     auto source = std::make_unique<AudioSource>();
-    // TODO: Create appropriate decoder based on format detection
-    source->clipInfo.compressionMode = mode;
+    source->clip = std::make_shared<AudioClip>();
+    source->clip->load = std::move(task);
+    source->clip->clipInfo.compressionMode = mode;
+    source->voice = std::make_shared<Voice>(config_.sampleRate);
+    source->voice->clip = source->clip;
 
     UNAudioSourceHandle handle = nextHandle_++;
     if (static_cast<size_t>(handle) >= sources_.size())
@@ -59,74 +186,920 @@ UNAudioSourceHandle AudioEngine::LoadAudio(const uint8_t* data, size_t size,
     return handle;
 }
 
-void AudioEngine::UnloadAudio(UNAudioSourceHandle handle) {
+AudioEngine::AudioSource* AudioEngine::FindSource(UNAudioSourceHandle handle) const {
+    if (handle < 0 || static_cast<size_t>(handle) >= sources_.size()) return nullptr;
+    return sources_[handle].get();
+}
+
+// ── Asynchronous loading ─────────────────────────────────────────
+
+std::shared_ptr<LoadTask> AudioEngine::MakeLoadTask(
+        const uint8_t* data, size_t size, UNAudioCompressionMode mode) {
+    auto task = std::make_shared<LoadTask>();
+    task->data.assign(data, data + size);
+    task->encoded     = task->data.data();
+    task->encodedSize = task->data.size();
+    task->mode        = mode;
+    return task;
+}
+
+bool AudioEngine::RunLoad(LoadTask& task, const UNAudioClipInfo* indexed) {
+    UNAUDIO_ZONE("Load Clip");
+    if (task.format == AudioFileFormat::Unknown)
+        task.format = DetectAudioFormat(task.encoded, task.encodedSize);
+    auto decoder = CreateDecoder(task.format, task.encoded, task.encodedSize);
+    if (!decoder) return false;
+
+    const UNAudioFormat format = decoder->GetFormat();
+    task.clipInfo.sampleRate      = format.sampleRate;
+    task.clipInfo.channels        = format.channels;
+    task.clipInfo.bitsPerSample   = format.bitsPerSample;
+    task.clipInfo.totalFrames     = decoder->GetTotalFrames();
+    task.clipInfo.compressionMode = task.mode;
+
+    // Opening the decoder only parsed the header: a stale or corrupt bank
+    // index is caught here, before a full decode or transcode.
+    if (indexed && (format.sampleRate != indexed->sampleRate ||
+                    format.channels != indexed->channels ||
+                    task.clipInfo.totalFrames != indexed->totalFrames))
+        return false;
+
+    if (task.mode == UNAUDIO_DECOMPRESS_ON_LOAD) {
+        if (!DecodeAll(*decoder, task.cancelled, task.pcm)) return false;
+        task.clipInfo.totalFrames = static_cast<int64_t>(task.pcm.size() / format.channels);
+    } else if (task.mode == UNAUDIO_ADPCM_IN_MEMORY && task.format != AudioFileFormat::ADPCM) {
+        // Transcode once here; playback then only decodes cheap ADPCM blocks.
+        std::vector<float> pcm;
+        if (!DecodeAll(*decoder, task.cancelled, pcm)) return false;
+
+        std::vector<uint8_t> transcoded;
+        const int64_t frames = static_cast<int64_t>(pcm.size() / format.channels);
+        if (!adpcm::Encode(pcm.data(), frames, format.channels, format.sampleRate, transcoded))
+            return false;
+
+        task.data        = std::move(transcoded);
+        task.encoded     = task.data.data();
+        task.encodedSize = task.data.size();
+        task.format      = AudioFileFormat::ADPCM;
+        task.bank.reset();
+
+        task.decoder = CreateDecoder(task.format, task.encoded, task.encodedSize);
+        if (!task.decoder) return false;
+        task.clipInfo.totalFrames = task.decoder->GetTotalFrames();
+    } else {
+        // UNAUDIO_STREAMING decodes incrementally like COMPRESS_IN_MEMORY: from
+        // the caller's bytes copied into the task, or from the mapped bank file,
+        // which the OS pages in from disk as playback reaches it.
+        task.decoder = std::move(decoder);
+    }
+
+    if (format.sampleRate > 0)
+        task.clipInfo.lengthInSeconds =
+            static_cast<float>(task.clipInfo.totalFrames) / format.sampleRate;
+    return true;
+}
+
+void AudioEngine::PublishLoad(UNAudioSourceHandle handle,
+                              const std::shared_ptr<LoadTask>& task) {
+    // Caller holds mutex_.  The slot may have been unloaded while decoding.
+    AudioSource* source = FindSource(handle);
+    if (!source || source->clip->load != task || task->cancelled) return;
+
+    AudioClip& clip = *source->clip;
+    clip.data           = std::move(task->data);
+    clip.bank           = std::move(task->bank);
+    clip.encoded        = task->encoded;
+    clip.encodedSize    = task->encodedSize;
+    clip.format         = task->format;
+    if (task->mode == UNAUDIO_DECOMPRESS_ON_LOAD)
+        clip.pcm = std::make_shared<const std::vector<float>>(std::move(task->pcm));
+    clip.clipInfo       = task->clipInfo;
+    clip.lastUsed       = ++useClock_;
+    source->voice->decoder = std::move(task->decoder);
+    source->voice->pcm     = clip.pcm;
+    // The mixer leaves the voice alone until the status below says loaded.
+    source->voice->resampler.Configure(clip.clipInfo.channels, clip.clipInfo.sampleRate,
+                                       config_.sampleRate, config_.bufferSize);
+    if (decodeAhead_ && source->voice->decoder &&
+        source->voice->state == UNAUDIO_STATE_PLAYING) {
+        // Played before the load finished; the mixer primes it on its first read.
+        source->voice->stream.Attach(*decodeAhead_, source->voice->decoder.get(),
+                                     clip.clipInfo.channels);
+    }
+    task->status = UNAUDIO_LOAD_LOADED;
+    CountClip(clip, 1, clipMemory_);
+
+    // The new clip counts as just used, so older ones are demoted first.
+    EnforceBudget(&clip);
+}
+
+UNAudioSourceHandle AudioEngine::LoadAudioAsync(const uint8_t* data, size_t size,
+                                                UNAudioCompressionMode mode) {
+    if (!initialized_ || !data || size == 0) return -1;
+
+    // Copy the caller's buffer up front; it is only valid for this call.
+    auto task = MakeLoadTask(data, size, mode);
+
     std::lock_guard<std::mutex> lock(mutex_);
-    if (handle >= 0 && static_cast<size_t>(handle) < sources_.size())
-        sources_[handle].reset();
+    if (!initialized_ || !loadPool_) return -1;
+    const UNAudioSourceHandle handle = AddSource(task, mode);
+
+    loadPool_->Submit([this, handle, task] {
+        UNAudioLoadStatus expected = UNAUDIO_LOAD_PENDING;
+        if (!task->status.compare_exchange_strong(expected, UNAUDIO_LOAD_LOADING))
+            return;   // cancelled while queued
+
+        if (!RunLoad(*task)) {
+            expected = UNAUDIO_LOAD_LOADING;
+            task->status.compare_exchange_strong(expected, UNAUDIO_LOAD_FAILED);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        PublishLoad(handle, task);
+    });
+    return handle;
+}
+
+UNAudioLoadStatus AudioEngine::GetLoadStatus(UNAudioSourceHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const AudioSource* source = FindSource(handle))
+        return source->clip->load->status;
+    return UNAUDIO_LOAD_NONE;
+}
+
+UNAudioResult AudioEngine::CancelLoad(UNAudioSourceHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AudioSource* source = FindSource(handle);
+    if (!source) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    // Publishing happens under mutex_, so a load cannot complete concurrently.
+    LoadTask& task = *source->clip->load;
+    UNAudioLoadStatus status = task.status;
+    if (IsLoadComplete(status)) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    task.cancelled = true;
+    // A worker failing at this instant may win the race; either way the load is over.
+    task.status.compare_exchange_strong(status, UNAUDIO_LOAD_CANCELLED);
+    return UNAUDIO_OK;
+}
+
+int32_t AudioEngine::GetLoadStatusBatch(const UNAudioSourceHandle* handles, int32_t count,
+                                        int32_t* outStatus) const {
+    if (!handles || count <= 0) return 0;
+
+    int32_t completed = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int32_t i = 0; i < count; ++i) {
+        UNAudioLoadStatus status = UNAUDIO_LOAD_NONE;
+        if (const AudioSource* source = FindSource(handles[i]))
+            status = source->clip->load->status;
+        if (IsLoadComplete(status)) ++completed;
+        if (outStatus) outStatus[i] = static_cast<int32_t>(status);
+    }
+    return completed;
+}
+
+// ── Clip banks ───────────────────────────────────────────────────
+
+int32_t AudioEngine::OpenBank(const char* path) {
+    if (!initialized_) return -1;
+
+    // Mapping and index validation happen unlocked; registration is O(1).
+    auto bank = ClipBank::Open(path);
+    if (!bank) return -1;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) return -1;
+    banks_.push_back(std::move(bank));
+    return static_cast<int32_t>(banks_.size() - 1);
+}
+
+void AudioEngine::CloseBank(int32_t bankId) {
+    // Sources loaded from the bank keep the mapping alive until unloaded.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bankId >= 0 && static_cast<size_t>(bankId) < banks_.size())
+        banks_[bankId].reset();
+}
+
+int32_t AudioEngine::GetBankClipCount(int32_t bankId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bankId >= 0 && static_cast<size_t>(bankId) < banks_.size() && banks_[bankId])
+        return banks_[bankId]->GetClipCount();
+    return 0;
+}
+
+UNAudioSourceHandle AudioEngine::LoadFromBank(int32_t bankId, int32_t clipIndex,
+                                              UNAudioCompressionMode mode) {
+    if (!initialized_) return -1;
+
+    std::shared_ptr<const ClipBank> bank;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bankId < 0 || static_cast<size_t>(bankId) >= banks_.size()) return -1;
+        bank = banks_[bankId];
+    }
+    if (!bank) return -1;
+
+    const ClipBank::BankEntry* entry = bank->GetEntry(clipIndex);
+    if (!entry) return -1;
+
+    auto task = std::make_shared<LoadTask>();
+    task->encoded        = bank->GetClipData(*entry);
+    task->encodedSize    = static_cast<size_t>(entry->dataSize);
+    task->format         = static_cast<AudioFileFormat>(entry->format);
+    task->mode           = mode;
+    task->bank           = std::move(bank);
+    // Only the magic is sniffed; the decoder then opens as the index says.
+    if (DetectAudioFormat(task->encoded, task->encodedSize) != task->format) return -1;
+
+    UNAudioClipInfo indexed{};
+    indexed.sampleRate  = entry->sampleRate;
+    indexed.channels    = entry->channels;
+    indexed.totalFrames = entry->totalFrames;
+    if (!RunLoad(*task, &indexed)) return -1;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) return -1;
+    UNAudioSourceHandle handle = AddSource(task, mode);
+    PublishLoad(handle, task);
+    return handle;
 }
 
 // ── Playback ─────────────────────────────────────────────────────
 
+void AudioEngine::StartVoice(const std::shared_ptr<Voice>& voice) {
+    // Caller holds mutex_.
+    AudioClip& clip = *voice->clip;
+    clip.lastUsed = ++useClock_;
+
+    const bool fadingOut = voice->stopAfterFade.exchange(false);
+    if (voice->state.exchange(UNAUDIO_STATE_PLAYING) == UNAUDIO_STATE_STOPPED) {
+        // A voice that stopped itself in Voice::Read stays on the mix bus
+        // until the next block, and that read may still be using its decoder.
+        // Take it off the bus (waiting out a block in progress) before the
+        // snapshots are swapped; a read in flight may also have stopped it
+        // again after the exchange above.  Decoding ahead stops first: the
+        // decoder may be replaced or repositioned.
+        if (mixer_) mixer_->RemoveSource(voice.get());
+        voice->state = UNAUDIO_STATE_PLAYING;
+        voice->stream.Detach();
+        voice->attack = clip.attackCache;
+        voice->pcm = clip.pcm;
+        if (voice->pcm) {
+            voice->decoder.reset();   // re-promoted since this voice last played
+        } else if (!clip.NeedsDecoder() && clip.IsLoaded()) {
+            // Demoted: play compressed until the re-decode lands.  Opening is a
+            // header parse; PlayInstance opens its decoder before locking.
+            if (!voice->decoder) voice->decoder = OpenDecoder(clip);
+            PromoteClip(voice->clip);
+        }
+        voice->restart = true;
+        if (clip.IsLoaded())
+            voice->resampler.Configure(clip.clipInfo.channels, clip.clipInfo.sampleRate,
+                                       config_.sampleRate, config_.bufferSize);
+        voice->gain.Set(voice->volume, 0);   // drop whatever a previous fade left
+        voice->send.Set(voice->sendLevel, 0);
+        voice->meter.Reset();   // applied by the mixer before its next reading
+
+        // Position the decoder behind the attack cache off the mixer thread.
+        // If the worker is late the mixer does it inline at the hand-over.
+        if (voice->attack && voice->decoder && loadPool_) {
+            Voice::WarmState ready = Voice::WarmState::Ready;
+            voice->warm.compare_exchange_strong(ready, Voice::WarmState::Cold);
+            voice->decoderReadyFrame = -1;   // left over from the last playback
+            const int64_t target = voice->attack->frames;
+            loadPool_->Submit([voice, target] {
+                Voice::WarmState cold = Voice::WarmState::Cold;
+                if (!voice->warm.compare_exchange_strong(cold, Voice::WarmState::Warming)) return;
+                UNAUDIO_ZONE("Warm Decoder");
+                // Seeking primes decoder state (bit reservoir, window overlap).
+                voice->decoder->Seek(target);
+                voice->decoderReadyFrame = target;
+                voice->warm.store(Voice::WarmState::Ready, std::memory_order_release);
+            });
+        }
+        if (decodeAhead_ && voice->decoder && clip.IsLoaded())
+            voice->stream.Attach(*decodeAhead_, voice->decoder.get(), clip.clipInfo.channels);
+    } else if (fadingOut) {
+        // Resumed during a fade-out: glide back up instead of stopping.
+        voice->gain.Set(voice->volume, MsToFrames(kDezipperMs));
+    }
+    if (mixer_) mixer_->AddSource(voice.get());
+}
+
+void AudioEngine::FadeVoice(Voice& voice, float volume, int32_t frames,
+                            UNAudioFadeCurve curve) {
+    // Caller holds mutex_.
+    voice.volume = volume;
+    voice.stopAfterFade = false;
+    voice.gain.Set(volume, frames, curve);
+}
+
+void AudioEngine::SetSend(Voice& voice, float level) {
+    // Caller holds mutex_.  Unchanged values are skipped, as for volume.
+    level = std::max(level, 0.0f);
+    if (voice.sendLevel == level) return;
+    voice.sendLevel = level;
+    voice.send.Set(level, MsToFrames(kDezipperMs));
+}
+
+int32_t AudioEngine::MsToFrames(float milliseconds) const {
+    if (milliseconds <= 0.0f || config_.sampleRate <= 0) return 0;
+    const double frames = static_cast<double>(milliseconds) * config_.sampleRate / 1000.0;
+    return static_cast<int32_t>(std::min(frames, static_cast<double>(INT32_MAX)));
+}
+
 UNAudioResult AudioEngine::Play(UNAudioSourceHandle handle) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (handle < 0 || static_cast<size_t>(handle) >= sources_.size() || !sources_[handle])
-        return UNAUDIO_ERROR_INVALID_PARAM;
-    sources_[handle]->state = UNAUDIO_STATE_PLAYING;
+    AudioSource* source = FindSource(handle);
+    if (!source) return UNAUDIO_ERROR_INVALID_PARAM;
+    StartVoice(source->voice);
     return UNAUDIO_OK;
 }
 
 UNAudioResult AudioEngine::Pause(UNAudioSourceHandle handle) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (handle < 0 || static_cast<size_t>(handle) >= sources_.size() || !sources_[handle])
-        return UNAUDIO_ERROR_INVALID_PARAM;
-    sources_[handle]->state = UNAUDIO_STATE_PAUSED;
+    AudioSource* source = FindSource(handle);
+    if (!source) return UNAUDIO_ERROR_INVALID_PARAM;
+    // The mixer drops it from the bus on its next block; position is kept.
+    UNAudioState expected = UNAUDIO_STATE_PLAYING;
+    source->voice->state.compare_exchange_strong(expected, UNAUDIO_STATE_PAUSED);
     return UNAUDIO_OK;
 }
 
 UNAudioResult AudioEngine::Stop(UNAudioSourceHandle handle) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (handle < 0 || static_cast<size_t>(handle) >= sources_.size() || !sources_[handle])
+    AudioSource* source = FindSource(handle);
+    if (!source) return UNAUDIO_ERROR_INVALID_PARAM;
+    source->voice->state = UNAUDIO_STATE_STOPPED;
+    if (mixer_) mixer_->RemoveSource(source->voice.get());
+    source->voice->stream.Detach();   // frees its slot until played again
+    return UNAUDIO_OK;
+}
+
+// ── Instanced voices ─────────────────────────────────────────────
+
+UNAudioVoiceHandle AudioEngine::PlayInstance(UNAudioSourceHandle handle) {
+    std::shared_ptr<AudioClip> clip;
+    float volume;
+    float sendLevel;
+    bool needsDecoder;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        AudioSource* source = FindSource(handle);
+        if (!source || !source->clip->IsLoaded()) return -1;
+        clip = source->clip;
+        volume = source->voice->volume;
+        sendLevel = source->voice->sendLevel;
+        needsDecoder = !clip->pcm;   // compressed, or demoted by the memory budget
+    }
+
+    // Each voice decodes independently; opening the decoder happens unlocked.
+    auto voice = std::make_shared<Voice>(config_.sampleRate);
+    voice->clip = clip;
+    voice->volume = volume;   // StartVoice snaps the gain to it
+    voice->sendLevel = sendLevel;   // and the send
+    if (needsDecoder) {
+        voice->decoder = OpenDecoder(*clip);
+        if (!voice->decoder) return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) return -1;
+    if (freeVoiceSlots_.empty()) ReapVoices();
+
+    int32_t index;
+    if (!freeVoiceSlots_.empty()) {
+        index = freeVoiceSlots_.back();
+        freeVoiceSlots_.pop_back();
+    } else if (voiceSlots_.size() <= static_cast<size_t>(kVoiceIndexMask)) {
+        index = static_cast<int32_t>(voiceSlots_.size());
+        voiceSlots_.emplace_back();
+    } else {
+        return -1;   // every slot holds a live voice
+    }
+
+    VoiceSlot& slot = voiceSlots_[index];
+    slot.voice = std::move(voice);
+    StartVoice(slot.voice);
+    return (static_cast<int32_t>(slot.generation) << kVoiceIndexBits) | index;
+}
+
+UNAudioResult AudioEngine::StopVoice(UNAudioVoiceHandle voice) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int32_t index = FindVoice(voice);
+    if (index < 0) return UNAUDIO_ERROR_INVALID_PARAM;
+    ReleaseVoice(index);
+    return UNAUDIO_OK;
+}
+
+void AudioEngine::SetVoiceVolume(UNAudioVoiceHandle voice, float volume) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int32_t index = FindVoice(voice);
+    if (index >= 0 && voiceSlots_[index].voice->volume != volume)
+        FadeVoice(*voiceSlots_[index].voice, volume, MsToFrames(kDezipperMs), UNAUDIO_FADE_LINEAR);
+}
+
+UNAudioResult AudioEngine::FadeVoiceVolume(UNAudioVoiceHandle voice, float volume,
+                                           float milliseconds, UNAudioFadeCurve curve) {
+    if (milliseconds < 0.0f) return UNAUDIO_ERROR_INVALID_PARAM;
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int32_t index = FindVoice(voice);
+    if (index < 0) return UNAUDIO_ERROR_INVALID_PARAM;
+    FadeVoice(*voiceSlots_[index].voice, volume, MsToFrames(milliseconds), curve);
+    return UNAUDIO_OK;
+}
+
+UNAudioState AudioEngine::GetVoiceState(UNAudioVoiceHandle voice) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int32_t index = FindVoice(voice);
+    if (index >= 0) return voiceSlots_[index].voice->state;
+    return UNAUDIO_STATE_STOPPED;
+}
+
+// ── Reverb ───────────────────────────────────────────────────────
+
+UNAudioResult AudioEngine::SetReverb(const UNAudioReverbParams& params) {
+    if ((params.lineCount != 0 && params.lineCount != 8 && params.lineCount != 16) ||
+        !(params.decayTime > 0.0f) || !(params.damping >= 0.0f && params.damping <= 1.0f) ||
+        !(params.wetLevel >= 0.0f))
         return UNAUDIO_ERROR_INVALID_PARAM;
-    sources_[handle]->state = UNAUDIO_STATE_STOPPED;
+
+    std::unique_ptr<FdnReverb> retired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!mixer_) return UNAUDIO_ERROR_NOT_INITIALIZED;
+
+        FdnReverb* reverb = mixer_->GetReverb();
+        if (params.lineCount == 0) {
+            retired = mixer_->SetReverb(nullptr);
+        } else if (reverb && reverb->GetLineCount() == params.lineCount) {
+            reverb->SetParams(params.decayTime, params.damping, params.wetLevel);
+        } else {
+            auto fresh = std::make_unique<FdnReverb>(params.lineCount, config_.sampleRate);
+            fresh->SetParams(params.decayTime, params.damping, params.wetLevel);
+            retired = mixer_->SetReverb(std::move(fresh));
+        }
+    }
+    return UNAUDIO_OK;   // the old delay memory is freed here, unlocked
+}
+
+void AudioEngine::SetSendLevel(UNAudioSourceHandle handle, float level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (AudioSource* source = FindSource(handle)) SetSend(*source->voice, level);
+}
+
+float AudioEngine::GetSendLevel(UNAudioSourceHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const AudioSource* source = FindSource(handle))
+        return source->voice->sendLevel;
+    return 0.0f;
+}
+
+void AudioEngine::SetVoiceSendLevel(UNAudioVoiceHandle voice, float level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int32_t index = FindVoice(voice);
+    if (index >= 0) SetSend(*voiceSlots_[index].voice, level);
+}
+
+// ── Metering ─────────────────────────────────────────────────────
+
+UNAudioLevels AudioEngine::GetMasterLevels() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mixer_ ? mixer_->GetMasterLevels() : LevelMeter::Silence();
+}
+
+void AudioEngine::ResetMasterLoudness() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mixer_) mixer_->ResetMasterLoudness();
+}
+
+UNAudioLevels AudioEngine::ReadLevels(const Voice& voice) {
+    UNAudioLevels levels = voice.meter.Read();
+    if (voice.state.load(std::memory_order_relaxed) != UNAUDIO_STATE_PLAYING) {
+        // The meter holds its last block; report what is heard now.
+        const float integrated = levels.integratedLufs;
+        levels = LevelMeter::Silence();
+        levels.integratedLufs = integrated;
+    }
+    return levels;
+}
+
+int32_t AudioEngine::GetVoiceLevels(const UNAudioVoiceHandle* voices, int32_t count,
+                                    UNAudioLevels* out) const {
+    if (!voices || !out || count <= 0) return 0;
+
+    int32_t valid = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int32_t i = 0; i < count; ++i) {
+        const int32_t index = FindVoice(voices[i]);
+        if (index >= 0) {
+            out[i] = ReadLevels(*voiceSlots_[index].voice);
+            ++valid;
+        } else {
+            out[i] = LevelMeter::Silence();
+        }
+    }
+    return valid;
+}
+
+int32_t AudioEngine::GetSourceLevels(const UNAudioSourceHandle* handles, int32_t count,
+                                     UNAudioLevels* out) const {
+    if (!handles || !out || count <= 0) return 0;
+
+    int32_t valid = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int32_t i = 0; i < count; ++i) {
+        if (const AudioSource* source = FindSource(handles[i])) {
+            out[i] = ReadLevels(*source->voice);
+            ++valid;
+        } else {
+            out[i] = LevelMeter::Silence();
+        }
+    }
+    return valid;
+}
+
+UNAudioResult AudioEngine::SetVoiceMetering(int32_t flags) {
+    if (flags & ~UNAUDIO_METER_ALL) return UNAUDIO_ERROR_INVALID_PARAM;
+    std::lock_guard<std::mutex> lock(mutex_);
+    voiceMetering_ = static_cast<uint32_t>(flags);   // kept across Initialize
+    if (mixer_) mixer_->SetVoiceMetering(voiceMetering_);
     return UNAUDIO_OK;
 }
 
+int32_t AudioEngine::FindVoice(UNAudioVoiceHandle handle) const {
+    if (handle < 0) return -1;
+    const int32_t index = handle & kVoiceIndexMask;
+    const uint16_t generation = static_cast<uint16_t>(handle >> kVoiceIndexBits);
+    if (static_cast<size_t>(index) >= voiceSlots_.size()) return -1;
+    const VoiceSlot& slot = voiceSlots_[index];
+    if (!slot.voice || slot.generation != generation) return -1;
+    return index;
+}
+
+void AudioEngine::ReleaseVoice(int32_t index) {
+    // Caller holds mutex_.  Waits out any block still reading the voice.
+    VoiceSlot& slot = voiceSlots_[index];
+    slot.voice->state = UNAUDIO_STATE_STOPPED;
+    if (mixer_) mixer_->RemoveSource(slot.voice.get());
+    slot.voice.reset();
+    slot.generation = static_cast<uint16_t>((slot.generation + 1) & kVoiceGenerationMask);
+    freeVoiceSlots_.push_back(index);
+}
+
+void AudioEngine::ReapVoices() {
+    // Caller holds mutex_.  Finished one-shots are recycled lazily, only when
+    // a new instance needs a slot.
+    for (size_t i = 0; i < voiceSlots_.size(); ++i) {
+        const VoiceSlot& slot = voiceSlots_[i];
+        if (slot.voice && slot.voice->state == UNAUDIO_STATE_STOPPED)
+            ReleaseVoice(static_cast<int32_t>(i));
+    }
+}
+
 // ── Properties ───────────────────────────────────────────────────
 
 void AudioEngine::SetVolume(UNAudioSourceHandle handle, float volume) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (handle >= 0 && static_cast<size_t>(handle) < sources_.size() && sources_[handle])
-        sources_[handle]->volume = volume;
+    // Unchanged values are skipped so per-frame syncs do not cancel a fade.
+    AudioSource* source = FindSource(handle);
+    if (source && source->voice->volume != volume)
+        FadeVoice(*source->voice, volume, MsToFrames(kDezipperMs), UNAUDIO_FADE_LINEAR);
 }
 
 float AudioEngine::GetVolume(UNAudioSourceHandle handle) const {
-    if (handle >= 0 && static_cast<size_t>(handle) < sources_.size() && sources_[handle])
-        return sources_[handle]->volume;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const AudioSource* source = FindSource(handle))
+        return source->voice->volume;
     return 0.0f;
 }
 
 void AudioEngine::SetLoop(UNAudioSourceHandle handle, bool loop) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (handle >= 0 && static_cast<size_t>(handle) < sources_.size() && sources_[handle])
-        sources_[handle]->loop = loop;
+    if (AudioSource* source = FindSource(handle))
+        source->voice->loop = loop;
 }
 
 UNAudioState AudioEngine::GetState(UNAudioSourceHandle handle) const {
-    if (handle >= 0 && static_cast<size_t>(handle) < sources_.size() && sources_[handle])
-        return sources_[handle]->state;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const AudioSource* source = FindSource(handle))
+        return source->voice->state;
     return UNAUDIO_STATE_STOPPED;
 }
 
 UNAudioClipInfo AudioEngine::GetClipInfo(UNAudioSourceHandle handle) const {
-    if (handle >= 0 && static_cast<size_t>(handle) < sources_.size() && sources_[handle])
-        return sources_[handle]->clipInfo;
+    // clipInfo is filled in by PublishLoad, which runs under mutex_ on a load
+    // worker while the caller may be polling.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const AudioSource* source = FindSource(handle))
+        return source->clip->clipInfo;
     return {};
 }
 
+// ── Gain automation ──────────────────────────────────────────────
+
+UNAudioResult AudioEngine::FadeVolume(UNAudioSourceHandle handle, float volume,
+                                      float milliseconds, UNAudioFadeCurve curve) {
+    if (milliseconds < 0.0f) return UNAUDIO_ERROR_INVALID_PARAM;
+    std::lock_guard<std::mutex> lock(mutex_);
+    AudioSource* source = FindSource(handle);
+    if (!source) return UNAUDIO_ERROR_INVALID_PARAM;
+    FadeVoice(*source->voice, volume, MsToFrames(milliseconds), curve);
+    return UNAUDIO_OK;
+}
+
+UNAudioResult AudioEngine::Crossfade(UNAudioSourceHandle from, UNAudioSourceHandle to,
+                                     float milliseconds) {
+    if (milliseconds < 0.0f || from == to) return UNAUDIO_ERROR_INVALID_PARAM;
+    std::lock_guard<std::mutex> lock(mutex_);
+    AudioSource* out = FindSource(from);
+    AudioSource* in  = FindSource(to);
+    if (!out || !in) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    const int32_t frames = MsToFrames(milliseconds);
+
+    // Both ramps are picked up at the same block boundary, so they stay aligned.
+    if (out->voice->state == UNAUDIO_STATE_PLAYING) {
+        out->voice->gain.Set(0.0f, frames, UNAUDIO_FADE_EQUAL_POWER);
+        out->voice->stopAfterFade = true;
+    } else if (out->voice->state == UNAUDIO_STATE_PAUSED) {
+        out->voice->state = UNAUDIO_STATE_STOPPED;   // silent already, off the bus
+    }
+
+    const bool wasStopped = in->voice->state == UNAUDIO_STATE_STOPPED;
+    StartVoice(in->voice);
+    in->voice->gain.Set(in->voice->volume, frames, UNAUDIO_FADE_EQUAL_POWER,
+                        wasStopped ? 0.0f : GainRamp::kFromCurrent);
+    return UNAUDIO_OK;
+}
+
+UNAudioResult AudioEngine::SetAttackCache(UNAudioSourceHandle handle, float milliseconds) {
+    if (milliseconds < 0.0f) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    std::shared_ptr<AudioClip> clip;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        AudioSource* source = FindSource(handle);
+        if (!source || !source->clip->IsLoaded()) return UNAUDIO_ERROR_INVALID_PARAM;
+        // Decompressed clips start from PCM already; there is nothing to cache.
+        if (!source->clip->NeedsDecoder()) return UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED;
+        clip = source->clip;   // encoded data and clipInfo are fixed once loaded
+    }
+
+    // Decode the attack with a private decoder, outside the engine lock.
+    std::shared_ptr<AttackCache> cache;
+    int64_t frames = static_cast<int64_t>(milliseconds * clip->clipInfo.sampleRate / 1000.0f);
+    if (clip->clipInfo.totalFrames > 0)
+        frames = std::min(frames, clip->clipInfo.totalFrames);
+    if (frames > 0) {
+        auto decoder = OpenDecoder(*clip);
+        if (!decoder) return UNAUDIO_ERROR_DECODE_FAILED;
+        const size_t channels = static_cast<size_t>(clip->clipInfo.channels);
+        cache = std::make_shared<AttackCache>();
+        cache->pcm.resize(static_cast<size_t>(frames) * channels);
+        cache->frames = std::max(0, decoder->Decode(cache->pcm.data(), static_cast<int>(frames)));
+        cache->pcm.resize(static_cast<size_t>(cache->frames) * channels);
+        if (cache->frames == 0) cache.reset();
+    }
+
+    // Voices pick the new cache up the next time they start from stopped.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (clip->load->cancelled) return UNAUDIO_ERROR_INVALID_PARAM;   // unloaded meanwhile
+    CountClip(*clip, -1, clipMemory_);
+    clip->attackCache = std::move(cache);
+    CountClip(*clip, 1, clipMemory_);
+    return UNAUDIO_OK;
+}
+
+// ── Waveform summaries ───────────────────────────────────────────
+
+std::shared_ptr<const WaveformPeaks> AudioEngine::AcquirePeaks(UNAudioSourceHandle handle) {
+    std::shared_ptr<AudioClip> clip;
+    std::shared_ptr<const std::vector<float>> pcm;
+    std::shared_ptr<ThreadPool> pool;   // null after Shutdown: build on this thread
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        AudioSource* source = FindSource(handle);
+        if (!source || !source->clip->IsLoaded()) return nullptr;
+        if (source->clip->peaks) return source->clip->peaks;
+        clip = source->clip;
+        pcm = clip->pcm;   // held for the build, so a demotion cannot free it
+        pool = loadPool_;
+    }
+
+    // Build unlocked; a concurrent caller may race us, the first result is kept.
+    auto peaks = WaveformPeaks::Build(*clip, pcm.get(), pool.get());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!clip->peaks) clip->peaks = std::move(peaks);
+    return clip->peaks;
+}
+
+UNAudioResult AudioEngine::BuildWaveformPeaks(UNAudioSourceHandle handle) {
+    return AcquirePeaks(handle) ? UNAUDIO_OK : UNAUDIO_ERROR_INVALID_PARAM;
+}
+
+int64_t AudioEngine::GetWaveformPeaks(UNAudioSourceHandle handle, int32_t level, int64_t start,
+                                      int64_t count, UNAudioPeakBin* out) {
+    if (level < 0 || level >= WaveformPeaks::kLevelCount) return UNAUDIO_ERROR_INVALID_PARAM;
+    auto peaks = AcquirePeaks(handle);
+    if (!peaks) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    // A null buffer just reports the level's bin count.
+    if (!out) return peaks->GetBinCount(level);
+    return peaks->GetBins(level, start, count, out);
+}
+
+int64_t AudioEngine::SaveWaveformPeaks(UNAudioSourceHandle handle, uint8_t* out,
+                                       size_t capacity) {
+    auto peaks = AcquirePeaks(handle);
+    if (!peaks) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    const std::vector<uint8_t> blob = peaks->Serialize();
+    if (out && capacity >= blob.size())
+        std::memcpy(out, blob.data(), blob.size());
+    return static_cast<int64_t>(blob.size());
+}
+
+UNAudioResult AudioEngine::LoadWaveformPeaks(UNAudioSourceHandle handle, const uint8_t* data,
+                                             size_t size) {
+    auto peaks = WaveformPeaks::Deserialize(data, size);
+    if (!peaks) return UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    AudioSource* source = FindSource(handle);
+    if (!source || !source->clip->IsLoaded()) return UNAUDIO_ERROR_INVALID_PARAM;
+    // Reject a sidecar that was built from a different version of the clip.
+    if (peaks->GetTotalFrames() != source->clip->clipInfo.totalFrames)
+        return UNAUDIO_ERROR_INVALID_PARAM;
+    source->clip->peaks = std::move(peaks);
+    return UNAUDIO_OK;
+}
+
+// ── Decode-ahead ─────────────────────────────────────────────────
+
+UNAudioResult AudioEngine::SetDecodeThreads(int32_t count) {
+    if (count < -1) return UNAUDIO_ERROR_INVALID_PARAM;
+    // The workers are started by Initialize and live until Shutdown.
+    if (initialized_) return UNAUDIO_ERROR_ALREADY_INITIALIZED;
+    decodeThreads_ = std::min<int32_t>(count, DecodeScheduler::kMaxWorkers);
+    return UNAUDIO_OK;
+}
+
+UNAudioDecodeStats AudioEngine::GetDecodeStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return decodeAhead_ ? decodeAhead_->GetStats() : UNAudioDecodeStats{};
+}
+
+// ── Memory budget ────────────────────────────────────────────────
+
+template <typename Fn>
+void AudioEngine::ForEachVoice(Fn&& fn) const {
+    // Voices are mutable through the shared pointers even from const callers.
+    // Caller holds mutex_.
+    for (const auto& source : sources_)
+        if (source) fn(*source->voice);
+    for (const VoiceSlot& slot : voiceSlots_)
+        if (slot.voice) fn(*slot.voice);
+}
+
+void AudioEngine::MeasureMemory(const AudioClip* only, UNAudioMemoryUsage& usage) const {
+    // Caller holds mutex_.  Engine-wide, the clips' own buffers come from the
+    // running totals; only the voices are walked.
+    if (only) {
+        usage = {};
+        CountClip(*only, 1, usage);
+    } else {
+        usage = clipMemory_;
+    }
+
+    // Voices add their decoders, plus samples they still play after the clip
+    // dropped them (demoted, new attack cache); each buffer is counted once.
+    std::vector<const void*> stale;
+    auto countStale = [&](const void* buffer, int64_t bytes) {
+        if (std::find(stale.begin(), stale.end(), buffer) != stale.end()) return;
+        stale.push_back(buffer);
+        usage.pcmBytes += bytes;
+    };
+    ForEachVoice([&](const Voice& voice) {
+        if (only && voice.clip.get() != only) return;
+        if (voice.decoder) usage.decoderBytes += static_cast<int64_t>(voice.decoder->GetStateSize());
+        usage.decoderBytes += static_cast<int64_t>(voice.stream.GetSize());
+        if (voice.pcm && voice.pcm != voice.clip->pcm)
+            countStale(voice.pcm.get(), SampleBytes(*voice.pcm));
+        if (voice.attack && voice.attack != voice.clip->attackCache)
+            countStale(voice.attack.get(), SampleBytes(voice.attack->pcm));
+    });
+}
+
+void AudioEngine::EnforceBudget(const AudioClip* keep) {
+    // Caller holds mutex_.
+    if (memoryBudget_ <= 0) return;
+    UNAudioMemoryUsage usage;
+    MeasureMemory(nullptr, usage);
+    int64_t total = TotalBytes(usage);
+    if (total <= memoryBudget_) return;
+
+    // Stopped voices take a fresh snapshot when restarted, and the mixer never
+    // reads the samples of a stopped voice, so their references can go.
+    ForEachVoice([](Voice& voice) {
+        if (voice.state == UNAUDIO_STATE_STOPPED) voice.pcm.reset();
+    });
+
+    std::vector<AudioClip*> candidates;
+    for (const auto& source : sources_)
+        if (source && source->clip->pcm && source->clip.get() != keep)
+            candidates.push_back(source->clip.get());
+    std::sort(candidates.begin(), candidates.end(),
+              [](const AudioClip* a, const AudioClip* b) { return a->lastUsed < b->lastUsed; });
+
+    for (AudioClip* clip : candidates) {
+        if (total <= memoryBudget_) break;
+        // A playing or paused voice (or a waveform build) still holds the
+        // samples; demoting now would free nothing.
+        if (clip->pcm.use_count() > 1) continue;
+        total -= SampleBytes(*clip->pcm);
+        clipMemory_.pcmBytes -= SampleBytes(*clip->pcm);
+        clip->pcm.reset();
+        ++demotions_;
+    }
+}
+
+void AudioEngine::PromoteClip(const std::shared_ptr<AudioClip>& clip) {
+    // Caller holds mutex_.  A clip larger than the whole budget stays compressed.
+    if (clip->promoting || !loadPool_) return;
+    const int64_t bytes = clip->clipInfo.totalFrames * clip->clipInfo.channels *
+                          static_cast<int64_t>(sizeof(float));
+    if (memoryBudget_ > 0 && bytes > memoryBudget_) return;
+
+    clip->promoting = true;
+    loadPool_->Submit([this, clip] {
+        UNAUDIO_ZONE("Promote Clip");
+        std::vector<float> samples;
+        auto decoder = OpenDecoder(*clip);
+        const bool decoded = decoder && DecodeAll(*decoder, clip->load->cancelled, samples);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        clip->promoting = false;
+        if (!decoded || clip->load->cancelled || clip->pcm) return;   // unloaded meanwhile
+        clip->pcm = std::make_shared<const std::vector<float>>(std::move(samples));
+        clipMemory_.pcmBytes += SampleBytes(*clip->pcm);
+        ++promotions_;
+        EnforceBudget(clip.get());
+    });
+}
+
+UNAudioResult AudioEngine::SetMemoryBudget(int64_t bytes) {
+    if (bytes < 0) return UNAUDIO_ERROR_INVALID_PARAM;
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryBudget_ = bytes;
+    EnforceBudget(nullptr);
+    return UNAUDIO_OK;
+}
+
+UNAudioMemoryStats AudioEngine::GetMemoryStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    UNAudioMemoryStats stats{};
+    MeasureMemory(nullptr, stats.usage);
+    stats.totalBytes  = TotalBytes(stats.usage);
+    stats.budgetBytes = memoryBudget_;
+    for (const auto& source : sources_) {
+        if (!source) continue;
+        ++stats.clipCount;
+        const AudioClip& clip = *source->clip;
+        if (clip.IsLoaded() && !clip.NeedsDecoder() && !clip.pcm) ++stats.demotedClips;
+    }
+    stats.demotions  = demotions_;
+    stats.promotions = promotions_;
+    return stats;
+}
+
+UNAudioMemoryUsage AudioEngine::GetClipMemory(UNAudioSourceHandle handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    UNAudioMemoryUsage usage{};
+    if (const AudioSource* source = FindSource(handle))
+        MeasureMemory(source->clip.get(), usage);
+    return usage;
+}
+
 // ── Engine-level ─────────────────────────────────────────────────
 
-void  AudioEngine::SetMasterVolume(float volume) { masterVolume_ = volume; }
-float AudioEngine::GetMasterVolume() const       { return masterVolume_; }
+void AudioEngine::SetMasterVolume(float volume) {
+    FadeMasterVolume(volume, kDezipperMs, UNAUDIO_FADE_LINEAR);
+}
+
+float AudioEngine::GetMasterVolume() const { return masterVolume_; }
+
+UNAudioResult AudioEngine::FadeMasterVolume(float volume, float milliseconds,
+                                            UNAudioFadeCurve curve) {
+    if (milliseconds < 0.0f) return UNAUDIO_ERROR_INVALID_PARAM;
+    std::lock_guard<std::mutex> lock(mutex_);
+    masterVolume_ = volume;
+    if (mixer_) mixer_->SetMasterVolume(volume, MsToFrames(milliseconds), curve);
+    return UNAUDIO_OK;
+}
 
 void AudioEngine::SetBufferSize(int32_t frames) {
     config_.bufferSize = frames;
@@ -139,79 +1112,493 @@ float AudioEngine::GetCurrentLatency() const {
     return 0.0f;
 }
 
+UNAudioOutputConfig AudioEngine::GetConfig() const { return config_; }
+
+void AudioEngine::Render(float* buffer, int32_t frameCount) {
+    if (!buffer || frameCount <= 0) return;
+    UNAUDIO_ZONE_THREAD("Audio render");
+    UNAUDIO_ZONE("Render");
+    if (!initialized_ || !mixer_)
+        std::memset(buffer, 0, static_cast<size_t>(frameCount) * config_.channels * sizeof(float));
+    else
+        mixer_->Process(buffer, frameCount, config_.channels);
+    dspFrame_.fetch_add(frameCount, std::memory_order_relaxed);
+}
+
+bool AudioEngine::PrepareDevice(int32_t deviceChannels, UNAudioSampleFormat format) {
+    if (!converter_) return false;   // not initialized
+    return converter_->Matches(config_.channels, deviceChannels, format) ||
+           converter_->Configure(config_.channels, deviceChannels, format);
+}
+
+void AudioEngine::RenderDevice(void* buffer, int32_t frameCount, int32_t deviceChannels,
+                               UNAudioSampleFormat format) {
+    if (!buffer || frameCount <= 0 || deviceChannels <= 0) return;
+    UNAUDIO_ZONE("RenderDevice");
+
+    const int32_t mixChannels = config_.channels;
+    // Normally prepared by PrepareDevice and Initialize; a format or block
+    // size they did not anticipate is set up here, once.
+    const bool converts = converter_ &&
+                          (converter_->Matches(mixChannels, deviceChannels, format) ||
+                           converter_->Configure(mixChannels, deviceChannels, format));
+
+    // Mix even when the device cannot be fed so voices and the DSP clock advance.
+    const size_t samples = static_cast<size_t>(frameCount) * std::max(mixChannels, 1);
+    if (deviceMix_.size() < samples) deviceMix_.resize(samples);
+    Render(deviceMix_.data(), frameCount);
+
+    UNAUDIO_ZONE("Convert");
+    if (converts)
+        converter_->Process(deviceMix_.data(), buffer, frameCount);
+    else
+        std::memset(buffer, 0, static_cast<size_t>(frameCount) * deviceChannels *
+                                   OutputConverter::BytesPerSample(format));
+}
+
 // ── P/Invoke C API ───────────────────────────────────────────────
 
+// Log a C API call when a trace is running; arguments are only evaluated then.
+#define UNAUDIO_TRACE(op, result, ...)                                              \
+    do {                                                                            \
+        if (CallTrace::IsActive())                                                  \
+            CallTrace::Instance().Record(TraceOp::op,                               \
+                                         AudioEngine::Instance().GetDspFrame(),     \
+                                         (result), { __VA_ARGS__ });                \
+    } while (0)
+
+namespace {
+
+int32_t TranscodeToADPCM(const uint8_t* data, int32_t size,
+                         uint8_t* outBuffer, int32_t outCapacity) {
+    if (!data || size <= 0) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    auto decoder = CreateDecoder(data, static_cast<size_t>(size));
+    if (!decoder) return UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED;
+
+    const std::atomic<bool> cancelled{false};
+    std::vector<float> pcm;
+    DecodeAll(*decoder, cancelled, pcm);
+
+    const UNAudioFormat format = decoder->GetFormat();
+    std::vector<uint8_t> encoded;
+    if (!adpcm::Encode(pcm.data(), static_cast<int64_t>(pcm.size() / format.channels),
+                       format.channels, format.sampleRate, encoded))
+        return UNAUDIO_ERROR_DECODE_FAILED;
+    if (encoded.size() > static_cast<size_t>(INT32_MAX)) return UNAUDIO_ERROR_OUT_OF_MEMORY;
+
+    // A null / undersized buffer just reports the required size.
+    if (outBuffer && static_cast<size_t>(outCapacity) >= encoded.size())
+        std::memcpy(outBuffer, encoded.data(), encoded.size());
+    return static_cast<int32_t>(encoded.size());
+}
+
+size_t PathSize(const char* path) { return path ? std::strlen(path) : 0; }
+
+} // namespace
+
 extern "C" {
 
 UNAUDIO_EXPORT int32_t UNAudio_Initialize(UNAudioOutputConfig config) {
-    return static_cast<int32_t>(AudioEngine::Instance().Initialize(config));
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().Initialize(config));
+    UNAUDIO_TRACE(Initialize, result, TraceArg::Blob(&config, sizeof(config)));
+    return result;
 }
 
 UNAUDIO_EXPORT void UNAudio_Shutdown(void) {
     AudioEngine::Instance().Shutdown();
+    UNAUDIO_TRACE(Shutdown, 0);
 }
 
 UNAUDIO_EXPORT int32_t UNAudio_IsInitialized(void) {
-    return AudioEngine::Instance().IsInitialized() ? 1 : 0;
+    const int32_t result = AudioEngine::Instance().IsInitialized() ? 1 : 0;
+    UNAUDIO_TRACE(IsInitialized, result);
+    return result;
 }
 
 UNAUDIO_EXPORT int32_t UNAudio_LoadAudio(const uint8_t* data, int32_t size,
                                           int32_t compressionMode) {
-    return AudioEngine::Instance().LoadAudio(
-        data, static_cast<size_t>(size),
-        static_cast<UNAudioCompressionMode>(compressionMode));
+    int32_t result = -1;
+    if (size > 0)
+        result = AudioEngine::Instance().LoadAudio(
+            data, static_cast<size_t>(size),
+            static_cast<UNAudioCompressionMode>(compressionMode));
+    UNAUDIO_TRACE(LoadAudio, result, TraceArg::Blob(data, size > 0 ? size : 0), compressionMode);
+    return result;
 }
 
 UNAUDIO_EXPORT void UNAudio_UnloadAudio(int32_t handle) {
     AudioEngine::Instance().UnloadAudio(handle);
+    UNAUDIO_TRACE(UnloadAudio, 0, handle);
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_LoadAudioAsync(const uint8_t* data, int32_t size,
+                                               int32_t compressionMode) {
+    int32_t result = -1;
+    if (size > 0)
+        result = AudioEngine::Instance().LoadAudioAsync(
+            data, static_cast<size_t>(size),
+            static_cast<UNAudioCompressionMode>(compressionMode));
+    UNAUDIO_TRACE(LoadAudioAsync, result, TraceArg::Blob(data, size > 0 ? size : 0),
+                  compressionMode);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetLoadStatus(int32_t handle) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().GetLoadStatus(handle));
+    UNAUDIO_TRACE(GetLoadStatus, result, handle);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_CancelLoad(int32_t handle) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().CancelLoad(handle));
+    UNAUDIO_TRACE(CancelLoad, result, handle);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetLoadStatusBatch(const int32_t* handles, int32_t count,
+                                                   int32_t* outStatus) {
+    const int32_t result = AudioEngine::Instance().GetLoadStatusBatch(handles, count, outStatus);
+    UNAUDIO_TRACE(GetLoadStatusBatch, result,
+                  TraceArg::Blob(handles, count > 0 ? count * sizeof(int32_t) : 0), count);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_TranscodeADPCM(const uint8_t* data, int32_t size,
+                                               uint8_t* outBuffer, int32_t outCapacity) {
+    const int32_t result = TranscodeToADPCM(data, size, outBuffer, outCapacity);
+    UNAUDIO_TRACE(TranscodeADPCM, result, TraceArg::Blob(data, size > 0 ? size : 0),
+                  outCapacity);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_WriteBank(const char* path, const uint8_t* data,
+                                          const int32_t* sizes, int32_t count) {
+    const auto result = static_cast<int32_t>(ClipBank::Write(path, data, sizes, count));
+    UNAUDIO_TRACE(WriteBank, result, TraceArg::Blob(path, PathSize(path)), count);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_OpenBank(const char* path) {
+    const int32_t result = AudioEngine::Instance().OpenBank(path);
+    UNAUDIO_TRACE(OpenBank, result, TraceArg::Blob(path, PathSize(path)));
+    return result;
+}
+
+UNAUDIO_EXPORT void UNAudio_CloseBank(int32_t bankId) {
+    AudioEngine::Instance().CloseBank(bankId);
+    UNAUDIO_TRACE(CloseBank, 0, bankId);
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetBankClipCount(int32_t bankId) {
+    const int32_t result = AudioEngine::Instance().GetBankClipCount(bankId);
+    UNAUDIO_TRACE(GetBankClipCount, result, bankId);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_LoadFromBank(int32_t bankId, int32_t clipIndex,
+                                             int32_t compressionMode) {
+    const int32_t result = AudioEngine::Instance().LoadFromBank(
+        bankId, clipIndex, static_cast<UNAudioCompressionMode>(compressionMode));
+    UNAUDIO_TRACE(LoadFromBank, result, bankId, clipIndex, compressionMode);
+    return result;
 }
 
 UNAUDIO_EXPORT int32_t UNAudio_Play(int32_t handle) {
-    return static_cast<int32_t>(AudioEngine::Instance().Play(handle));
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().Play(handle));
+    UNAUDIO_TRACE(Play, result, handle);
+    return result;
 }
 
 UNAUDIO_EXPORT int32_t UNAudio_Pause(int32_t handle) {
-    return static_cast<int32_t>(AudioEngine::Instance().Pause(handle));
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().Pause(handle));
+    UNAUDIO_TRACE(Pause, result, handle);
+    return result;
 }
 
 UNAUDIO_EXPORT int32_t UNAudio_Stop(int32_t handle) {
-    return static_cast<int32_t>(AudioEngine::Instance().Stop(handle));
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().Stop(handle));
+    UNAUDIO_TRACE(Stop, result, handle);
+    return result;
 }
 
 UNAUDIO_EXPORT void UNAudio_SetVolume(int32_t handle, float volume) {
     AudioEngine::Instance().SetVolume(handle, volume);
+    UNAUDIO_TRACE(SetVolume, 0, handle, volume);
 }
 
 UNAUDIO_EXPORT float UNAudio_GetVolume(int32_t handle) {
-    return AudioEngine::Instance().GetVolume(handle);
+    const float result = AudioEngine::Instance().GetVolume(handle);
+    UNAUDIO_TRACE(GetVolume, result, handle);
+    return result;
 }
 
 UNAUDIO_EXPORT void UNAudio_SetLoop(int32_t handle, int32_t loop) {
     AudioEngine::Instance().SetLoop(handle, loop != 0);
+    UNAUDIO_TRACE(SetLoop, 0, handle, loop);
 }
 
 UNAUDIO_EXPORT int32_t UNAudio_GetState(int32_t handle) {
-    return static_cast<int32_t>(AudioEngine::Instance().GetState(handle));
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().GetState(handle));
+    UNAUDIO_TRACE(GetState, result, handle);
+    return result;
 }
 
 UNAUDIO_EXPORT UNAudioClipInfo UNAudio_GetClipInfo(int32_t handle) {
-    return AudioEngine::Instance().GetClipInfo(handle);
+    const UNAudioClipInfo info = AudioEngine::Instance().GetClipInfo(handle);
+    UNAUDIO_TRACE(GetClipInfo, 0, handle);
+    return info;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_SetAttackCache(int32_t handle, float milliseconds) {
+    const auto result = static_cast<int32_t>(
+        AudioEngine::Instance().SetAttackCache(handle, milliseconds));
+    UNAUDIO_TRACE(SetAttackCache, result, handle, milliseconds);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_FadeVolume(int32_t handle, float volume, float milliseconds,
+                                           int32_t curve) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().FadeVolume(
+        handle, volume, milliseconds, static_cast<UNAudioFadeCurve>(curve)));
+    UNAUDIO_TRACE(FadeVolume, result, handle, volume, milliseconds, curve);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_Crossfade(int32_t from, int32_t to, float milliseconds) {
+    const auto result = static_cast<int32_t>(
+        AudioEngine::Instance().Crossfade(from, to, milliseconds));
+    UNAUDIO_TRACE(Crossfade, result, from, to, milliseconds);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_BuildWaveformPeaks(int32_t handle) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().BuildWaveformPeaks(handle));
+    UNAUDIO_TRACE(BuildWaveformPeaks, result, handle);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetWaveformPeaks(int32_t handle, int32_t level, int32_t start,
+                                                 int32_t count, UNAudioPeakBin* out) {
+    const int64_t peaks = AudioEngine::Instance().GetWaveformPeaks(handle, level, start,
+                                                                   count, out);
+    const auto result = static_cast<int32_t>(std::min<int64_t>(peaks, INT32_MAX));
+    UNAUDIO_TRACE(GetWaveformPeaks, result, handle, level, start, out ? count : 0);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_SaveWaveformPeaks(int32_t handle, uint8_t* outBuffer,
+                                                  int32_t outCapacity) {
+    const int64_t size = AudioEngine::Instance().SaveWaveformPeaks(
+        handle, outBuffer, outCapacity > 0 ? static_cast<size_t>(outCapacity) : 0);
+    const int32_t result = size > INT32_MAX ? UNAUDIO_ERROR_OUT_OF_MEMORY
+                                            : static_cast<int32_t>(size);
+    UNAUDIO_TRACE(SaveWaveformPeaks, result, handle, outCapacity);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_LoadWaveformPeaks(int32_t handle, const uint8_t* data,
+                                                  int32_t size) {
+    int32_t result = UNAUDIO_ERROR_INVALID_PARAM;
+    if (size > 0)
+        result = static_cast<int32_t>(AudioEngine::Instance().LoadWaveformPeaks(
+            handle, data, static_cast<size_t>(size)));
+    UNAUDIO_TRACE(LoadWaveformPeaks, result, handle, TraceArg::Blob(data, size > 0 ? size : 0));
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_PlayInstance(int32_t handle) {
+    const int32_t result = AudioEngine::Instance().PlayInstance(handle);
+    UNAUDIO_TRACE(PlayInstance, result, handle);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_StopVoice(int32_t voice) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().StopVoice(voice));
+    UNAUDIO_TRACE(StopVoice, result, voice);
+    return result;
+}
+
+UNAUDIO_EXPORT void UNAudio_SetVoiceVolume(int32_t voice, float volume) {
+    AudioEngine::Instance().SetVoiceVolume(voice, volume);
+    UNAUDIO_TRACE(SetVoiceVolume, 0, voice, volume);
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_FadeVoiceVolume(int32_t voice, float volume,
+                                                float milliseconds, int32_t curve) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().FadeVoiceVolume(
+        voice, volume, milliseconds, static_cast<UNAudioFadeCurve>(curve)));
+    UNAUDIO_TRACE(FadeVoiceVolume, result, voice, volume, milliseconds, curve);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetVoiceState(int32_t voice) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().GetVoiceState(voice));
+    UNAUDIO_TRACE(GetVoiceState, result, voice);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_SetReverb(UNAudioReverbParams params) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().SetReverb(params));
+    UNAUDIO_TRACE(SetReverb, result, TraceArg::Blob(&params, sizeof(params)));
+    return result;
+}
+
+UNAUDIO_EXPORT void UNAudio_SetSendLevel(int32_t handle, float level) {
+    AudioEngine::Instance().SetSendLevel(handle, level);
+    UNAUDIO_TRACE(SetSendLevel, 0, handle, level);
+}
+
+UNAUDIO_EXPORT float UNAudio_GetSendLevel(int32_t handle) {
+    const float result = AudioEngine::Instance().GetSendLevel(handle);
+    UNAUDIO_TRACE(GetSendLevel, result, handle);
+    return result;
+}
+
+UNAUDIO_EXPORT void UNAudio_SetVoiceSendLevel(int32_t voice, float level) {
+    AudioEngine::Instance().SetVoiceSendLevel(voice, level);
+    UNAUDIO_TRACE(SetVoiceSendLevel, 0, voice, level);
+}
+
+UNAUDIO_EXPORT UNAudioLevels UNAudio_GetMasterLevels(void) {
+    const UNAudioLevels levels = AudioEngine::Instance().GetMasterLevels();
+    UNAUDIO_TRACE(GetMasterLevels, 0);
+    return levels;
+}
+
+UNAUDIO_EXPORT void UNAudio_ResetMasterLoudness(void) {
+    AudioEngine::Instance().ResetMasterLoudness();
+    UNAUDIO_TRACE(ResetMasterLoudness, 0);
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetVoiceLevels(const int32_t* voices, int32_t count,
+                                              UNAudioLevels* outLevels) {
+    const int32_t result = AudioEngine::Instance().GetVoiceLevels(voices, count, outLevels);
+    UNAUDIO_TRACE(GetVoiceLevels, result,
+                  TraceArg::Blob(voices, count > 0 ? count * sizeof(int32_t) : 0), count);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_GetSourceLevels(const int32_t* handles, int32_t count,
+                                               UNAudioLevels* outLevels) {
+    const int32_t result = AudioEngine::Instance().GetSourceLevels(handles, count, outLevels);
+    UNAUDIO_TRACE(GetSourceLevels, result,
+                  TraceArg::Blob(handles, count > 0 ? count * sizeof(int32_t) : 0), count);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_SetVoiceMetering(int32_t flags) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().SetVoiceMetering(flags));
+    UNAUDIO_TRACE(SetVoiceMetering, result, flags);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_SetDecodeThreads(int32_t count) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().SetDecodeThreads(count));
+    UNAUDIO_TRACE(SetDecodeThreads, result, count);
+    return result;
+}
+
+UNAUDIO_EXPORT UNAudioDecodeStats UNAudio_GetDecodeStats(void) {
+    const UNAudioDecodeStats stats = AudioEngine::Instance().GetDecodeStats();
+    UNAUDIO_TRACE(GetDecodeStats, 0);
+    return stats;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_SetMemoryBudget(int64_t bytes) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().SetMemoryBudget(bytes));
+    UNAUDIO_TRACE(SetMemoryBudget, result, bytes);
+    return result;
+}
+
+UNAUDIO_EXPORT UNAudioMemoryStats UNAudio_GetMemoryStats(void) {
+    const UNAudioMemoryStats stats = AudioEngine::Instance().GetMemoryStats();
+    UNAUDIO_TRACE(GetMemoryStats, 0);
+    return stats;
+}
+
+UNAUDIO_EXPORT UNAudioMemoryUsage UNAudio_GetClipMemory(int32_t handle) {
+    const UNAudioMemoryUsage usage = AudioEngine::Instance().GetClipMemory(handle);
+    UNAUDIO_TRACE(GetClipMemory, 0, handle);
+    return usage;
 }
 
 UNAUDIO_EXPORT void UNAudio_SetMasterVolume(float volume) {
     AudioEngine::Instance().SetMasterVolume(volume);
+    UNAUDIO_TRACE(SetMasterVolume, 0, volume);
 }
 
 UNAUDIO_EXPORT float UNAudio_GetMasterVolume(void) {
-    return AudioEngine::Instance().GetMasterVolume();
+    const float result = AudioEngine::Instance().GetMasterVolume();
+    UNAUDIO_TRACE(GetMasterVolume, result);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_FadeMasterVolume(float volume, float milliseconds,
+                                                 int32_t curve) {
+    const auto result = static_cast<int32_t>(AudioEngine::Instance().FadeMasterVolume(
+        volume, milliseconds, static_cast<UNAudioFadeCurve>(curve)));
+    UNAUDIO_TRACE(FadeMasterVolume, result, volume, milliseconds, curve);
+    return result;
 }
 
 UNAUDIO_EXPORT void UNAudio_SetBufferSize(int32_t frames) {
     AudioEngine::Instance().SetBufferSize(frames);
+    UNAUDIO_TRACE(SetBufferSize, 0, frames);
 }
 
 UNAUDIO_EXPORT float UNAudio_GetCurrentLatency(void) {
-    return AudioEngine::Instance().GetCurrentLatency();
+    const float result = AudioEngine::Instance().GetCurrentLatency();
+    UNAUDIO_TRACE(GetCurrentLatency, result);
+    return result;
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_StartCallTrace(const char* path, int32_t capacity) {
+    if (capacity < 0) return UNAUDIO_ERROR_INVALID_PARAM;
+    const UNAudioResult result = CallTrace::Instance().Start(path, static_cast<uint32_t>(capacity));
+    if (result != UNAUDIO_OK) return result;
+
+    // Joining a running session: open with a synthetic Initialize so replay
+    // starts from the same output configuration.
+    AudioEngine& engine = AudioEngine::Instance();
+    if (engine.IsInitialized()) {
+        const UNAudioOutputConfig config = engine.GetConfig();
+        UNAUDIO_TRACE(Initialize, static_cast<int32_t>(UNAUDIO_OK),
+                      TraceArg::Blob(&config, sizeof(config)));
+    }
+    return UNAUDIO_OK;
+}
+
+UNAUDIO_EXPORT void UNAudio_StopCallTrace(void) {
+    CallTrace::Instance().Stop();
+}
+
+// Zone captures stay out of the call trace: they do not change what plays.
+UNAUDIO_EXPORT int32_t UNAudio_StartZoneTrace(int32_t capacity) {
+#if UNAUDIO_ZONES
+    if (capacity < 0) return UNAUDIO_ERROR_INVALID_PARAM;
+    ZoneTrace::Start(static_cast<uint32_t>(capacity));
+    return UNAUDIO_OK;
+#else
+    (void)capacity;
+    return UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED;
+#endif
+}
+
+UNAUDIO_EXPORT void UNAudio_StopZoneTrace(void) {
+    ZoneTrace::Stop();
+}
+
+UNAUDIO_EXPORT int32_t UNAudio_DumpTrace(const char* path) {
+#if UNAUDIO_ZONES
+    if (!path) return UNAUDIO_ERROR_INVALID_PARAM;
+    const int64_t events = ZoneTrace::Dump(path);
+    if (events < 0) return UNAUDIO_ERROR_FILE_NOT_FOUND;
+    return static_cast<int32_t>(std::min<int64_t>(events, INT32_MAX));
+#else
+    (void)path;
+    return UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED;
+#endif
 }
 
 } // extern "C"
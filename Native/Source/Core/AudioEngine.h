@@ -2,6 +2,8 @@
 #define UNAUDIO_AUDIO_ENGINE_H
 
 #include "AudioTypes.h"
+#include "AudioClip.h"
+#include "Voice.h"
 #include <vector>
 #include <memory>
 #include <mutex>
@@ -10,7 +12,11 @@
 // Forward declarations
 class AudioDecoder;
 class AudioMixer;
+class OutputConverter;
 class AudioOutput;
+class ThreadPool;
+class ClipBank;
+class DecodeScheduler;
 
 /// Core audio engine - manages decoders, mixer, and platform output.
 class AudioEngine {
@@ -26,6 +32,21 @@ public:
                                   UNAudioCompressionMode mode);
     void UnloadAudio(UNAudioSourceHandle handle);
 
+    // Asynchronous loading – format detection and decode run on the load pool
+    UNAudioSourceHandle LoadAudioAsync(const uint8_t* data, size_t size,
+                                       UNAudioCompressionMode mode);
+    UNAudioLoadStatus GetLoadStatus(UNAudioSourceHandle handle) const;
+    UNAudioResult CancelLoad(UNAudioSourceHandle handle);
+    int32_t GetLoadStatusBatch(const UNAudioSourceHandle* handles, int32_t count,
+                               int32_t* outStatus) const;
+
+    // Clip banks – decoders read directly from the memory-mapped bank file
+    int32_t OpenBank(const char* path);
+    void CloseBank(int32_t bankId);
+    int32_t GetBankClipCount(int32_t bankId) const;
+    UNAudioSourceHandle LoadFromBank(int32_t bankId, int32_t clipIndex,
+                                     UNAudioCompressionMode mode);
+
     // Playback control
     UNAudioResult Play(UNAudioSourceHandle handle);
     UNAudioResult Pause(UNAudioSourceHandle handle);
@@ -38,11 +59,102 @@ public:
     UNAudioState GetState(UNAudioSourceHandle handle) const;
     UNAudioClipInfo GetClipInfo(UNAudioSourceHandle handle) const;
 
+    // Gain automation – ramps run sample-accurately on the mixer thread.
+    // SetVolume / SetMasterVolume glide over a few milliseconds instead of stepping.
+    UNAudioResult FadeVolume(UNAudioSourceHandle handle, float volume, float milliseconds,
+                             UNAudioFadeCurve curve);
+
+    /// Equal-power crossfade: `from` fades out and stops, `to` starts (or
+    /// resumes) at silence and fades up to its volume.
+    UNAudioResult Crossfade(UNAudioSourceHandle from, UNAudioSourceHandle to,
+                            float milliseconds);
+
+    /// Keep the first `milliseconds` of a compressed clip decoded so Play()
+    /// starts from PCM while the decoder seeks in the background (0 = off).
+    /// The clip must be loaded; voices already playing keep their old cache.
+    /// Returns UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED for DECOMPRESS_ON_LOAD
+    /// clips, which already start from PCM.
+    UNAudioResult SetAttackCache(UNAudioSourceHandle handle, float milliseconds);
+
+    // Waveform summaries – min/max/RMS pyramid for display
+    UNAudioResult BuildWaveformPeaks(UNAudioSourceHandle handle);
+    int64_t GetWaveformPeaks(UNAudioSourceHandle handle, int32_t level, int64_t start,
+                             int64_t count, UNAudioPeakBin* out);
+    int64_t SaveWaveformPeaks(UNAudioSourceHandle handle, uint8_t* out, size_t capacity);
+    UNAudioResult LoadWaveformPeaks(UNAudioSourceHandle handle, const uint8_t* data,
+                                    size_t size);
+
+    // Instanced voices – concurrent playbacks sharing one loaded clip
+    UNAudioVoiceHandle PlayInstance(UNAudioSourceHandle handle);
+    UNAudioResult StopVoice(UNAudioVoiceHandle voice);
+    void SetVoiceVolume(UNAudioVoiceHandle voice, float volume);
+    UNAudioResult FadeVoiceVolume(UNAudioVoiceHandle voice, float volume, float milliseconds,
+                                  UNAudioFadeCurve curve);
+    UNAudioState GetVoiceState(UNAudioVoiceHandle voice) const;
+
+    // Reverb – one feedback delay network on a shared send bus.  Each voice
+    // feeds it at its own send level (post volume); instances inherit the
+    // send level of their source.
+    UNAudioResult SetReverb(const UNAudioReverbParams& params);
+    void SetSendLevel(UNAudioSourceHandle handle, float level);
+    float GetSendLevel(UNAudioSourceHandle handle) const;
+    void SetVoiceSendLevel(UNAudioVoiceHandle voice, float level);
+
+    // Metering – every voice and the output are metered inside the mix pass:
+    // RMS, sample and true peak, momentary / short-term / integrated LUFS.
+    // Readings are lock-free snapshots; the bulk queries take the engine lock
+    // once per batch and return how many handles were valid.  Voice levels
+    // are post volume; a voice that is not playing reads as silent but keeps
+    // its integrated loudness.
+    UNAudioLevels GetMasterLevels() const;
+    void ResetMasterLoudness();
+    int32_t GetVoiceLevels(const UNAudioVoiceHandle* voices, int32_t count,
+                           UNAudioLevels* out) const;
+    int32_t GetSourceLevels(const UNAudioSourceHandle* handles, int32_t count,
+                            UNAudioLevels* out) const;
+    UNAudioResult SetVoiceMetering(int32_t flags);
+
+    // Memory budget – over budget, the least recently used DECOMPRESS_ON_LOAD
+    // clips drop their PCM and play compressed until played again, when they
+    // are re-decoded in the background (0 = unlimited).
+    UNAudioResult SetMemoryBudget(int64_t bytes);
+    UNAudioMemoryStats GetMemoryStats() const;
+    UNAudioMemoryUsage GetClipMemory(UNAudioSourceHandle handle) const;
+
+    // Decode-ahead – worker threads keep each playing compressed voice a block
+    // or two decoded ahead of the mix, which only decodes inline when a
+    // worker fell behind.  The thread count applies at Initialize (-1 = one
+    // per core but one, 0 = off: every voice decodes in the mix).
+    UNAudioResult SetDecodeThreads(int32_t count);
+    UNAudioDecodeStats GetDecodeStats() const;
+
     // Engine-level
     void SetMasterVolume(float volume);
     float GetMasterVolume() const;
+    UNAudioResult FadeMasterVolume(float volume, float milliseconds, UNAudioFadeCurve curve);
     void SetBufferSize(int32_t frames);
     float GetCurrentLatency() const;
+    UNAudioOutputConfig GetConfig() const;
+
+    /// DSP clock: frames rendered since the process started.  Monotonic
+    /// across Shutdown / Initialize; stamps call-trace records.
+    int64_t GetDspFrame() const { return dspFrame_.load(std::memory_order_relaxed); }
+
+    /// Mix one block into buffer (interleaved float, config channels wide).
+    /// Called from the output callback.
+    void Render(float* buffer, int32_t frameCount);
+
+    /// Mix one block straight into a device buffer: the config-layout mix is
+    /// up/downmixed to deviceChannels (1, 2, 6 or 8) and converted to format.
+    /// Writes silence if the layout pair is unsupported.  Called from the
+    /// output callback of devices that do not take the float mix as is.
+    void RenderDevice(void* buffer, int32_t frameCount, int32_t deviceChannels,
+                      UNAudioSampleFormat format);
+
+    /// Select the RenderDevice conversion for a device ahead of time, so the
+    /// output callback does not.  Call after Initialize and before the output
+    /// starts.  Returns false for an unsupported layout or format.
+    bool PrepareDevice(int32_t deviceChannels, UNAudioSampleFormat format);
 
 private:
     AudioEngine();
@@ -50,22 +162,73 @@ private:
     AudioEngine(const AudioEngine&) = delete;
     AudioEngine& operator=(const AudioEngine&) = delete;
 
+    /// A loaded clip plus the voice driven by Play/Pause/Stop(handle).
     struct AudioSource {
-        std::unique_ptr<AudioDecoder> decoder;
-        UNAudioState state = UNAUDIO_STATE_STOPPED;
-        float volume = 1.0f;
-        bool loop = false;
-        UNAudioClipInfo clipInfo{};
+        std::shared_ptr<AudioClip> clip;
+        std::shared_ptr<Voice> voice;
+    };
+
+    /// Voice handles pack a slot index with a generation counter so a
+    /// recycled slot never answers to a stale handle.
+    static constexpr int      kVoiceIndexBits = 16;
+    static constexpr int32_t  kVoiceIndexMask = (1 << kVoiceIndexBits) - 1;
+    static constexpr uint16_t kVoiceGenerationMask = 0x7FFF;
+
+    /// Length of the glide applied to plain volume changes.
+    static constexpr float kDezipperMs = 5.0f;
+    struct VoiceSlot {
+        std::shared_ptr<Voice> voice;
+        uint16_t generation = 0;
     };
 
+    static std::shared_ptr<LoadTask> MakeLoadTask(const uint8_t* data, size_t size,
+                                                  UNAudioCompressionMode mode);
+    /// `indexed`, for bank loads, is the clip as the bank's index describes
+    /// it; the decoder's header must agree before anything is decoded.
+    static bool RunLoad(LoadTask& task, const UNAudioClipInfo* indexed = nullptr);
+    void PublishLoad(UNAudioSourceHandle handle, const std::shared_ptr<LoadTask>& task);
+    UNAudioSourceHandle AddSource(std::shared_ptr<LoadTask> task, UNAudioCompressionMode mode);
+    AudioSource* FindSource(UNAudioSourceHandle handle) const;
+    std::shared_ptr<const WaveformPeaks> AcquirePeaks(UNAudioSourceHandle handle);
+    void StartVoice(const std::shared_ptr<Voice>& voice);
+    void FadeVoice(Voice& voice, float volume, int32_t frames, UNAudioFadeCurve curve);
+    void SetSend(Voice& voice, float level);
+    static UNAudioLevels ReadLevels(const Voice& voice);
+    int32_t MsToFrames(float milliseconds) const;
+    int32_t FindVoice(UNAudioVoiceHandle handle) const;
+    void ReleaseVoice(int32_t index);
+    void ReapVoices();
+    template <typename Fn> void ForEachVoice(Fn&& fn) const;
+    void MeasureMemory(const AudioClip* only, UNAudioMemoryUsage& usage) const;
+    void EnforceBudget(const AudioClip* keep);
+    void PromoteClip(const std::shared_ptr<AudioClip>& clip);
+
     std::vector<std::unique_ptr<AudioSource>> sources_;
+    std::vector<VoiceSlot> voiceSlots_;
+    std::vector<int32_t> freeVoiceSlots_;
     std::unique_ptr<AudioMixer> mixer_;
+    std::unique_ptr<OutputConverter> converter_;   // mixing thread only
+    std::vector<float> deviceMix_;                 // mixing thread only
     std::unique_ptr<AudioOutput> output_;
-    std::mutex mutex_;
-    std::atomic<bool> initialized_{false};
+    std::shared_ptr<ThreadPool> loadPool_;   // null once Shutdown has begun
+    std::unique_ptr<DecodeScheduler> decodeAhead_;
+    std::vector<std::shared_ptr<const ClipBank>> banks_;
+    std::mutex lifecycleMutex_;   // serialises Initialize and Shutdown
+    mutable std::mutex mutex_;
+    std::atomic<bool> initialized_{false};   // cleared under mutex_
     std::atomic<float> masterVolume_{1.0f};
+    std::atomic<uint32_t> voiceMetering_{UNAUDIO_METER_LOUDNESS};
+    std::atomic<int32_t> decodeThreads_{-1};
+    std::atomic<int64_t> dspFrame_{0};
     UNAudioOutputConfig config_{};
     int32_t nextHandle_ = 0;
+
+    // Memory budget, under mutex_
+    UNAudioMemoryUsage clipMemory_{};   // buffers owned by loaded clips, kept by CountClip
+    int64_t memoryBudget_ = 0;
+    uint64_t useClock_ = 0;
+    int64_t demotions_ = 0;
+    int64_t promotions_ = 0;
 };
 
 // ── P/Invoke C API (exported to Unity) ──────────────────────────
@@ -81,6 +244,24 @@ UNAUDIO_EXPORT int32_t  UNAudio_LoadAudio(const uint8_t* data, int32_t size,
                                            int32_t compressionMode);
 UNAUDIO_EXPORT void     UNAudio_UnloadAudio(int32_t handle);
 
+UNAUDIO_EXPORT int32_t  UNAudio_LoadAudioAsync(const uint8_t* data, int32_t size,
+                                                int32_t compressionMode);
+UNAUDIO_EXPORT int32_t  UNAudio_GetLoadStatus(int32_t handle);
+UNAUDIO_EXPORT int32_t  UNAudio_CancelLoad(int32_t handle);
+UNAUDIO_EXPORT int32_t  UNAudio_GetLoadStatusBatch(const int32_t* handles, int32_t count,
+                                                    int32_t* outStatus);
+
+UNAUDIO_EXPORT int32_t  UNAudio_TranscodeADPCM(const uint8_t* data, int32_t size,
+                                                uint8_t* outBuffer, int32_t outCapacity);
+
+UNAUDIO_EXPORT int32_t  UNAudio_WriteBank(const char* path, const uint8_t* data,
+                                           const int32_t* sizes, int32_t count);
+UNAUDIO_EXPORT int32_t  UNAudio_OpenBank(const char* path);
+UNAUDIO_EXPORT void     UNAudio_CloseBank(int32_t bankId);
+UNAUDIO_EXPORT int32_t  UNAudio_GetBankClipCount(int32_t bankId);
+UNAUDIO_EXPORT int32_t  UNAudio_LoadFromBank(int32_t bankId, int32_t clipIndex,
+                                              int32_t compressionMode);
+
 UNAUDIO_EXPORT int32_t  UNAudio_Play(int32_t handle);
 UNAUDIO_EXPORT int32_t  UNAudio_Pause(int32_t handle);
 UNAUDIO_EXPORT int32_t  UNAudio_Stop(int32_t handle);
@@ -90,12 +271,64 @@ UNAUDIO_EXPORT float    UNAudio_GetVolume(int32_t handle);
 UNAUDIO_EXPORT void     UNAudio_SetLoop(int32_t handle, int32_t loop);
 UNAUDIO_EXPORT int32_t  UNAudio_GetState(int32_t handle);
 UNAUDIO_EXPORT UNAudioClipInfo UNAudio_GetClipInfo(int32_t handle);
+UNAUDIO_EXPORT int32_t  UNAudio_SetAttackCache(int32_t handle, float milliseconds);
+
+UNAUDIO_EXPORT int32_t  UNAudio_FadeVolume(int32_t handle, float volume, float milliseconds,
+                                            int32_t curve);
+UNAUDIO_EXPORT int32_t  UNAudio_Crossfade(int32_t from, int32_t to, float milliseconds);
+
+UNAUDIO_EXPORT int32_t  UNAudio_BuildWaveformPeaks(int32_t handle);
+UNAUDIO_EXPORT int32_t  UNAudio_GetWaveformPeaks(int32_t handle, int32_t level, int32_t start,
+                                                  int32_t count, UNAudioPeakBin* out);
+UNAUDIO_EXPORT int32_t  UNAudio_SaveWaveformPeaks(int32_t handle, uint8_t* outBuffer,
+                                                   int32_t outCapacity);
+UNAUDIO_EXPORT int32_t  UNAudio_LoadWaveformPeaks(int32_t handle, const uint8_t* data,
+                                                   int32_t size);
+
+UNAUDIO_EXPORT int32_t  UNAudio_PlayInstance(int32_t handle);
+UNAUDIO_EXPORT int32_t  UNAudio_StopVoice(int32_t voice);
+UNAUDIO_EXPORT void     UNAudio_SetVoiceVolume(int32_t voice, float volume);
+UNAUDIO_EXPORT int32_t  UNAudio_FadeVoiceVolume(int32_t voice, float volume,
+                                                 float milliseconds, int32_t curve);
+UNAUDIO_EXPORT int32_t  UNAudio_GetVoiceState(int32_t voice);
+
+UNAUDIO_EXPORT int32_t  UNAudio_SetReverb(UNAudioReverbParams params);
+UNAUDIO_EXPORT void     UNAudio_SetSendLevel(int32_t handle, float level);
+UNAUDIO_EXPORT float    UNAudio_GetSendLevel(int32_t handle);
+UNAUDIO_EXPORT void     UNAudio_SetVoiceSendLevel(int32_t voice, float level);
+
+UNAUDIO_EXPORT UNAudioLevels UNAudio_GetMasterLevels(void);
+UNAUDIO_EXPORT void     UNAudio_ResetMasterLoudness(void);
+UNAUDIO_EXPORT int32_t  UNAudio_GetVoiceLevels(const int32_t* voices, int32_t count,
+                                                UNAudioLevels* outLevels);
+UNAUDIO_EXPORT int32_t  UNAudio_GetSourceLevels(const int32_t* handles, int32_t count,
+                                                 UNAudioLevels* outLevels);
+UNAUDIO_EXPORT int32_t  UNAudio_SetVoiceMetering(int32_t flags);
+
+UNAUDIO_EXPORT int32_t  UNAudio_SetDecodeThreads(int32_t count);
+UNAUDIO_EXPORT UNAudioDecodeStats UNAudio_GetDecodeStats(void);
+
+UNAUDIO_EXPORT int32_t  UNAudio_SetMemoryBudget(int64_t bytes);
+UNAUDIO_EXPORT UNAudioMemoryStats UNAudio_GetMemoryStats(void);
+UNAUDIO_EXPORT UNAudioMemoryUsage UNAudio_GetClipMemory(int32_t handle);
 
 UNAUDIO_EXPORT void     UNAudio_SetMasterVolume(float volume);
 UNAUDIO_EXPORT float    UNAudio_GetMasterVolume(void);
+UNAUDIO_EXPORT int32_t  UNAudio_FadeMasterVolume(float volume, float milliseconds,
+                                                  int32_t curve);
 UNAUDIO_EXPORT void     UNAudio_SetBufferSize(int32_t frames);
 UNAUDIO_EXPORT float    UNAudio_GetCurrentLatency(void);
 
+// Call trace (diagnostics) – records every call above into a binary ring file
+UNAUDIO_EXPORT int32_t  UNAudio_StartCallTrace(const char* path, int32_t capacity);
+UNAUDIO_EXPORT void     UNAudio_StopCallTrace(void);
+
+// Trace zones (diagnostics) – timeline of the engine's hot paths as Chrome
+// trace-event JSON.  Builds without UNAUDIO_ZONES return FORMAT_NOT_SUPPORTED.
+UNAUDIO_EXPORT int32_t  UNAudio_StartZoneTrace(int32_t capacity);
+UNAUDIO_EXPORT void     UNAudio_StopZoneTrace(void);
+UNAUDIO_EXPORT int32_t  UNAudio_DumpTrace(const char* path);
+
 #ifdef __cplusplus
 }
 #endif
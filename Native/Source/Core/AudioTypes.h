@@ -34,11 +34,15 @@ typedef struct {
 // Audio source handle
 typedef int32_t UNAudioSourceHandle;
 
+// Voice handle (one playback instance of a loaded clip)
+typedef int32_t UNAudioVoiceHandle;
+
 // Compression mode
 typedef enum {
     UNAUDIO_COMPRESS_IN_MEMORY = 0,  // Compressed in memory, decode on play
     UNAUDIO_DECOMPRESS_ON_LOAD = 1,  // Decompress when loaded
-    UNAUDIO_STREAMING = 2            // Stream from disk
+    UNAUDIO_STREAMING = 2,           // Stream from disk
+    UNAUDIO_ADPCM_IN_MEMORY = 3      // Transcode to block ADPCM (~4:1), cheap decode on play
 } UNAudioCompressionMode;
 
 // Audio state
@@ -48,6 +52,38 @@ typedef enum {
     UNAUDIO_STATE_PAUSED = 2
 } UNAudioState;
 
+// Gain automation curve (see UNAudio_FadeVolume)
+typedef enum {
+    UNAUDIO_FADE_LINEAR = 0,        // Straight line in amplitude
+    UNAUDIO_FADE_EQUAL_POWER = 1    // Quarter sine/cosine, constant power across a crossfade
+} UNAudioFadeCurve;
+
+// Device buffer sample format (see AudioEngine::RenderDevice)
+typedef enum {
+    UNAUDIO_SAMPLE_FLOAT32 = 0,     // 32-bit float, passed through unclamped
+    UNAUDIO_SAMPLE_S16 = 1,         // 16-bit signed, TPDF dithered
+    UNAUDIO_SAMPLE_S24 = 2,         // 24-bit signed packed in 3 bytes (little-endian), TPDF dithered
+    UNAUDIO_SAMPLE_S32 = 3          // 32-bit signed
+} UNAudioSampleFormat;
+
+// Optional parts of voice metering (see UNAudio_SetVoiceMetering); RMS and
+// sample peak are always measured
+typedef enum {
+    UNAUDIO_METER_LOUDNESS = 1,     // K-weighted momentary / short-term / integrated LUFS
+    UNAUDIO_METER_TRUE_PEAK = 2,    // 4x oversampled peak
+    UNAUDIO_METER_ALL = 3
+} UNAudioMeterFlags;
+
+// Clip load status (see UNAudio_LoadAudioAsync)
+typedef enum {
+    UNAUDIO_LOAD_NONE = 0,       // Invalid or unloaded handle
+    UNAUDIO_LOAD_PENDING = 1,    // Queued, waiting for a worker
+    UNAUDIO_LOAD_LOADING = 2,    // Format detection / decode in progress
+    UNAUDIO_LOAD_LOADED = 3,     // Ready to play
+    UNAUDIO_LOAD_FAILED = 4,     // Unsupported format or decode error
+    UNAUDIO_LOAD_CANCELLED = 5   // Cancelled before completion
+} UNAudioLoadStatus;
+
 // Result codes
 typedef enum {
     UNAUDIO_OK = 0,
@@ -71,6 +107,62 @@ typedef struct {
     UNAudioCompressionMode compressionMode;
 } UNAudioClipInfo;
 
+// Bytes held in memory, per clip or engine-wide (see UNAudio_GetMemoryStats)
+typedef struct {
+    int64_t compressedBytes;   // encoded clip data copied into memory
+    int64_t pcmBytes;          // decoded samples: DECOMPRESS_ON_LOAD clips and attack caches
+    int64_t streamBytes;       // STREAMING clip buffers
+    int64_t decoderBytes;      // per-voice decoder state and decode-ahead buffers
+} UNAudioMemoryUsage;
+
+// Engine-wide memory accounting and budget state
+typedef struct {
+    UNAudioMemoryUsage usage;
+    int64_t totalBytes;
+    int64_t budgetBytes;       // 0 = unlimited
+    int32_t clipCount;
+    int32_t demotedClips;      // DECOMPRESS_ON_LOAD clips currently playing compressed
+    int64_t demotions;         // since Initialize
+    int64_t promotions;
+} UNAudioMemoryStats;
+
+// Send-bus reverb (see UNAudio_SetReverb)
+typedef struct {
+    int32_t lineCount;         // feedback delay lines: 8, 16, or 0 to remove the reverb
+    float decayTime;           // seconds to decay 60 dB at low frequencies
+    float damping;             // 0..1, how much faster high frequencies decay
+    float wetLevel;            // gain of the reverb return into the mix
+} UNAudioReverbParams;
+
+// Level meter reading (see UNAudio_GetMasterLevels); levels are linear,
+// loudness is -infinity for silence or when not metered
+typedef struct {
+    float rms;                 // unweighted, over the last 400 ms
+    float peak;                // sample peak, last 400 ms
+    float truePeak;            // 4x oversampled peak, last 400 ms (= peak if not metered)
+    float momentaryLufs;       // K-weighted, 400 ms
+    float shortTermLufs;       // K-weighted, 3 s
+    float integratedLufs;      // gated (ITU-R BS.1770), since playback started or reset
+} UNAudioLevels;
+
+// Decode-ahead counters since Initialize (see UNAudio_GetDecodeStats)
+typedef struct {
+    int32_t workerCount;       // 0 = decode-ahead off, voices decode in the mix
+    int32_t streamCount;       // compressed voices currently decoding ahead
+    int64_t aheadFrames;       // decoded by workers
+    int64_t inlineFrames;      // decoded by the mix itself (voice starts, fallbacks)
+    int64_t fallbacks;         // blocks in which a voice's read-ahead ran dry
+    int64_t dropouts;          // blocks cut short: a preempted worker held the decoder
+    int64_t steals;            // jobs a worker took from another worker's queue
+} UNAudioDecodeStats;
+
+// Waveform summary bin (see UNAudio_GetWaveformPeaks); all channels folded
+typedef struct {
+    float min;
+    float max;
+    float rms;
+} UNAudioPeakBin;
+
 #ifdef __cplusplus
 }
 #endif
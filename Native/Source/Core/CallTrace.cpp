@@ -0,0 +1,211 @@
+#include "CallTrace.h"
+#include <algorithm>
+#include <cstring>
+
+static_assert(sizeof(CallTrace::TraceFileHeader) == 48, "TraceFileHeader layout changed");
+static_assert(sizeof(CallTrace::TraceRecord)     == 64, "TraceRecord layout changed");
+
+namespace {
+
+constexpr char kMagic[4] = { 'U', 'N', 'T', 'R' };
+
+// Default ring size: ~4 MB of records.
+constexpr uint32_t kDefaultCapacity = 65536;
+
+// Records buffered before a ring write.
+constexpr size_t kFlushRecords = 256;
+
+uint64_t HashBytes(const void* data, size_t size) {
+    // FNV-1a, seeded with the size so equal prefixes of different lengths differ.
+    uint64_t hash = 14695981039346656037ull ^ size;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool WriteAt(FILE* file, uint64_t offset, const void* data, size_t size) {
+#ifdef _WIN32
+    if (_fseeki64(file, static_cast<__int64>(offset), SEEK_SET) != 0) return false;
+#else
+    if (fseeko(file, static_cast<off_t>(offset), SEEK_SET) != 0) return false;
+#endif
+    return std::fwrite(data, 1, size, file) == size;
+}
+
+bool ReadAt(FILE* file, uint64_t offset, void* data, size_t size) {
+#ifdef _WIN32
+    if (_fseeki64(file, static_cast<__int64>(offset), SEEK_SET) != 0) return false;
+#else
+    if (fseeko(file, static_cast<off_t>(offset), SEEK_SET) != 0) return false;
+#endif
+    return std::fread(data, 1, size, file) == size;
+}
+
+} // namespace
+
+std::atomic<bool> CallTrace::active_{false};
+
+TraceArg::TraceArg(float value) {
+    uint32_t raw;
+    std::memcpy(&raw, &value, sizeof(raw));
+    bits = raw;
+}
+
+TraceArg TraceArg::Blob(const void* data, size_t size) {
+    TraceArg arg(int64_t(0));
+    arg.data = data;
+    arg.size = data ? size : 0;
+    return arg;
+}
+
+CallTrace& CallTrace::Instance() {
+    static CallTrace instance;
+    return instance;
+}
+
+CallTrace::~CallTrace() { Stop(); }
+
+// ── Control ──────────────────────────────────────────────────────
+
+UNAudioResult CallTrace::Start(const char* path, uint32_t capacity) {
+    if (!path) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    StopLocked();
+
+    file_ = std::fopen(path, "wb+");
+    if (!file_) return UNAUDIO_ERROR_FILE_NOT_FOUND;
+
+    header_ = {};
+    std::memcpy(header_.magic, kMagic, 4);
+    header_.version    = kVersion;
+    header_.recordSize = sizeof(TraceRecord);
+    header_.capacity   = capacity ? capacity : kDefaultCapacity;
+    header_.blobOffset = sizeof(TraceFileHeader) +
+                         static_cast<uint64_t>(header_.capacity) * sizeof(TraceRecord);
+    header_.blobEnd    = header_.blobOffset;
+    if (!WriteAt(file_, 0, &header_, sizeof(header_))) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return UNAUDIO_ERROR_OUTPUT_FAILED;
+    }
+
+    staged_.clear();
+    staged_.reserve(kFlushRecords);
+    blobs_.clear();
+    start_ = std::chrono::steady_clock::now();
+    active_ = true;
+    return UNAUDIO_OK;
+}
+
+void CallTrace::Stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StopLocked();
+}
+
+void CallTrace::StopLocked() {
+    active_ = false;
+    if (!file_) return;
+    FlushLocked();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+// ── Recording ────────────────────────────────────────────────────
+
+void CallTrace::Record(TraceOp op, int64_t dspFrame, TraceArg result,
+                       std::initializer_list<TraceArg> args) {
+    // Hash blobs before locking: clip data can be megabytes, and every other
+    // traced call would queue behind it.
+    uint64_t hashes[kMaxArgs] = {};
+    int index = 0;
+    for (const TraceArg& arg : args) {
+        if (index == kMaxArgs) break;
+        if (arg.data) hashes[index] = HashBytes(arg.data, arg.size);
+        ++index;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return;   // stopped between the IsActive() check and here
+
+    TraceRecord record{};
+    record.dspFrame  = dspFrame;
+    record.wallNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count();
+    record.op     = static_cast<uint16_t>(op);
+    record.result = result.bits;
+
+    for (const TraceArg& arg : args) {
+        if (record.argCount == kMaxArgs) break;
+        record.args[record.argCount] =
+            arg.data ? WriteBlobLocked(arg.data, arg.size, hashes[record.argCount]) : arg.bits;
+        ++record.argCount;
+    }
+    if (op == TraceOp::Initialize && record.argCount > 0 && record.result == UNAUDIO_OK)
+        header_.configBlob = record.args[0];
+
+    staged_.push_back(record);
+    if (staged_.size() >= kFlushRecords) FlushLocked();
+}
+
+void CallTrace::FlushLocked() {
+    // Staged records are consecutive, so they split into at most two runs
+    // around the end of the ring.
+    size_t written = 0;
+    while (written < staged_.size()) {
+        const uint64_t slot = (header_.recordCount + written) % header_.capacity;
+        const size_t run = static_cast<size_t>(
+            std::min<uint64_t>(staged_.size() - written, header_.capacity - slot));
+        if (!WriteAt(file_, sizeof(TraceFileHeader) + slot * sizeof(TraceRecord),
+                     staged_.data() + written, run * sizeof(TraceRecord)))
+            break;
+        written += run;
+    }
+    header_.recordCount += written;
+    staged_.clear();
+
+    WriteAt(file_, 0, &header_, sizeof(header_));
+    std::fflush(file_);
+}
+
+uint64_t CallTrace::WriteBlobLocked(const void* data, size_t size, uint64_t hash) {
+    // A hash match is only a candidate: the stored bytes must agree too.
+    auto range = blobs_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+        if (BlobMatchesLocked(it->second, data, size)) return it->second;
+
+    const uint64_t offset = header_.blobEnd;
+    const uint64_t length = size;
+    static const uint8_t kPadding[8] = {};
+    const size_t padding = (8 - size % 8) % 8;
+    const uint64_t stored = sizeof(length) + size + padding;
+    // offset 0 is never a blob: replay treats it as missing.
+    if (offset - header_.blobOffset + stored > kMaxBlobBytes) return 0;
+    if (!WriteAt(file_, offset, &length, sizeof(length)) ||
+        std::fwrite(data, 1, size, file_) != size ||
+        std::fwrite(kPadding, 1, padding, file_) != padding)
+        return 0;
+
+    header_.blobEnd += stored;
+    blobs_.emplace(hash, offset);
+    return offset;
+}
+
+bool CallTrace::BlobMatchesLocked(uint64_t offset, const void* data, size_t size) {
+    uint64_t length = 0;
+    if (!ReadAt(file_, offset, &length, sizeof(length)) || length != size) return false;
+
+    uint8_t chunk[4096];
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t done = 0; done < size;) {
+        const size_t n = std::min(sizeof(chunk), size - done);
+        if (std::fread(chunk, 1, n, file_) != n ||
+            std::memcmp(chunk, bytes + done, n) != 0)
+            return false;
+        done += n;
+    }
+    return true;
+}
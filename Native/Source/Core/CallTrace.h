@@ -0,0 +1,120 @@
+#ifndef UNAUDIO_CALL_TRACE_H
+#define UNAUDIO_CALL_TRACE_H
+
+#include "AudioTypes.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// C API entry points, as stored in trace records.  Append only: the
+/// values are part of the file format.
+enum class TraceOp : uint16_t {
+    Initialize, Shutdown, IsInitialized,
+    LoadAudio, UnloadAudio, LoadAudioAsync, GetLoadStatus, CancelLoad, GetLoadStatusBatch,
+    TranscodeADPCM, WriteBank, OpenBank, CloseBank, GetBankClipCount, LoadFromBank,
+    Play, Pause, Stop,
+    SetVolume, GetVolume, SetLoop, GetState, GetClipInfo, SetAttackCache,
+    FadeVolume, Crossfade,
+    BuildWaveformPeaks, GetWaveformPeaks, SaveWaveformPeaks, LoadWaveformPeaks,
+    PlayInstance, StopVoice, SetVoiceVolume, FadeVoiceVolume, GetVoiceState,
+    SetMasterVolume, GetMasterVolume, FadeMasterVolume, SetBufferSize, GetCurrentLatency,
+    SetMemoryBudget, GetMemoryStats, GetClipMemory,
+    SetReverb, SetSendLevel, GetSendLevel, SetVoiceSendLevel,
+    GetMasterLevels, ResetMasterLoudness, GetVoiceLevels, GetSourceLevels, SetVoiceMetering,
+    SetDecodeThreads, GetDecodeStats,
+};
+
+/// One recorded argument or result: an integer, a float, or a blob of
+/// input bytes (clip data, paths) that is stored once in the trace file and
+/// referenced by offset.
+struct TraceArg {
+    TraceArg(int32_t value) : bits(static_cast<uint64_t>(static_cast<int64_t>(value))) {}
+    TraceArg(int64_t value) : bits(static_cast<uint64_t>(value)) {}
+    TraceArg(float value);
+
+    static TraceArg Blob(const void* data, size_t size);
+
+    uint64_t bits = 0;
+    const void* data = nullptr;
+    size_t size = 0;
+};
+
+/// Opt-in recorder of C API calls.  Each call is logged with its arguments,
+/// result and the DSP clock (frames rendered so far) into a fixed-capacity
+/// ring inside the trace file, so a session can be replayed block-accurately
+/// by Tools/TraceReplay.
+///
+/// File layout (little-endian):
+///   TraceFileHeader | TraceRecord[capacity] (ring) | blobs
+/// The ring holds the newest min(recordCount, capacity) records; the oldest
+/// sits at slot recordCount % capacity once it has wrapped.  Each blob is a
+/// uint64 byte count followed by the bytes, padded to 8; identical blobs are
+/// stored once.  Unlike the ring, the blob area grows with every distinct
+/// blob, up to kMaxBlobBytes; later blobs are recorded as missing (offset 0).
+class CallTrace {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr int kMaxArgs = 4;
+    static constexpr uint64_t kMaxBlobBytes = 1ull << 30;
+
+    struct TraceFileHeader {
+        char     magic[4];         // "UNTR"
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t capacity;         // ring slots
+        uint64_t recordCount;      // records ever written
+        uint64_t blobOffset;       // start of the blob area
+        uint64_t blobEnd;
+        uint64_t configBlob;       // config of the latest Initialize, kept for
+                                   // replaying a ring that wrapped past it (0 = none)
+    };
+
+    struct TraceRecord {
+        int64_t  dspFrame;         // engine DSP clock when the call returned
+        int64_t  wallNanos;        // steady clock since the trace started
+        uint16_t op;               // TraceOp
+        uint16_t argCount;
+        uint32_t reserved;
+        uint64_t result;
+        uint64_t args[kMaxArgs];   // integers, float bits or blob offsets, per op
+    };
+
+    static CallTrace& Instance();
+
+    /// Cheap check for the C API wrappers; arguments are only built when true.
+    static bool IsActive() { return active_.load(std::memory_order_relaxed); }
+
+    /// Start recording into path (truncated), keeping the last `capacity`
+    /// calls (0 = default).  Replaces a trace that is already running.
+    UNAudioResult Start(const char* path, uint32_t capacity);
+
+    /// Flush and close the trace file.
+    void Stop();
+
+    void Record(TraceOp op, int64_t dspFrame, TraceArg result,
+                std::initializer_list<TraceArg> args);
+
+private:
+    CallTrace() = default;
+    ~CallTrace();
+
+    void StopLocked();
+    void FlushLocked();
+    uint64_t WriteBlobLocked(const void* data, size_t size, uint64_t hash);
+    bool BlobMatchesLocked(uint64_t offset, const void* data, size_t size);
+
+    static std::atomic<bool> active_;
+
+    std::mutex mutex_;
+    FILE* file_ = nullptr;
+    TraceFileHeader header_{};
+    std::vector<TraceRecord> staged_;       // written to the ring in batches
+    std::unordered_multimap<uint64_t, uint64_t> blobs_;   // content hash -> offsets
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif // UNAUDIO_CALL_TRACE_H
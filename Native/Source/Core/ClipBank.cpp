@@ -0,0 +1,118 @@
+#include "ClipBank.h"
+#include "../Decoder/DecoderFactory.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static_assert(sizeof(ClipBank::BankHeader) == 16, "BankHeader layout changed");
+static_assert(sizeof(ClipBank::BankEntry)  == 32, "BankEntry layout changed");
+
+namespace {
+
+constexpr char kMagic[4] = { 'U', 'N', 'A', 'B' };
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ── Reading ──────────────────────────────────────────────────────
+
+std::shared_ptr<ClipBank> ClipBank::Open(const char* path) {
+    std::shared_ptr<ClipBank> bank(new ClipBank());
+    if (!bank->file_.Open(path)) return nullptr;
+
+    const uint8_t* base = bank->file_.GetData();
+    const uint64_t size = bank->file_.GetSize();
+    if (size < sizeof(BankHeader)) return nullptr;
+
+    const auto* header = reinterpret_cast<const BankHeader*>(base);
+    if (std::memcmp(header->magic, kMagic, 4) != 0 || header->version != kVersion)
+        return nullptr;
+
+    const uint64_t indexEnd = sizeof(BankHeader) +
+                              static_cast<uint64_t>(header->clipCount) * sizeof(BankEntry);
+    if (indexEnd > size) return nullptr;
+    const uint32_t alignment = header->dataAlignment;
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) return nullptr;
+
+    // Validate every entry once so lookups can stay unchecked.
+    const auto* entries = reinterpret_cast<const BankEntry*>(base + sizeof(BankHeader));
+    for (uint32_t i = 0; i < header->clipCount; ++i) {
+        const BankEntry& e = entries[i];
+        if (e.dataOffset < indexEnd || e.dataOffset % alignment != 0) return nullptr;
+        if (e.dataOffset > size || e.dataSize > size - e.dataOffset) return nullptr;
+    }
+
+    bank->header_  = header;
+    bank->entries_ = entries;
+    return bank;
+}
+
+const ClipBank::BankEntry* ClipBank::GetEntry(int32_t index) const {
+    if (index < 0 || static_cast<uint32_t>(index) >= header_->clipCount) return nullptr;
+    return &entries_[index];
+}
+
+// ── Writing ──────────────────────────────────────────────────────
+
+UNAudioResult ClipBank::Write(const char* path, const uint8_t* data,
+                              const int32_t* sizes, int32_t count) {
+    if (!path || !data || !sizes || count <= 0) return UNAUDIO_ERROR_INVALID_PARAM;
+
+    std::vector<BankEntry> entries(static_cast<size_t>(count));
+    std::vector<const uint8_t*> payloads(static_cast<size_t>(count));
+
+    const uint8_t* cursor = data;
+    for (int32_t i = 0; i < count; ++i) {
+        if (sizes[i] <= 0) return UNAUDIO_ERROR_INVALID_PARAM;
+        const size_t clipSize = static_cast<size_t>(sizes[i]);
+
+        auto decoder = CreateDecoder(cursor, clipSize);
+        if (!decoder) return UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED;
+
+        const UNAudioFormat format = decoder->GetFormat();
+        BankEntry& e = entries[i];
+        e.dataSize    = clipSize;
+        e.totalFrames = decoder->GetTotalFrames();
+        e.sampleRate  = format.sampleRate;
+        e.channels    = static_cast<int16_t>(format.channels);
+        e.format      = static_cast<uint16_t>(DetectAudioFormat(cursor, clipSize));
+
+        payloads[i] = cursor;
+        cursor += clipSize;
+    }
+
+    BankHeader header{};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version         = kVersion;
+    header.clipCount       = static_cast<uint32_t>(count);
+    header.dataAlignment   = kAlignment;
+
+    const uint64_t indexEnd = sizeof(BankHeader) + entries.size() * sizeof(BankEntry);
+    uint64_t offset = indexEnd;
+    for (auto& e : entries) {
+        offset = AlignUp(offset, kAlignment);
+        e.dataOffset = offset;
+        offset += e.dataSize;
+    }
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return UNAUDIO_ERROR_FILE_NOT_FOUND;
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(BankEntry), entries.size(), file) == entries.size();
+
+    static const uint8_t kZeros[kAlignment] = {};
+    uint64_t written = indexEnd;
+    for (size_t i = 0; ok && i < entries.size(); ++i) {
+        const uint64_t padding = entries[i].dataOffset - written;
+        ok = (padding == 0 || std::fwrite(kZeros, 1, padding, file) == padding) &&
+             std::fwrite(payloads[i], 1, entries[i].dataSize, file) == entries[i].dataSize;
+        written = entries[i].dataOffset + entries[i].dataSize;
+    }
+
+    if (std::fclose(file) != 0) ok = false;
+    return ok ? UNAUDIO_OK : UNAUDIO_ERROR_OUTPUT_FAILED;
+}
@@ -0,0 +1,61 @@
+#ifndef UNAUDIO_CLIP_BANK_H
+#define UNAUDIO_CLIP_BANK_H
+
+#include "AudioTypes.h"
+#include "MappedFile.h"
+#include <memory>
+
+/// Packed clip bank: many encoded clips in one memory-mapped file.
+///
+/// Layout (little-endian):
+///   BankHeader | BankEntry[clipCount] | clip payloads
+/// Every payload starts on a dataAlignment boundary, so decoders read straight
+/// from the mapping without copying.  A clip loads with the decoder its
+/// entry's format names, and the entry's rate, channels and frame count are
+/// checked against the decoder's header before anything is decoded.
+class ClipBank {
+public:
+    static constexpr uint32_t kVersion   = 2;
+    static constexpr uint32_t kAlignment = 64;
+
+    struct BankHeader {
+        char     magic[4];         // "UNAB"
+        uint32_t version;
+        uint32_t clipCount;
+        uint32_t dataAlignment;    // power of two; every dataOffset is a multiple
+    };
+
+    struct BankEntry {
+        uint64_t dataOffset;       // from start of file
+        uint64_t dataSize;
+        int64_t  totalFrames;
+        int32_t  sampleRate;
+        int16_t  channels;
+        uint16_t format;           // AudioFileFormat
+    };
+
+    /// Map and validate a bank file.  Returns nullptr on failure.
+    static std::shared_ptr<ClipBank> Open(const char* path);
+
+    /// Build a bank from count clips stored back to back in data.
+    static UNAudioResult Write(const char* path, const uint8_t* data,
+                               const int32_t* sizes, int32_t count);
+
+    int32_t GetClipCount() const { return static_cast<int32_t>(header_->clipCount); }
+
+    /// O(1) index lookup; nullptr if index is out of range.
+    const BankEntry* GetEntry(int32_t index) const;
+
+    const uint8_t* GetClipData(const BankEntry& entry) const {
+        return file_.GetData() + entry.dataOffset;
+    }
+
+private:
+    ClipBank() = default;
+
+    MappedFile file_;
+    const BankHeader* header_  = nullptr;
+    const BankEntry*  entries_ = nullptr;
+};
+
+#endif // UNAUDIO_CLIP_BANK_H
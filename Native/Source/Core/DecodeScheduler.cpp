@@ -0,0 +1,365 @@
+#include "DecodeScheduler.h"
+#include "ZoneTrace.h"
+#include "../Decoder/AudioDecoder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// Backstop for a wake-up that lands between a worker's last look at the
+// queues and its wait (notify is sent without the lock).
+constexpr auto kIdleWait = std::chrono::milliseconds(1);
+
+// Shortest ring, for engines configured with tiny or unknown block sizes.
+constexpr int kMinAheadFrames = 256;
+
+// Frames a worker decodes per hold of the stream lock.  Short, so the mixing
+// thread rarely finds the decoder taken when a ring runs dry, and never
+// waits long for it when it does.
+constexpr int64_t kFillChunkFrames = 128;
+
+// Longest the mixing thread waits for a worker's chunk in flight.  A chunk
+// decodes in microseconds; a worker still holding the decoder after this
+// was preempted, and the read comes up short instead.
+constexpr auto kChunkWait = std::chrono::milliseconds(1);
+
+} // namespace
+
+// ── Job queues ───────────────────────────────────────────────────
+
+/// Bounded queue of slot indices: the push and steal halves of a Chase-Lev
+/// deque.  The mixing thread pushes at the bottom; workers, the home worker
+/// included, take from the top (there is no owner pop).  Every slot is
+/// queued at most once, so kMaxStreams entries never overflow.
+struct DecodeScheduler::Queue {
+    static constexpr int64_t kCapacity = kMaxStreams;
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<int32_t> items[kCapacity];
+
+    bool Push(int32_t slot) {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= kCapacity) return false;
+        items[b & (kCapacity - 1)].store(slot, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Steal(int32_t& slot) {
+        for (;;) {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) return false;
+            slot = items[t & (kCapacity - 1)].load(std::memory_order_relaxed);
+            if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed))
+                return true;
+            // Another worker took it; look again.
+        }
+    }
+};
+
+// ── DecodeStream ─────────────────────────────────────────────────
+
+void DecodeStream::Attach(DecodeScheduler& scheduler, AudioDecoder* decoder, int channels) {
+    Detach();
+    if (!decoder || channels <= 0) return;
+
+    scheduler_ = &scheduler;
+    decoder_ = decoder;
+    channels_ = channels;
+    capacity_ = scheduler.GetAheadFrames();
+    const size_t samples = static_cast<size_t>(capacity_) * channels;
+    if (ring_.size() != samples) ring_.assign(samples, 0.0f);
+    written_.store(0, std::memory_order_relaxed);
+    read_.store(0, std::memory_order_relaxed);
+    ended_.store(false, std::memory_order_relaxed);
+    primed_.store(false, std::memory_order_relaxed);
+    busy_.store(false, std::memory_order_relaxed);
+    seekTo_.store(-1, std::memory_order_relaxed);
+    stalled_ = false;
+
+    // Publishing the slot orders the setup above before any worker's Fill().
+    slot_ = scheduler.Add(this);
+    attached_.store(slot_ >= 0, std::memory_order_release);
+}
+
+void DecodeStream::Detach() {
+    if (slot_ < 0) return;
+    scheduler_->Remove(slot_);
+    slot_ = -1;
+    attached_.store(false, std::memory_order_relaxed);
+    primed_.store(false, std::memory_order_relaxed);
+}
+
+int DecodeStream::Drain(float* out, int frames) {
+    const int64_t r = read_.load(std::memory_order_relaxed);
+    const int64_t available = written_.load(std::memory_order_acquire) - r;
+    const int count = static_cast<int>(std::min<int64_t>(frames, available));
+    if (count <= 0) return 0;
+
+    // At most two runs: up to the end of the ring, then from its start.
+    const int64_t offset = r & (capacity_ - 1);
+    const int first = static_cast<int>(std::min<int64_t>(count, capacity_ - offset));
+    std::memcpy(out, ring_.data() + offset * channels_,
+                static_cast<size_t>(first) * channels_ * sizeof(float));
+    if (count > first)
+        std::memcpy(out + static_cast<size_t>(first) * channels_, ring_.data(),
+                    static_cast<size_t>(count - first) * channels_ * sizeof(float));
+    read_.store(r + count, std::memory_order_release);
+    return count;
+}
+
+bool DecodeStream::LockForRead() {
+    if (TryLock()) return true;
+    // Yielding lets the worker finish its chunk even on a single core.
+    const auto deadline = std::chrono::steady_clock::now() + kChunkWait;
+    do {
+        std::this_thread::yield();
+        if (TryLock()) return true;
+    } while (std::chrono::steady_clock::now() < deadline);
+    return false;
+}
+
+int DecodeStream::Read(float* out, int frames) {
+    stalled_ = false;
+    int done = 0;
+    // A pending seek makes the ring stale: nothing is drained until it ran.
+    if (seekTo_.load(std::memory_order_acquire) < 0) {
+        done = Drain(out, frames);
+        if (done == frames) return done;
+        if (ended_.load(std::memory_order_acquire))
+            return done + Drain(out + static_cast<size_t>(done) * channels_, frames - done);
+    }
+
+    // Ran dry: decode the rest of the block here, once a worker holding the
+    // decoder has finished its chunk.  The frames it is decoding land in the
+    // ring and are drained below.
+    float* rest = out + static_cast<size_t>(done) * channels_;
+    if (!LockForRead()) {
+        stalled_ = true;
+        scheduler_->dropouts_.fetch_add(1, std::memory_order_relaxed);
+        return done;
+    }
+    const bool primed = primed_.load(std::memory_order_relaxed);
+    ApplySeekLocked();
+    const int drained = Drain(rest, frames - done);
+    done += drained;
+    rest += static_cast<size_t>(drained) * channels_;
+    if (done < frames && !ended_.load(std::memory_order_relaxed)) {
+        const int decoded = decoder_->Decode(rest, frames - done);
+        if (decoded > 0) {
+            done += decoded;
+            scheduler_->inlineDecoded_.fetch_add(decoded, std::memory_order_relaxed);
+            // Before the first Prime() no worker could have been ahead.
+            if (primed) scheduler_->fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    Unlock();
+    return done;
+}
+
+void DecodeStream::Reposition(int64_t frame) {
+    seekTo_.store(frame, std::memory_order_release);
+    if (TryLock()) {
+        ApplySeekLocked();
+        Unlock();
+    } else {
+        Request();   // the worker applies it at its next chunk, or the next Read does
+    }
+}
+
+void DecodeStream::ApplySeekLocked() {
+    // Lock holder only.  The mixing thread does not drain while a seek is
+    // pending, so read_ holds still and the ring restarts from it.
+    int64_t frame = seekTo_.load(std::memory_order_acquire);
+    while (frame >= 0) {
+        decoder_->Seek(frame);
+        written_.store(read_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        ended_.store(false, std::memory_order_relaxed);
+        primed_.store(true, std::memory_order_relaxed);
+        // A newer Reposition() may have landed meanwhile: seek again.
+        if (seekTo_.compare_exchange_strong(frame, -1, std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+            break;
+    }
+}
+
+void DecodeStream::Request() {
+    if (!primed_.load(std::memory_order_relaxed)) return;
+    if (seekTo_.load(std::memory_order_relaxed) < 0) {
+        if (ended_.load(std::memory_order_relaxed)) return;
+        if (written_.load(std::memory_order_relaxed) - read_.load(std::memory_order_relaxed) >=
+            capacity_)
+            return;
+    }
+    scheduler_->Request(slot_);
+}
+
+int DecodeStream::Fill() {
+    if (!primed_.load(std::memory_order_acquire)) return 0;
+    UNAUDIO_ZONE("Decode Ahead");
+
+    int total = 0;
+    // The lock is dropped between chunks so a mixing thread whose ring ran
+    // dry can take the decoder; if it did, this fill is over.
+    while (TryLock()) {
+        ApplySeekLocked();
+        const int decoded = FillChunkLocked();
+        Unlock();
+        if (decoded <= 0) break;
+        total += decoded;
+    }
+    return total;
+}
+
+int DecodeStream::FillChunkLocked() {
+    if (ended_.load(std::memory_order_relaxed)) return 0;
+    const int64_t w = written_.load(std::memory_order_relaxed);
+    const int64_t space = capacity_ - (w - read_.load(std::memory_order_acquire));
+    if (space <= 0) return 0;
+    const int64_t offset = w & (capacity_ - 1);
+    const int run = static_cast<int>(std::min({space, capacity_ - offset, kFillChunkFrames}));
+    const int decoded = decoder_->Decode(ring_.data() + offset * channels_, run);
+    if (decoded <= 0) {
+        ended_.store(true, std::memory_order_release);
+        return 0;
+    }
+    written_.store(w + decoded, std::memory_order_release);
+    return decoded;
+}
+
+// ── DecodeScheduler ──────────────────────────────────────────────
+
+int DecodeScheduler::DefaultWorkerCount() {
+    const int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(cores - 1, 1, kMaxWorkers);
+}
+
+DecodeScheduler::DecodeScheduler(int workerCount, int blockFrames)
+    : slots_(std::make_unique<Slot[]>(kMaxStreams)) {
+    int64_t frames = 1;
+    while (frames < std::max(2 * static_cast<int64_t>(blockFrames), int64_t{kMinAheadFrames}))
+        frames <<= 1;
+    aheadFrames_ = frames;
+
+    freeSlots_.reserve(kMaxStreams);
+    for (int32_t i = kMaxStreams - 1; i >= 0; --i) freeSlots_.push_back(i);
+
+    workerCount = std::clamp(workerCount, 1, kMaxWorkers);
+    for (int i = 0; i < workerCount; ++i) queues_.push_back(std::make_unique<Queue>());
+    workers_.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+        workers_.emplace_back(&DecodeScheduler::WorkerLoop, this, i);
+}
+
+DecodeScheduler::~DecodeScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+int32_t DecodeScheduler::Add(DecodeStream* stream) {
+    int32_t slot;
+    {
+        std::lock_guard<std::mutex> lock(slotMutex_);
+        if (freeSlots_.empty()) return -1;
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    slots_[slot].stream.store(stream, std::memory_order_seq_cst);
+    streamCount_.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+void DecodeScheduler::Remove(int32_t slot) {
+    // Pairs with Run(): either the worker sees the stream gone, or this sees
+    // the worker inside and waits it out.  A job still queued for the slot
+    // finds it empty, or filling whichever stream takes the slot next.
+    slots_[slot].stream.store(nullptr, std::memory_order_seq_cst);
+    while (slots_[slot].users.load(std::memory_order_seq_cst) > 0)
+        std::this_thread::yield();
+
+    streamCount_.fetch_sub(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    freeSlots_.push_back(slot);
+}
+
+void DecodeScheduler::Request(int32_t slot) {
+    // Mixing thread only: the producer side of every queue.
+    if (slots_[slot].queued.exchange(true, std::memory_order_acq_rel)) return;
+    if (!queues_[slot % queues_.size()]->Push(slot)) {
+        slots_[slot].queued.store(false, std::memory_order_relaxed);
+        return;
+    }
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_seq_cst) > 0 &&
+        !waking_.exchange(true, std::memory_order_acq_rel))
+        cv_.notify_one();
+}
+
+bool DecodeScheduler::Take(int home, int32_t& slot) {
+    const int count = static_cast<int>(queues_.size());
+    for (int i = 0; i < count; ++i) {
+        if (!queues_[(home + i) % count]->Steal(slot)) continue;
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        if (i > 0) steals_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void DecodeScheduler::Run(int32_t slot) {
+    Slot& s = slots_[slot];
+    // Cleared first, so a voice drained during the fill is queued again.
+    s.queued.store(false, std::memory_order_release);
+    s.users.fetch_add(1, std::memory_order_seq_cst);
+    if (DecodeStream* stream = s.stream.load(std::memory_order_seq_cst))
+        aheadDecoded_.fetch_add(stream->Fill(), std::memory_order_relaxed);
+    s.users.fetch_sub(1, std::memory_order_release);
+}
+
+void DecodeScheduler::WorkerLoop(int home) {
+    UNAUDIO_ZONE_THREAD("Decode worker");
+    for (;;) {
+        int32_t slot;
+        if (Take(home, slot)) {
+            Run(slot);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        cv_.wait_for(lock, kIdleWait, [this] {
+            return stopping_.load() || pending_.load(std::memory_order_seq_cst) > 0;
+        });
+        sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+        if (stopping_) return;
+        lock.unlock();
+
+        // Pass the wake-up on while there is more than this worker can take.
+        waking_.store(false, std::memory_order_release);
+        if (pending_.load(std::memory_order_relaxed) > 1 &&
+            sleeping_.load(std::memory_order_relaxed) > 0)
+            cv_.notify_one();
+    }
+}
+
+UNAudioDecodeStats DecodeScheduler::GetStats() const {
+    UNAudioDecodeStats stats{};
+    stats.workerCount  = static_cast<int32_t>(workers_.size());
+    stats.streamCount  = streamCount_.load(std::memory_order_relaxed);
+    stats.aheadFrames  = aheadDecoded_.load(std::memory_order_relaxed);
+    stats.inlineFrames = inlineDecoded_.load(std::memory_order_relaxed);
+    stats.fallbacks    = fallbacks_.load(std::memory_order_relaxed);
+    stats.dropouts     = dropouts_.load(std::memory_order_relaxed);
+    stats.steals       = steals_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,187 @@
+#ifndef UNAUDIO_DECODE_SCHEDULER_H
+#define UNAUDIO_DECODE_SCHEDULER_H
+
+#include "AudioTypes.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class AudioDecoder;
+class DecodeScheduler;
+
+/// Frames of one compressed voice decoded ahead of the mix.
+///
+/// A worker fills the ring from the voice's decoder; the mixing thread drains
+/// it.  Whoever decodes holds the stream lock.  Workers fill in short chunks
+/// and drop the lock between them, so when the ring runs dry the mixing
+/// thread can take the decoder and decode the rest of the block itself,
+/// waiting at most for the chunk in flight.  Only a worker preempted while
+/// holding the decoder makes the read come up short (a dropout); the voice
+/// then keeps its position, so the audio resumes late rather than skipping.
+/// The ring holds the decoder's output from the last Reposition() on; the
+/// voice still owns its cursor, attack cache and looping.
+class DecodeStream {
+public:
+    DecodeStream() = default;
+    ~DecodeStream() { Detach(); }
+
+    DecodeStream(const DecodeStream&) = delete;
+    DecodeStream& operator=(const DecodeStream&) = delete;
+
+    // ── Engine thread, voice off the mix bus ──────────────────────
+
+    /// Start decoding ahead for decoder (channels wide).  Workers leave it
+    /// alone until the mixing thread positions the decoder and calls Prime()
+    /// or Flush().  Stays detached if the scheduler has no free slot.
+    void Attach(DecodeScheduler& scheduler, AudioDecoder* decoder, int channels);
+
+    /// Stop decoding ahead; waits for a worker that is filling the ring.
+    void Detach();
+
+    /// Ring memory, for the engine memory accounting.
+    size_t GetSize() const { return ring_.size() * sizeof(float); }
+
+    // ── Mixing thread ─────────────────────────────────────────────
+
+    bool IsAttached() const { return attached_.load(std::memory_order_acquire); }
+    bool IsPrimed() const { return primed_.load(std::memory_order_relaxed); }
+
+    /// The decoder is where the ring should continue: workers may fill it.
+    void Prime() { primed_.store(true, std::memory_order_release); }
+
+    /// Decode frames: first from the ring, then inline (counted as a
+    /// fallback) if the workers have not got far enough.  Returns fewer
+    /// frames at the end of the stream, or when a worker held the decoder
+    /// for longer than a chunk takes (counted as a dropout, and Stalled()
+    /// is true until the next Read); nothing is skipped either way.
+    int Read(float* out, int frames);
+
+    /// Whether the last Read() came up short because the decoder was busy.
+    bool Stalled() const { return stalled_; }
+
+    /// Seek the decoder to frame, drop the ring and resume decoding ahead
+    /// from there.  If a worker holds the decoder the seek is left to
+    /// whichever side takes it next.
+    void Reposition(int64_t frame);
+
+    /// Ask a worker to top the ring up (no-op if full or already queued).
+    void Request();
+
+    // ── Worker ────────────────────────────────────────────────────
+
+    /// Decode until the ring is full, a chunk at a time, stopping early if
+    /// the mixing thread takes the decoder between chunks.  Returns the
+    /// frames decoded.
+    int Fill();
+
+private:
+    int Drain(float* out, int frames);
+    int FillChunkLocked();
+    void ApplySeekLocked();
+    bool TryLock() { return !busy_.exchange(true, std::memory_order_acquire); }
+    bool LockForRead();
+    void Unlock() { busy_.store(false, std::memory_order_release); }
+
+    DecodeScheduler* scheduler_ = nullptr;
+    AudioDecoder* decoder_ = nullptr;
+    int32_t slot_ = -1;
+    int channels_ = 0;
+    int64_t capacity_ = 0;      // frames, power of two
+    std::vector<float> ring_;
+    bool stalled_ = false;      // mixing thread only
+
+    std::atomic<bool> attached_{false};
+    std::atomic<bool> primed_{false};
+    std::atomic<bool> busy_{false};     // decoder in use
+    std::atomic<bool> ended_{false};    // decoder returned nothing after written_
+    std::atomic<int64_t> written_{0};   // frames ever written (decoding side)
+    std::atomic<int64_t> read_{0};      // frames ever read (mixing thread)
+    std::atomic<int64_t> seekTo_{-1};   // Reposition() not yet applied (-1 = none)
+};
+
+/// Decode-ahead workers for compressed voices.
+///
+/// Each worker has a bounded job queue.  The mixing thread is the only
+/// producer: a voice that drained part of its ring is pushed onto its home
+/// queue (slot % workers), so a voice tends to stay on one core with its
+/// decoder state in cache.  Workers take from their own queue first and steal
+/// from the others when it is empty, so a few expensive voices do not pile up
+/// behind one thread.
+///
+/// The mixing thread never blocks on the scheduler: pushes are lock-free and
+/// a sleeping worker is woken at most once per burst, the woken worker waking
+/// the next.
+class DecodeScheduler {
+public:
+    /// Streams that can decode ahead at once; further voices decode inline.
+    static constexpr int32_t kMaxStreams = 4096;
+
+    /// Upper bound on worker threads.
+    static constexpr int kMaxWorkers = 16;
+
+    /// Workers used when none are configured: one per core, minus the core
+    /// the output callback runs on.
+    static int DefaultWorkerCount();
+
+    /// Start workerCount threads keeping two blocks of blockFrames decoded
+    /// ahead of each stream.
+    DecodeScheduler(int workerCount, int blockFrames);
+    ~DecodeScheduler();
+
+    DecodeScheduler(const DecodeScheduler&) = delete;
+    DecodeScheduler& operator=(const DecodeScheduler&) = delete;
+
+    /// Ring length per stream, in frames (a power of two).
+    int64_t GetAheadFrames() const { return aheadFrames_; }
+
+    /// Counters since construction.
+    UNAudioDecodeStats GetStats() const;
+
+private:
+    friend class DecodeStream;
+    struct Queue;
+
+    struct Slot {
+        std::atomic<DecodeStream*> stream{nullptr};
+        std::atomic<int32_t> users{0};       // workers inside the stream
+        std::atomic<bool> queued{false};     // a job for this slot is in a queue
+    };
+
+    int32_t Add(DecodeStream* stream);
+    void Remove(int32_t slot);
+    void Request(int32_t slot);
+
+    void WorkerLoop(int home);
+    bool Take(int home, int32_t& slot);
+    void Run(int32_t slot);
+
+    int64_t aheadFrames_;
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    // Slot allocation (engine thread)
+    std::mutex slotMutex_;
+    std::vector<int32_t> freeSlots_;
+    std::atomic<int32_t> streamCount_{0};
+
+    // Sleeping and waking
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<int32_t> pending_{0};     // jobs in all queues
+    std::atomic<int32_t> sleeping_{0};
+    std::atomic<bool> waking_{false};     // a wake-up is on its way
+    std::atomic<bool> stopping_{false};
+
+    // Counters
+    std::atomic<int64_t> aheadDecoded_{0};
+    std::atomic<int64_t> inlineDecoded_{0};
+    std::atomic<int64_t> fallbacks_{0};
+    std::atomic<int64_t> dropouts_{0};
+    std::atomic<int64_t> steals_{0};
+};
+
+#endif // UNAUDIO_DECODE_SCHEDULER_H
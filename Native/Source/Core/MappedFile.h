@@ -0,0 +1,32 @@
+#ifndef UNAUDIO_MAPPED_FILE_H
+#define UNAUDIO_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map the file at path (UTF-8).  Returns false if it cannot be opened or is empty.
+    bool Open(const char* path);
+    void Close();
+
+    const uint8_t* GetData() const { return data_; }
+    size_t GetSize() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* fileHandle_    = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+};
+
+#endif // UNAUDIO_MAPPED_FILE_H
@@ -0,0 +1,41 @@
+#ifndef UNAUDIO_THREAD_POOL_H
+#define UNAUDIO_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed-size worker pool for background engine work (clip loading, etc.).
+/// Jobs run in FIFO order. Queued jobs that have not started are discarded on
+/// destruction; running jobs finish before the destructor returns.
+class ThreadPool {
+public:
+    /// Create a pool with threadCount workers (0 = hardware core count).
+    /// name labels the workers in trace zones (a string literal).
+    explicit ThreadPool(unsigned threadCount = 0, const char* name = "Worker");
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Queue a job for execution on a worker thread.
+    void Submit(std::function<void()> job);
+
+    /// Number of worker threads.
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers_.size()); }
+
+private:
+    void WorkerLoop();
+
+    const char* name_;
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+#endif // UNAUDIO_THREAD_POOL_H
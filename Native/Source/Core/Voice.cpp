@@ -0,0 +1,122 @@
+#include "Voice.h"
+#include <algorithm>
+#include <cstring>
+
+int Voice::GetChannels() const {
+    return clip->IsLoaded() ? clip->clipInfo.channels : 0;
+}
+
+bool Voice::AcquireDecoder(int64_t attackFrames) {
+    WarmState s = warm.load(std::memory_order_acquire);
+    if (s == WarmState::Warming) return false;
+    if (s == WarmState::Cold && !warm.compare_exchange_strong(s, WarmState::Ready)) {
+        if (s == WarmState::Warming) return false;
+    }
+    if (decoderReadyFrame.load(std::memory_order_relaxed) != attackFrames) {
+        SeekDecoder(attackFrames);   // worker never ran: do it here
+        decoderReadyFrame = attackFrames;
+    }
+    return true;
+}
+
+int Voice::Decode(float* buffer, int frameCount) {
+    return stream.IsAttached() ? stream.Read(buffer, frameCount)
+                               : decoder->Decode(buffer, frameCount);
+}
+
+void Voice::SeekDecoder(int64_t frame) {
+    if (stream.IsAttached())
+        stream.Reposition(frame);
+    else
+        decoder->Seek(frame);
+}
+
+int Voice::Read(float* buffer, int frameCount) {
+    // Played before the load finished: hold the slot, start once loaded.
+    if (!clip->IsLoaded())
+        return state.load(std::memory_order_relaxed) == UNAUDIO_STATE_PLAYING ? frameCount : 0;
+    // Everything below counts in clip frames; the resampler pulls what it needs.
+    if (resampler.IsActive())
+        return resampler.Process(buffer, frameCount,
+                                 [this](float* dst, int frames) { return ReadClip(dst, frames); });
+    return ReadClip(buffer, frameCount);
+}
+
+int Voice::ReadClip(float* buffer, int frameCount) {
+    if (state.load(std::memory_order_relaxed) != UNAUDIO_STATE_PLAYING) return 0;
+    if (stopAfterFade.load(std::memory_order_relaxed) && gain.IsIdleAt(0.0f)) {
+        state = UNAUDIO_STATE_STOPPED;   // fade-out finished
+        return 0;
+    }
+
+    const int channels = clip->clipInfo.channels;
+    const int64_t attackFrames = attack ? attack->frames : 0;
+    if (restart.exchange(false)) {
+        position = 0;
+        if (decoder && attackFrames == 0) SeekDecoder(0);
+    }
+
+    int written = 0;
+    while (written < frameCount) {
+        float* dst = buffer + static_cast<size_t>(written) * channels;
+        const int wanted = frameCount - written;
+        int frames = 0;
+
+        if (position < attackFrames) {
+            frames = static_cast<int>(std::min<int64_t>(wanted, attackFrames - position));
+            std::memcpy(dst, attack->pcm.data() + static_cast<size_t>(position) * channels,
+                        static_cast<size_t>(frames) * channels * sizeof(float));
+        } else if (pcm) {
+            const int64_t total = static_cast<int64_t>(pcm->size() / channels);
+            frames = static_cast<int>(std::min<int64_t>(wanted, total - position));
+            if (frames > 0)
+                std::memcpy(dst, pcm->data() + static_cast<size_t>(position) * channels,
+                            static_cast<size_t>(frames) * channels * sizeof(float));
+        } else if (decoder) {
+            if (attackFrames > 0 && !AcquireDecoder(attackFrames)) {
+                // Worker still seeking: pad with silence and retry next block.
+                std::memset(dst, 0, static_cast<size_t>(wanted) * channels * sizeof(float));
+                return frameCount;
+            }
+            frames = Decode(dst, wanted);
+            if (stream.IsAttached() && stream.Stalled()) {
+                // A preempted worker holds the decoder: pad the rest of the
+                // block and carry on from the same frame in the next one.
+                std::memset(dst + static_cast<size_t>(frames) * channels, 0,
+                            static_cast<size_t>(wanted - frames) * channels * sizeof(float));
+                position += frames;
+                written = frameCount;
+                break;
+            }
+        }
+
+        if (frames <= 0) {
+            if (!loop.load(std::memory_order_relaxed) || position == 0) {
+                state = UNAUDIO_STATE_STOPPED;
+                break;
+            }
+            // Wrap: the cache covers [0, attackFrames), so the decoder resumes after it.
+            position = 0;
+            if (decoder) {
+                SeekDecoder(attackFrames);
+                decoderReadyFrame = attackFrames;
+            }
+            continue;
+        }
+
+        position += frames;
+        written += frames;
+    }
+
+    // Keep a worker a block or two ahead.  Behind an attack cache that can
+    // start as soon as the warm-up worker has positioned the decoder.
+    if (decoder && stream.IsAttached() &&
+        state.load(std::memory_order_relaxed) == UNAUDIO_STATE_PLAYING) {
+        if (!stream.IsPrimed() && attackFrames > 0 &&
+            warm.load(std::memory_order_acquire) == WarmState::Ready &&
+            decoderReadyFrame.load(std::memory_order_relaxed) == attackFrames)
+            stream.Prime();
+        stream.Request();
+    }
+    return written;
+}
@@ -0,0 +1,70 @@
+#ifndef UNAUDIO_VOICE_H
+#define UNAUDIO_VOICE_H
+
+#include "AudioClip.h"
+#include "DecodeScheduler.h"
+#include "../Mixer/AudioMixer.h"
+#include "../Mixer/Resampler.h"
+#include <atomic>
+#include <memory>
+
+/// One playback instance of an AudioClip: its own cursor, gain and decoder
+/// state.  Any number of voices may share a clip.
+struct Voice : MixerSource {
+    explicit Voice(int sampleRate = 48000) : meter(sampleRate) {}
+
+    /// Hand-over state of a decoder that plays behind an attack cache.
+    enum class WarmState : int32_t {
+        Cold,       // needs positioning after the cache
+        Warming,    // a worker is seeking it
+        Ready       // positioned at decoderReadyFrame
+    };
+
+    std::shared_ptr<AudioClip> clip;
+    std::shared_ptr<const AttackCache> attack;   // snapshot taken when playback starts
+    std::shared_ptr<const std::vector<float>> pcm;   // snapshot of clip->pcm, ditto
+
+    // Shared between the API and mixer threads
+    std::atomic<UNAudioState> state{UNAUDIO_STATE_STOPPED};
+    std::atomic<float> volume{1.0f};   // user level; fades ramp `gain` towards it
+    std::atomic<float> sendLevel{0.0f};   // reverb send; `send` glides towards it
+    std::atomic<bool> loop{false};
+    std::atomic<bool> stopAfterFade{false};
+    std::atomic<bool> restart{false};
+    std::atomic<WarmState> warm{WarmState::Cold};
+    std::atomic<int64_t> decoderReadyFrame{-1};
+
+    // Mixer thread only (or the warm-up worker while warm == Warming, or a
+    // decode-ahead worker holding the stream lock)
+    std::unique_ptr<AudioDecoder> decoder;
+    int64_t position = 0;
+
+    // Requests under the engine lock, evaluated per frame by the mixer
+    GainRamp gain;
+    GainRamp send{0.0f};
+
+    // Fed by the mixer, read from any thread; restarted by StartVoice
+    LevelMeter meter;
+
+    // Decoder output a worker produced ahead of the mixer (attached by the
+    // engine while the voice is off the mix bus; unused when not attached)
+    DecodeStream stream;
+
+    // Clip rate -> output rate; configured by the engine while the voice is
+    // off the mix bus (inactive when the rates match)
+    Resampler resampler;
+
+    int Read(float* buffer, int frameCount) override;
+    int GetChannels() const override;
+    GainRamp& GetGain() override { return gain; }
+    GainRamp* GetSend() override { return &send; }
+    LevelMeter* GetMeter() override { return &meter; }
+
+private:
+    int ReadClip(float* buffer, int frameCount);
+    bool AcquireDecoder(int64_t attackFrames);
+    int Decode(float* buffer, int frameCount);
+    void SeekDecoder(int64_t frame);
+};
+
+#endif // UNAUDIO_VOICE_H
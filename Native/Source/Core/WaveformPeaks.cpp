@@ -0,0 +1,270 @@
+#include "WaveformPeaks.h"
+#include "AudioClip.h"
+#include "ThreadPool.h"
+#include "ZoneTrace.h"
+#include "../Decoder/DecoderFactory.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+static_assert(sizeof(WaveformPeaks::PeakFileHeader) == 32, "PeakFileHeader layout changed");
+static_assert(sizeof(UNAudioPeakBin) == 12, "UNAudioPeakBin layout changed");
+
+namespace {
+
+constexpr char kMagic[4] = { 'U', 'N', 'W', 'P' };
+
+// Frames per parallel work item.  A multiple of the level-0 bin so bins never
+// straddle chunks.
+constexpr int64_t kChunkFrames = 4 * 65536;
+
+// Frames decoded per step inside a chunk of a compressed clip.
+constexpr int kDecodeFrames = 4096;
+
+// Fold count interleaved samples into one bin.  Independent lanes break the
+// min/max/sum dependency chains so the loop vectorises.
+UNAudioPeakBin Summarise(const float* samples, size_t count) {
+    constexpr int kLanes = 8;
+    float lo[kLanes], hi[kLanes], sq[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+        lo[l] = FLT_MAX;
+        hi[l] = -FLT_MAX;
+        sq[l] = 0.0f;
+    }
+
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (int l = 0; l < kLanes; ++l) {
+            const float s = samples[i + l];
+            lo[l] = s < lo[l] ? s : lo[l];
+            hi[l] = s > hi[l] ? s : hi[l];
+            sq[l] += s * s;
+        }
+    }
+    for (int l = 0; i < count; ++i, ++l) {
+        const float s = samples[i];
+        lo[l] = s < lo[l] ? s : lo[l];
+        hi[l] = s > hi[l] ? s : hi[l];
+        sq[l] += s * s;
+    }
+
+    UNAudioPeakBin bin{};
+    if (count == 0) return bin;
+    float sum = 0.0f;
+    bin.min = lo[0];
+    bin.max = hi[0];
+    for (int l = 0; l < kLanes; ++l) {
+        bin.min = std::min(bin.min, lo[l]);
+        bin.max = std::max(bin.max, hi[l]);
+        sum += sq[l];
+    }
+    bin.rms = std::sqrt(sum / static_cast<float>(count));
+    return bin;
+}
+
+// Level-0 bins for frames [first, first + frames) of a clip.
+void SummariseChunk(const AudioClip& clip, const std::vector<float>* pcm, int64_t first,
+                    int64_t frames, UNAudioPeakBin* out) {
+    const int64_t binFrames = WaveformPeaks::kBinFrames[0];
+    const size_t channels = static_cast<size_t>(clip.clipInfo.channels);
+
+    if (pcm) {
+        const float* base = pcm->data() + static_cast<size_t>(first) * channels;
+        for (int64_t f = 0; f < frames; f += binFrames) {
+            const int64_t n = std::min(binFrames, frames - f);
+            *out++ = Summarise(base + static_cast<size_t>(f) * channels,
+                               static_cast<size_t>(n) * channels);
+        }
+        return;
+    }
+
+    // Compressed: every chunk decodes its own range through a private decoder.
+    auto decoder = CreateDecoder(clip.format, clip.encoded, clip.encodedSize);
+    if (!decoder) return;
+    if (first > 0 && !decoder->Seek(first)) return;
+
+    std::vector<float> buffer(static_cast<size_t>(kDecodeFrames) * channels);
+    for (int64_t f = 0; f < frames;) {
+        // Fill the whole step so bin boundaries stay aligned to the chunk.
+        const int wanted = static_cast<int>(std::min<int64_t>(kDecodeFrames, frames - f));
+        int decoded = 0;
+        while (decoded < wanted) {
+            const int n = decoder->Decode(buffer.data() + static_cast<size_t>(decoded) * channels,
+                                          wanted - decoded);
+            if (n <= 0) break;
+            decoded += n;
+        }
+        if (decoded <= 0) break;
+        for (int b = 0; b < decoded; b += static_cast<int>(binFrames)) {
+            const int n = std::min(static_cast<int>(binFrames), decoded - b);
+            *out++ = Summarise(buffer.data() + static_cast<size_t>(b) * channels,
+                               static_cast<size_t>(n) * channels);
+        }
+        f += decoded;
+    }
+}
+
+int64_t BinCount(int64_t totalFrames, int64_t binFrames) {
+    return (totalFrames + binFrames - 1) / binFrames;
+}
+
+} // namespace
+
+// ── Building ─────────────────────────────────────────────────────
+
+std::shared_ptr<const WaveformPeaks> WaveformPeaks::Build(const AudioClip& clip,
+                                                          const std::vector<float>* pcm,
+                                                          ThreadPool* pool) {
+    UNAUDIO_ZONE("Build Peaks");
+    std::shared_ptr<WaveformPeaks> peaks(new WaveformPeaks());
+    const int channels = clip.clipInfo.channels;
+    int64_t totalFrames = clip.clipInfo.totalFrames;
+    if (pcm && channels > 0)
+        totalFrames = static_cast<int64_t>(pcm->size() / channels);
+    if (channels <= 0 || totalFrames <= 0) return peaks;
+
+    peaks->totalFrames_ = totalFrames;
+    peaks->levels_[0].resize(static_cast<size_t>(BinCount(totalFrames, kBinFrames[0])));
+
+    // Chunks are claimed from a shared counter by the pool workers and by
+    // this thread; jobs the pool never runs simply leave their chunks to us.
+    struct Work {
+        std::atomic<int64_t> next{0};
+        int64_t chunkCount = 0;
+        int64_t done = 0;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto work = std::make_shared<Work>();
+    work->chunkCount = BinCount(totalFrames, kChunkFrames);
+
+    UNAudioPeakBin* bins = peaks->levels_[0].data();
+    auto run = [work, &clip, pcm, bins, totalFrames] {
+        for (int64_t chunk; (chunk = work->next++) < work->chunkCount;) {
+            const int64_t first = chunk * kChunkFrames;
+            SummariseChunk(clip, pcm, first, std::min(kChunkFrames, totalFrames - first),
+                           bins + first / kBinFrames[0]);
+            std::lock_guard<std::mutex> lock(work->mutex);
+            if (++work->done == work->chunkCount) work->cv.notify_all();
+        }
+    };
+
+    if (pool && work->chunkCount > 1) {
+        const int64_t helpers = std::min<int64_t>(pool->GetThreadCount(), work->chunkCount - 1);
+        for (int64_t i = 0; i < helpers; ++i) pool->Submit(run);
+    }
+    run();
+
+    {
+        std::unique_lock<std::mutex> lock(work->mutex);
+        work->cv.wait(lock, [&] { return work->done == work->chunkCount; });
+    }
+
+    peaks->BuildUpperLevels();
+    return peaks;
+}
+
+void WaveformPeaks::BuildUpperLevels() {
+    // Each level folds whole bins of the one below; RMS combines as a
+    // frame-weighted mean of squares so partial tail bins count correctly.
+    for (int level = 1; level < kLevelCount; ++level) {
+        const std::vector<UNAudioPeakBin>& below = levels_[level - 1];
+        const int64_t ratio = kBinFrames[level] / kBinFrames[level - 1];
+        std::vector<UNAudioPeakBin>& bins = levels_[level];
+        bins.resize(static_cast<size_t>(BinCount(totalFrames_, kBinFrames[level])));
+
+        for (size_t b = 0; b < bins.size(); ++b) {
+            const int64_t firstChild = static_cast<int64_t>(b) * ratio;
+            const int64_t lastChild = std::min<int64_t>(firstChild + ratio,
+                                                        static_cast<int64_t>(below.size()));
+            UNAudioPeakBin bin{ FLT_MAX, -FLT_MAX, 0.0f };
+            double energy = 0.0;
+            int64_t frames = 0;
+            for (int64_t c = firstChild; c < lastChild; ++c) {
+                const UNAudioPeakBin& child = below[static_cast<size_t>(c)];
+                const int64_t childFrames = std::min(kBinFrames[level - 1],
+                                                     totalFrames_ - c * kBinFrames[level - 1]);
+                bin.min = std::min(bin.min, child.min);
+                bin.max = std::max(bin.max, child.max);
+                energy += static_cast<double>(child.rms) * child.rms * childFrames;
+                frames += childFrames;
+            }
+            bin.rms = frames > 0 ? static_cast<float>(std::sqrt(energy / frames)) : 0.0f;
+            bins[b] = bin;
+        }
+    }
+}
+
+// ── Queries ──────────────────────────────────────────────────────
+
+int64_t WaveformPeaks::GetBinCount(int level) const {
+    if (level < 0 || level >= kLevelCount) return 0;
+    return static_cast<int64_t>(levels_[level].size());
+}
+
+int64_t WaveformPeaks::GetBins(int level, int64_t start, int64_t count,
+                               UNAudioPeakBin* out) const {
+    const int64_t total = GetBinCount(level);
+    if (!out || start < 0 || start >= total || count <= 0) return 0;
+    count = std::min(count, total - start);
+    std::memcpy(out, levels_[level].data() + start,
+                static_cast<size_t>(count) * sizeof(UNAudioPeakBin));
+    return count;
+}
+
+// ── Sidecar ──────────────────────────────────────────────────────
+
+std::vector<uint8_t> WaveformPeaks::Serialize() const {
+    PeakFileHeader header{};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version     = kVersion;
+    header.totalFrames = totalFrames_;
+    header.levelCount  = kLevelCount;
+    for (int level = 0; level < kLevelCount; ++level)
+        header.binFrames[level] = static_cast<uint32_t>(kBinFrames[level]);
+
+    size_t size = sizeof(header);
+    for (const auto& bins : levels_) size += bins.size() * sizeof(UNAudioPeakBin);
+
+    std::vector<uint8_t> blob(size);
+    std::memcpy(blob.data(), &header, sizeof(header));
+    size_t offset = sizeof(header);
+    for (const auto& bins : levels_) {
+        const size_t bytes = bins.size() * sizeof(UNAudioPeakBin);
+        if (bytes) std::memcpy(blob.data() + offset, bins.data(), bytes);
+        offset += bytes;
+    }
+    return blob;
+}
+
+std::shared_ptr<const WaveformPeaks> WaveformPeaks::Deserialize(const uint8_t* data,
+                                                                size_t size) {
+    if (!data || size < sizeof(PeakFileHeader)) return nullptr;
+
+    PeakFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion ||
+        header.levelCount != kLevelCount || header.totalFrames < 0)
+        return nullptr;
+    for (int level = 0; level < kLevelCount; ++level)
+        if (header.binFrames[level] != kBinFrames[level]) return nullptr;
+
+    std::shared_ptr<WaveformPeaks> peaks(new WaveformPeaks());
+    peaks->totalFrames_ = header.totalFrames;
+
+    size_t offset = sizeof(header);
+    for (int level = 0; level < kLevelCount; ++level) {
+        const uint64_t count = static_cast<uint64_t>(BinCount(header.totalFrames, kBinFrames[level]));
+        if (count > (size - offset) / sizeof(UNAudioPeakBin)) return nullptr;
+        peaks->levels_[level].resize(static_cast<size_t>(count));
+        const size_t bytes = static_cast<size_t>(count) * sizeof(UNAudioPeakBin);
+        if (bytes) std::memcpy(peaks->levels_[level].data(), data + offset, bytes);
+        offset += bytes;
+    }
+    if (offset != size) return nullptr;
+    return peaks;
+}
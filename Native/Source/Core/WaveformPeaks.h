@@ -0,0 +1,63 @@
+#ifndef UNAUDIO_WAVEFORM_PEAKS_H
+#define UNAUDIO_WAVEFORM_PEAKS_H
+
+#include "AudioTypes.h"
+#include <memory>
+#include <vector>
+
+struct AudioClip;
+class ThreadPool;
+
+/// Mip-mapped min / max / RMS summary of a clip for waveform display.
+/// Each level covers the clip with bins of kBinFrames[level] frames; all
+/// channels are folded into one lane.
+///
+/// Sidecar layout (little-endian):
+///   PeakFileHeader | UNAudioPeakBin[bins of level 0] | ... | [bins of last level]
+class WaveformPeaks {
+public:
+    static constexpr uint32_t kVersion    = 1;
+    static constexpr int      kLevelCount = 3;
+    static constexpr int64_t  kBinFrames[kLevelCount] = { 256, 4096, 65536 };
+
+    struct PeakFileHeader {
+        char     magic[4];         // "UNWP"
+        uint32_t version;
+        int64_t  totalFrames;      // of the clip the summary was built from
+        uint32_t levelCount;
+        uint32_t binFrames[kLevelCount];
+    };
+
+    /// Summarise a loaded clip from `pcm` (the clip's decoded samples, which
+    /// the caller keeps alive) or, when null, by decoding.  Level-0 bins are
+    /// computed in parallel chunks on `pool` (each with a private decoder for
+    /// compressed clips); the calling thread works through chunks too, so a
+    /// null or shutting-down pool only costs parallelism.
+    static std::shared_ptr<const WaveformPeaks> Build(const AudioClip& clip,
+                                                      const std::vector<float>* pcm,
+                                                      ThreadPool* pool);
+
+    /// Parse a sidecar blob.  Returns nullptr if it is malformed.
+    static std::shared_ptr<const WaveformPeaks> Deserialize(const uint8_t* data, size_t size);
+
+    /// Sidecar blob for Deserialize.
+    std::vector<uint8_t> Serialize() const;
+
+    int64_t GetTotalFrames() const { return totalFrames_; }
+
+    /// Number of bins at `level` (0 if the level does not exist).
+    int64_t GetBinCount(int level) const;
+
+    /// Copy up to count bins starting at start; returns the number copied.
+    int64_t GetBins(int level, int64_t start, int64_t count, UNAudioPeakBin* out) const;
+
+private:
+    WaveformPeaks() = default;
+
+    void BuildUpperLevels();
+
+    int64_t totalFrames_ = 0;
+    std::vector<UNAudioPeakBin> levels_[kLevelCount];
+};
+
+#endif // UNAUDIO_WAVEFORM_PEAKS_H
@@ -0,0 +1,304 @@
+#include "ZoneTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <process.h>
+    #define UNAUDIO_GETPID _getpid
+#else
+    #include <unistd.h>
+    #define UNAUDIO_GETPID getpid
+#endif
+
+std::atomic<bool> ZoneTrace::active_{false};
+
+namespace {
+
+// Larger requests are clamped: 16M events is 384 MB per thread.
+constexpr uint32_t kMaxCapacity = 1u << 24;
+
+// Thread slots are preallocated so joining never locks or allocates; threads
+// beyond this many record nothing.
+constexpr size_t kMaxThreads = 128;
+
+// Rings Start() gives to free slots, for threads that join mid-capture.
+constexpr size_t kSpareRings = 2;
+
+/// One finished zone.  Fields are atomics because Dump() may read a slot the
+/// owning thread is overwriting; such slots are detected and skipped.
+struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> begin{0};
+    std::atomic<uint64_t> end{0};
+};
+
+struct EventCopy {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+/// Storage of one ring; the capacity travels with the events so a reader
+/// never pairs one ring's capacity with another's array.
+struct Ring {
+    explicit Ring(uint32_t size) : capacity(size), events(std::make_unique<Event[]>(size)) {}
+    const uint32_t capacity;                 // power of two
+    std::unique_ptr<Event[]> events;
+};
+
+/// Ring of one thread.  Only the owning thread writes events, head and
+/// capture; the ring itself is replaced under the registry lock, off the
+/// owning thread (see Resize).
+struct ThreadBuffer {
+    std::atomic<Ring*> ring{nullptr};        // null until Start() sizes it
+    std::unique_ptr<Ring> storage;           // owns *ring (registry lock)
+    std::atomic<bool> writing{false};        // owner is inside Record()
+    int32_t track = 0;                       // "tid" in the JSON
+    std::atomic<uint64_t> head{0};           // events ever written this capture
+    std::atomic<uint32_t> capture{0};        // capture the events belong to
+    std::atomic<const char*> name{nullptr};
+    std::atomic<bool> owned{false};          // claimed by a live thread
+};
+
+struct Registry {
+    Registry() {
+        for (size_t i = 0; i < kMaxThreads; ++i) buffers[i].track = static_cast<int32_t>(i + 1);
+    }
+
+    std::mutex mutex;                        // Start() and Dump()
+    ThreadBuffer buffers[kMaxThreads];
+    uint32_t capacity = ZoneTrace::kDefaultCapacity;
+    std::atomic<uint32_t> capture{0};        // 0 = never started
+};
+
+// Never destroyed: threads may still record or exit during static teardown.
+Registry& GetRegistry() {
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+// Built before main, so no recording thread runs its constructor.
+const bool g_registryBuilt = (GetRegistry(), true);
+
+/// The calling thread's view of its ring.
+struct ThreadSlot {
+    ThreadBuffer* buffer = nullptr;
+    const char* name = nullptr;
+    bool full = false;                       // every slot was taken; stop trying
+
+    ~ThreadSlot() {
+        // Hand the ring back; its events stay dumpable until the next capture.
+        if (buffer) buffer->owned.store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+/// Give buffer a ring of capacity events.  Registry lock held.
+void Resize(ThreadBuffer& buffer, uint32_t capacity) {
+    if (buffer.storage && buffer.storage->capacity == capacity) return;
+    auto next = std::make_unique<Ring>(capacity);
+    buffer.ring.store(next.get(), std::memory_order_seq_cst);
+    // Pairs with Record(): the owner either picks up the new ring, or is
+    // still writing into the old one and is waited out before it is freed.
+    while (buffer.writing.load(std::memory_order_seq_cst)) std::this_thread::yield();
+    buffer.storage = std::move(next);
+}
+
+/// Claim a free slot for the calling thread (once per thread).  Lock-free and
+/// allocation-free, so the audio thread may join mid-capture: a slot that
+/// already has a ring (a spare, or one an exited thread left) records at
+/// once, any other stays silent until the next Start() sizes it.
+ThreadBuffer* Register(ThreadSlot& slot) {
+    if (slot.full) return nullptr;
+    Registry& registry = GetRegistry();
+    const uint32_t capture = registry.capture.load(std::memory_order_acquire);
+
+    for (const bool withRing : { true, false }) {
+        for (ThreadBuffer& candidate : registry.buffers) {
+            if (candidate.owned.load(std::memory_order_relaxed)) continue;
+            if ((candidate.ring.load(std::memory_order_relaxed) != nullptr) != withRing) continue;
+            // Keep the events of an exited thread until the capture ends.
+            if (capture != 0 && candidate.capture.load(std::memory_order_relaxed) == capture)
+                continue;
+            bool expected = false;
+            if (!candidate.owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                continue;
+            candidate.name.store(slot.name, std::memory_order_relaxed);
+            slot.buffer = &candidate;
+            return slot.buffer;
+        }
+    }
+    slot.full = true;
+    return nullptr;
+}
+
+/// Write s as the body of a JSON string.
+void WriteEscaped(FILE* file, const char* s) {
+    for (; *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') std::fprintf(file, "\\%c", c);
+        else if (c < 0x20) std::fprintf(file, "\\u%04x", c);
+        else std::fputc(c, file);
+    }
+}
+
+} // namespace
+
+void ZoneTrace::Start(uint32_t capacity) {
+    if (capacity == 0) capacity = kDefaultCapacity;
+    uint32_t rounded = 1;
+    while (rounded < capacity && rounded < kMaxCapacity) rounded <<= 1;
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.capacity = rounded;
+    // Rings are allocated here, not by the recording threads: one per live
+    // thread, and a few spares for threads that join during the capture.
+    size_t spares = 0;
+    for (ThreadBuffer& buffer : registry.buffers) {
+        if (!buffer.owned.load(std::memory_order_acquire)) {
+            if (spares == kSpareRings) continue;
+            ++spares;
+        }
+        Resize(buffer, rounded);
+    }
+    // A new capture number makes every thread reset its ring.
+    registry.capture.fetch_add(1, std::memory_order_release);
+    active_.store(true, std::memory_order_relaxed);
+}
+
+void ZoneTrace::Stop() {
+    active_.store(false, std::memory_order_relaxed);
+}
+
+void ZoneTrace::SetThreadName(const char* name) {
+    ThreadSlot& slot = t_slot;
+    if (slot.name == name && (slot.buffer || slot.full)) return;
+    slot.name = name;
+    if (slot.buffer)
+        slot.buffer->name.store(name, std::memory_order_relaxed);
+    else
+        Register(slot);
+}
+
+uint64_t ZoneTrace::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void ZoneTrace::Record(const char* name, uint64_t begin, uint64_t end) {
+    ThreadSlot& slot = t_slot;
+    const uint32_t capture = GetRegistry().capture.load(std::memory_order_acquire);
+    if (capture == 0) return;
+    // Threads that never named themselves register on their first event.
+    ThreadBuffer* buffer = slot.buffer ? slot.buffer : Register(slot);
+    if (!buffer) return;
+
+    // Announced before the ring is looked up, so Start() never frees it
+    // under this write (see Resize).
+    buffer->writing.store(true, std::memory_order_seq_cst);
+    if (const Ring* ring = buffer->ring.load(std::memory_order_seq_cst)) {
+        if (buffer->capture.load(std::memory_order_relaxed) != capture) {
+            // First event of this capture: start the ring over.
+            buffer->head.store(0, std::memory_order_relaxed);
+            buffer->capture.store(capture, std::memory_order_release);
+        }
+        const uint64_t h = buffer->head.load(std::memory_order_relaxed);
+        // Orders the previous head store before this overwrite, so a reader
+        // that sees a torn slot also sees the head that invalidates it.
+        std::atomic_thread_fence(std::memory_order_release);
+        Event& event = ring->events[h & (ring->capacity - 1)];
+        event.name.store(name, std::memory_order_relaxed);
+        event.begin.store(begin, std::memory_order_relaxed);
+        event.end.store(end, std::memory_order_relaxed);
+        buffer->head.store(h + 1, std::memory_order_release);
+    }
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+int64_t ZoneTrace::Dump(const char* path) {
+    if (!path) return -1;
+
+    // Copy the events under the lock and write the file after releasing it,
+    // so Start() and registering threads do not wait on file I/O.
+    struct Track {
+        int32_t id;
+        const char* name;
+        std::vector<EventCopy> events;
+    };
+    std::vector<Track> tracks;
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const uint32_t capture = registry.capture.load(std::memory_order_relaxed);
+
+        std::vector<EventCopy> copy;
+        for (ThreadBuffer& buffer : registry.buffers) {
+            if (capture == 0 || buffer.capture.load(std::memory_order_acquire) != capture)
+                continue;
+            const Ring* ring = buffer.ring.load(std::memory_order_acquire);
+            if (!ring) continue;
+
+            // Copy the newest events, then drop any the owner may have been
+            // overwriting meanwhile: everything at or below head - capacity.
+            const uint64_t capacity = ring->capacity;
+            const uint64_t head = buffer.head.load(std::memory_order_acquire);
+            const uint64_t first = head > capacity ? head - capacity : 0;
+            copy.resize(static_cast<size_t>(head - first));
+            for (uint64_t i = first; i < head; ++i) {
+                const Event& event = ring->events[i & (capacity - 1)];
+                copy[static_cast<size_t>(i - first)] = {event.name.load(std::memory_order_relaxed),
+                                                        event.begin.load(std::memory_order_relaxed),
+                                                        event.end.load(std::memory_order_relaxed)};
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t after = buffer.head.load(std::memory_order_relaxed);
+            const uint64_t valid = after >= capacity ? after - capacity + 1 : 0;
+
+            Track track{buffer.track, buffer.name.load(std::memory_order_relaxed), {}};
+            for (uint64_t i = std::max(first, valid); i < head; ++i) {
+                const EventCopy& event = copy[static_cast<size_t>(i - first)];
+                if (event.name && event.end >= event.begin) track.events.push_back(event);
+            }
+            tracks.push_back(std::move(track));
+        }
+    }
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return -1;
+    const int pid = static_cast<int>(UNAUDIO_GETPID());
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+                       "\"args\":{\"name\":\"UNAudio\"}}", pid);
+
+    int64_t written = 0;
+    for (const Track& track : tracks) {
+        std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                           "\"args\":{\"name\":\"", pid, track.id);
+        if (track.name)
+            WriteEscaped(file, track.name);
+        else
+            std::fprintf(file, "Thread %d", track.id);
+        std::fprintf(file, "\"}}");
+
+        for (const EventCopy& event : track.events) {
+            std::fprintf(file, ",\n{\"name\":\"");
+            WriteEscaped(file, event.name);
+            std::fprintf(file, "\",\"cat\":\"unaudio\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                               "\"ts\":%.3f,\"dur\":%.3f}",
+                         pid, track.id, event.begin / 1000.0, (event.end - event.begin) / 1000.0);
+            ++written;
+        }
+    }
+
+    std::fprintf(file, "\n]}\n");
+    const bool ok = std::fclose(file) == 0;
+    return ok ? written : -1;
+}
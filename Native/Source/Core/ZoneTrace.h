@@ -0,0 +1,92 @@
+#ifndef UNAUDIO_ZONE_TRACE_H
+#define UNAUDIO_ZONE_TRACE_H
+
+#include "AudioTypes.h"
+#include <atomic>
+#include <cstdint>
+
+// Zones are compiled in only when the build defines UNAUDIO_ZONES=1 (CMake
+// option UNAUDIO_ZONES); otherwise the macros below expand to nothing.
+#ifndef UNAUDIO_ZONES
+#define UNAUDIO_ZONES 0
+#endif
+
+/// Timeline of the engine's hot paths (render, mix, decode, output) for
+/// chrome://tracing or Perfetto.
+///
+/// UNAUDIO_ZONE("name") times the rest of the enclosing scope.  While a
+/// capture runs, every zone appends one event (name, begin, end) to a ring
+/// owned by the calling thread: no locks, no allocation and no shared cache
+/// lines on the audio thread.  Outside a capture a zone costs one relaxed
+/// load.  Start() allocates the rings; a thread joins once, when it names
+/// itself (or at its first event if it never does), by claiming one of a
+/// fixed set of slots without locking.  A thread that joins mid-capture
+/// records into a spare ring Start() set aside, or from the next Start().
+///
+/// Each ring keeps the newest events of its thread.  Dump() writes them all
+/// as Chrome trace-event JSON, one track per thread, with timestamps on the
+/// steady clock.  Unlike CallTrace, which logs API calls for replay, this
+/// records where the time inside the engine went.
+class ZoneTrace {
+public:
+    /// Events kept per thread when Start() is given 0.
+    static constexpr uint32_t kDefaultCapacity = 65536;
+
+    static bool IsActive() { return active_.load(std::memory_order_relaxed); }
+
+    /// Start a capture keeping the newest `capacity` events per thread
+    /// (0 = default).  Events of an earlier capture are dropped.
+    static void Start(uint32_t capacity);
+
+    /// Stop capturing.  The events stay available to Dump().
+    static void Stop();
+
+    /// Write the events of the current (or last) capture to path.  Returns
+    /// the number of events, or -1 if the file cannot be written.
+    static int64_t Dump(const char* path);
+
+    /// Label the calling thread's track and register the thread (lock-free,
+    /// safe on the audio thread).  name must outlive the process (a
+    /// string literal).  Cheap to repeat: unchanged names are skipped.
+    static void SetThreadName(const char* name);
+
+    /// Steady clock in nanoseconds.
+    static uint64_t Now();
+
+    /// Append a finished zone to the calling thread's ring.
+    static void Record(const char* name, uint64_t begin, uint64_t end);
+
+    /// Records its own lifetime (see UNAUDIO_ZONE).
+    class Scope {
+    public:
+        explicit Scope(const char* name)
+            : name_(IsActive() ? name : nullptr), begin_(name_ ? Now() : 0) {}
+        ~Scope() {
+            if (name_) Record(name_, begin_, Now());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name_;
+        uint64_t begin_;
+    };
+
+private:
+    static std::atomic<bool> active_;
+};
+
+#if UNAUDIO_ZONES
+#define UNAUDIO_ZONE_JOIN_(a, b) a##b
+#define UNAUDIO_ZONE_JOIN(a, b) UNAUDIO_ZONE_JOIN_(a, b)
+/// Time the rest of the enclosing scope as `name` (a string literal).
+#define UNAUDIO_ZONE(name) ZoneTrace::Scope UNAUDIO_ZONE_JOIN(unaudioZone_, __LINE__)(name)
+/// Name the calling thread's track (a string literal).
+#define UNAUDIO_ZONE_THREAD(name) ZoneTrace::SetThreadName(name)
+#else
+#define UNAUDIO_ZONE(name) ((void)0)
+#define UNAUDIO_ZONE_THREAD(name) ((void)0)
+#endif
+
+#endif // UNAUDIO_ZONE_TRACE_H
@@ -0,0 +1,149 @@
+#include "ADPCMCodec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace adpcm {
+namespace {
+
+constexpr char     kMagic[4] = { 'U', 'N', 'A', 'P' };
+constexpr uint16_t kVersion  = 1;
+
+const int16_t kStepTable[89] = {
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+const int8_t kIndexTable[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+struct ChannelState {
+    int predictor = 0;
+    int index     = 0;
+};
+
+inline int Clamp16(int v) { return std::min(32767, std::max(-32768, v)); }
+
+// Float sample to 16-bit.  Clamped as a float first: converting NaN, infinity
+// or anything outside the int range to int is undefined.
+inline int ToSample16(float f) {
+    if (f != f) return 0;   // NaN
+    f = std::min(1.0f, std::max(-1.0f, f));
+    return static_cast<int>(f * 32767.0f + (f >= 0.0f ? 0.5f : -0.5f));
+}
+
+// One decoder step; shared by the encoder so both sides track identical state.
+inline int Step(ChannelState& s, int nibble) {
+    const int step = kStepTable[s.index];
+    int diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+    s.predictor = Clamp16((nibble & 8) ? s.predictor - diff : s.predictor + diff);
+    s.index = std::min(88, std::max(0, s.index + kIndexTable[nibble]));
+    return s.predictor;
+}
+
+inline int Quantize(const ChannelState& s, int sample) {
+    const int step = kStepTable[s.index];
+    int delta  = sample - s.predictor;
+    int nibble = 0;
+    if (delta < 0) { nibble = 8; delta = -delta; }
+    if (delta >= step)        { nibble |= 4; delta -= step; }
+    if (delta >= step >> 1)   { nibble |= 2; delta -= step >> 1; }
+    if (delta >= step >> 2)   { nibble |= 1; }
+    return nibble;
+}
+
+} // namespace
+
+bool IsADPCM(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(ADPCMHeader)) return false;
+    ADPCMHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return std::memcmp(header.magic, kMagic, 4) == 0 && header.version == kVersion &&
+           header.framesPerBlock == kFramesPerBlock &&
+           header.channels > 0 && header.channels <= kMaxChannels &&
+           size >= sizeof(ADPCMHeader) + header.blockCount * BlockBytes(header.channels);
+}
+
+bool Encode(const float* pcm, int64_t frames, int channels, int sampleRate,
+            std::vector<uint8_t>& out) {
+    if (!pcm || frames <= 0 || channels <= 0 || channels > kMaxChannels) return false;
+
+    const int64_t blockCount = (frames + kFramesPerBlock - 1) / kFramesPerBlock;
+    const size_t blockBytes = BlockBytes(channels);
+
+    ADPCMHeader header{};
+    std::memcpy(header.magic, kMagic, 4);
+    header.version        = kVersion;
+    header.channels       = static_cast<uint16_t>(channels);
+    header.sampleRate     = static_cast<uint32_t>(sampleRate);
+    header.framesPerBlock = kFramesPerBlock;
+    header.totalFrames    = static_cast<uint64_t>(frames);
+    header.blockCount     = static_cast<uint32_t>(blockCount);
+
+    out.assign(sizeof(header) + static_cast<size_t>(blockCount) * blockBytes, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    ChannelState state[kMaxChannels];
+    for (int64_t b = 0; b < blockCount; ++b) {
+        uint8_t* block = out.data() + sizeof(header) + static_cast<size_t>(b) * blockBytes;
+        const int64_t first = b * kFramesPerBlock;
+        const int count = static_cast<int>(std::min<int64_t>(kFramesPerBlock, frames - first));
+
+        for (int c = 0; c < channels; ++c) {
+            uint8_t* chan = block + static_cast<size_t>(c) * kChannelBytes;
+            ChannelState& s = state[c];
+
+            // Block header carries the running state so blocks decode independently.
+            const int16_t predictor = static_cast<int16_t>(s.predictor);
+            std::memcpy(chan, &predictor, sizeof(predictor));
+            chan[2] = static_cast<uint8_t>(s.index);
+
+            uint8_t* nibbles = chan + kChannelHeader;
+            for (int i = 0; i < count; ++i) {
+                int sample = ToSample16(pcm[static_cast<size_t>(first + i) * channels + c]);
+                int nibble = Quantize(s, sample);
+                Step(s, nibble);
+                nibbles[i >> 1] |= static_cast<uint8_t>(nibble << ((i & 1) * 4));
+            }
+        }
+    }
+    return true;
+}
+
+void DecodeBlock(const uint8_t* block, int channels, int frameCount, float* out) {
+    ChannelState state[kMaxChannels];
+    const uint8_t* nibbles[kMaxChannels];
+    for (int c = 0; c < channels; ++c) {
+        const uint8_t* chan = block + static_cast<size_t>(c) * kChannelBytes;
+        int16_t predictor;
+        std::memcpy(&predictor, chan, sizeof(predictor));
+        state[c].predictor = predictor;
+        state[c].index     = std::min<int>(chan[2], 88);
+        nibbles[c] = chan + kChannelHeader;
+    }
+
+    // Channels advance in lockstep: the inner loop has no cross-channel
+    // dependency and writes interleaved output directly.
+    constexpr float kScale = 1.0f / 32768.0f;
+    for (int i = 0; i < frameCount; ++i) {
+        const int shift = (i & 1) * 4;
+        float* frame = out + static_cast<size_t>(i) * channels;
+        for (int c = 0; c < channels; ++c) {
+            const int nibble = (nibbles[c][i >> 1] >> shift) & 0x0F;
+            frame[c] = static_cast<float>(Step(state[c], nibble)) * kScale;
+        }
+    }
+}
+
+} // namespace adpcm
@@ -0,0 +1,49 @@
+#ifndef UNAUDIO_ADPCM_CODEC_H
+#define UNAUDIO_ADPCM_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Block-based 4-bit IMA ADPCM used by UNAUDIO_ADPCM_IN_MEMORY (~4:1 vs 16-bit).
+///
+/// Container layout (little-endian):
+///   ADPCMHeader | block[blockCount]
+/// Each block holds kADPCMFramesPerBlock frames.  Within a block every channel
+/// is stored contiguously (planar) as a 4-byte state header followed by
+/// kADPCMFramesPerBlock / 2 bytes of nibbles, so any block decodes on its own
+/// and all channels can be decoded in lockstep.
+namespace adpcm {
+
+constexpr int kFramesPerBlock  = 256;
+constexpr int kChannelHeader   = 4;   // int16 predictor, uint8 step index, uint8 reserved
+constexpr int kChannelBytes    = kChannelHeader + kFramesPerBlock / 2;
+constexpr int kMaxChannels     = 8;
+
+struct ADPCMHeader {
+    char     magic[4];        // "UNAP"
+    uint16_t version;
+    uint16_t channels;
+    uint32_t sampleRate;
+    uint32_t framesPerBlock;
+    uint64_t totalFrames;
+    uint32_t blockCount;
+    uint32_t reserved;
+};
+
+inline size_t BlockBytes(int channels) { return static_cast<size_t>(channels) * kChannelBytes; }
+
+/// Whether data starts with a valid ADPCM container header.
+bool IsADPCM(const uint8_t* data, size_t size);
+
+/// Encode interleaved float PCM into a new ADPCM container.
+bool Encode(const float* pcm, int64_t frames, int channels, int sampleRate,
+            std::vector<uint8_t>& out);
+
+/// Decode one block (all channels) into interleaved float.
+/// frameCount may be less than kFramesPerBlock for the final block.
+void DecodeBlock(const uint8_t* block, int channels, int frameCount, float* out);
+
+} // namespace adpcm
+
+#endif // UNAUDIO_ADPCM_CODEC_H
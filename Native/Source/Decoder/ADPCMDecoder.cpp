@@ -0,0 +1,77 @@
+#include "ADPCMDecoder.h"
+#include "../Core/ZoneTrace.h"
+#include <algorithm>
+#include <cstring>
+
+ADPCMDecoder::ADPCMDecoder()  = default;
+ADPCMDecoder::~ADPCMDecoder() = default;
+
+bool ADPCMDecoder::Open(const uint8_t* data, size_t size) {
+    if (!adpcm::IsADPCM(data, size)) return false;
+
+    adpcm::ADPCMHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    blocks_      = data + sizeof(header);
+    blockBytes_  = adpcm::BlockBytes(header.channels);
+    totalFrames_ = std::min<int64_t>(static_cast<int64_t>(header.totalFrames),
+                                     static_cast<int64_t>(header.blockCount) * adpcm::kFramesPerBlock);
+    currentFrame_ = 0;
+    cachedBlock_  = -1;
+
+    format_.sampleRate    = static_cast<int32_t>(header.sampleRate);
+    format_.channels      = header.channels;
+    format_.bitsPerSample = 32;    // float output
+    format_.blockAlign    = format_.channels * (format_.bitsPerSample / 8);
+    return true;
+}
+
+void ADPCMDecoder::LoadBlock(int64_t blockIndex) {
+    const int64_t first = blockIndex * adpcm::kFramesPerBlock;
+    const int count = static_cast<int>(std::min<int64_t>(adpcm::kFramesPerBlock, totalFrames_ - first));
+    adpcm::DecodeBlock(blocks_ + static_cast<size_t>(blockIndex) * blockBytes_,
+                       format_.channels, count, blockBuffer_);
+    cachedBlock_ = blockIndex;
+}
+
+int ADPCMDecoder::Decode(float* buffer, int frameCount) {
+    if (!blocks_ || frameCount <= 0) return 0;
+    UNAUDIO_ZONE("ADPCM Decode");
+
+    const int channels = format_.channels;
+    int written = 0;
+    while (written < frameCount && currentFrame_ < totalFrames_) {
+        const int64_t block = currentFrame_ / adpcm::kFramesPerBlock;
+        const int offset = static_cast<int>(currentFrame_ % adpcm::kFramesPerBlock);
+
+        // Whole aligned blocks decode straight into the caller's buffer.
+        const int64_t blockEnd = std::min<int64_t>((block + 1) * adpcm::kFramesPerBlock, totalFrames_);
+        const int available = static_cast<int>(blockEnd - currentFrame_);
+        const int frames = std::min(frameCount - written, available);
+        float* dst = buffer + static_cast<size_t>(written) * channels;
+
+        if (offset == 0 && frames == adpcm::kFramesPerBlock) {
+            adpcm::DecodeBlock(blocks_ + static_cast<size_t>(block) * blockBytes_,
+                               channels, frames, dst);
+        } else {
+            if (cachedBlock_ != block) LoadBlock(block);
+            std::memcpy(dst, blockBuffer_ + static_cast<size_t>(offset) * channels,
+                        static_cast<size_t>(frames) * channels * sizeof(float));
+        }
+
+        written += frames;
+        currentFrame_ += frames;
+    }
+    return written;
+}
+
+bool ADPCMDecoder::Seek(int64_t frame) {
+    if (frame < 0 || frame > totalFrames_) return false;
+    currentFrame_ = frame;
+    return true;
+}
+
+UNAudioFormat ADPCMDecoder::GetFormat()   const { return format_; }
+bool ADPCMDecoder::SupportsStreaming()     const { return true; }
+int64_t ADPCMDecoder::GetTotalFrames()    const { return totalFrames_; }
+size_t  ADPCMDecoder::GetStateSize()      const { return sizeof(*this); }
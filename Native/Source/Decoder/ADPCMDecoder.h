@@ -0,0 +1,36 @@
+#ifndef UNAUDIO_ADPCM_DECODER_H
+#define UNAUDIO_ADPCM_DECODER_H
+
+#include "AudioDecoder.h"
+#include "ADPCMCodec.h"
+
+/// Decoder for the UNAudio block ADPCM container (see ADPCMCodec.h).
+/// Seeks are O(1): the target block is decoded on its own.
+class ADPCMDecoder : public AudioDecoder {
+public:
+    ADPCMDecoder();
+    ~ADPCMDecoder() override;
+
+    bool Open(const uint8_t* data, size_t size) override;
+    int  Decode(float* buffer, int frameCount) override;
+    bool Seek(int64_t frame) override;
+    UNAudioFormat GetFormat() const override;
+    bool SupportsStreaming() const override;
+    int64_t GetTotalFrames() const override;
+    size_t GetStateSize() const override;
+
+private:
+    void LoadBlock(int64_t blockIndex);
+
+    UNAudioFormat format_{};
+    const uint8_t* blocks_ = nullptr;
+    size_t blockBytes_ = 0;
+    int64_t totalFrames_ = 0;
+    int64_t currentFrame_ = 0;
+
+    // Decoded copy of the block containing currentFrame_
+    float blockBuffer_[adpcm::kFramesPerBlock * adpcm::kMaxChannels];
+    int64_t cachedBlock_ = -1;
+};
+
+#endif // UNAUDIO_ADPCM_DECODER_H
@@ -28,6 +28,12 @@ public:
 
     /// Total number of frames in the audio clip (0 if unknown).
     virtual int64_t GetTotalFrames() const = 0;
+
+    /// Bytes of decoder state (tables, block buffers), fixed once opened.
+    /// Counted against the engine memory budget for every live voice.
+    /// State a codec library allocates behind an opaque handle is not
+    /// included: the libraries do not report it.
+    virtual size_t GetStateSize() const = 0;
 };
 
 #endif // UNAUDIO_AUDIO_DECODER_H
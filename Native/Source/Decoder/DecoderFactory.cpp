@@ -0,0 +1,47 @@
+#include "DecoderFactory.h"
+#include "ADPCMDecoder.h"
+#include "WAVDecoder.h"
+#include "MP3Decoder.h"
+#include "VorbisDecoder.h"
+#include "FLACDecoder.h"
+#include <cstring>
+
+AudioFileFormat DetectAudioFormat(const uint8_t* data, size_t size) {
+    if (!data || size < 4) return AudioFileFormat::Unknown;
+
+    if (size >= 12 && std::memcmp(data, "RIFF", 4) == 0 && std::memcmp(data + 8, "WAVE", 4) == 0)
+        return AudioFileFormat::WAV;
+    if (adpcm::IsADPCM(data, size))
+        return AudioFileFormat::ADPCM;
+    if (std::memcmp(data, "OggS", 4) == 0)
+        return AudioFileFormat::Vorbis;
+    if (std::memcmp(data, "fLaC", 4) == 0)
+        return AudioFileFormat::FLAC;
+    // ID3v2 tag, or a bare MPEG audio frame sync (11 set bits).
+    if (std::memcmp(data, "ID3", 3) == 0 || (data[0] == 0xFF && (data[1] & 0xE0) == 0xE0))
+        return AudioFileFormat::MP3;
+
+    return AudioFileFormat::Unknown;
+}
+
+std::unique_ptr<AudioDecoder> CreateDecoder(const uint8_t* data, size_t size) {
+    return CreateDecoder(DetectAudioFormat(data, size), data, size);
+}
+
+std::unique_ptr<AudioDecoder> CreateDecoder(AudioFileFormat format, const uint8_t* data,
+                                            size_t size) {
+    if (!data) return nullptr;
+    std::unique_ptr<AudioDecoder> decoder;
+    switch (format) {
+    case AudioFileFormat::WAV:    decoder = std::make_unique<WAVDecoder>();    break;
+    case AudioFileFormat::MP3:    decoder = std::make_unique<MP3Decoder>();    break;
+    case AudioFileFormat::Vorbis: decoder = std::make_unique<VorbisDecoder>(); break;
+    case AudioFileFormat::FLAC:   decoder = std::make_unique<FLACDecoder>();   break;
+    case AudioFileFormat::ADPCM:  decoder = std::make_unique<ADPCMDecoder>();  break;
+    case AudioFileFormat::Unknown: return nullptr;
+    default:                       return nullptr;
+    }
+
+    if (!decoder->Open(data, size)) return nullptr;
+    return decoder;
+}
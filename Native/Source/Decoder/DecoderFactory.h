@@ -0,0 +1,30 @@
+#ifndef UNAUDIO_DECODER_FACTORY_H
+#define UNAUDIO_DECODER_FACTORY_H
+
+#include "AudioDecoder.h"
+#include <memory>
+
+/// Container formats recognised by the decoder factory.
+enum class AudioFileFormat {
+    Unknown,
+    WAV,
+    MP3,
+    Vorbis,
+    FLAC,
+    ADPCM      // UNAudio block ADPCM container
+};
+
+/// Identify the container format from the leading bytes of the data.
+AudioFileFormat DetectAudioFormat(const uint8_t* data, size_t size);
+
+/// Create and open a decoder for the given data.
+/// Returns nullptr if the format is unknown or the decoder fails to open.
+/// The data must outlive the returned decoder.
+std::unique_ptr<AudioDecoder> CreateDecoder(const uint8_t* data, size_t size);
+
+/// Create and open a decoder for data already known to be in `format` (a
+/// bank index entry, or a clip sniffed once at load), skipping detection.
+std::unique_ptr<AudioDecoder> CreateDecoder(AudioFileFormat format, const uint8_t* data,
+                                            size_t size);
+
+#endif // UNAUDIO_DECODER_FACTORY_H
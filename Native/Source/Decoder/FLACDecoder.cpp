@@ -1,4 +1,6 @@
 #include "FLACDecoder.h"
+#include "../Core/ZoneTrace.h"
+#include <algorithm>
 #include <cstring>
 
 // TODO: #include <FLAC/stream_decoder.h>  – integrate libflac in a later phase
@@ -23,14 +25,20 @@ bool FLACDecoder::Open(const uint8_t* data, size_t size) {
 
 int FLACDecoder::Decode(float* buffer, int frameCount) {
     if (!data_) return 0;
+    UNAUDIO_ZONE("FLAC Decode");
     // TODO: Decode via libflac
+    // Stub: fill silence up to the clip length (0 until the header is parsed)
+    int64_t remaining = totalFrames_ - currentFrame_;
+    int frames = static_cast<int>(std::min<int64_t>(frameCount, remaining));
+    if (frames <= 0) return 0;
     std::memset(buffer, 0,
-                static_cast<size_t>(frameCount) * format_.channels * sizeof(float));
-    currentFrame_ += frameCount;
-    return frameCount;
+                static_cast<size_t>(frames) * format_.channels * sizeof(float));
+    currentFrame_ += frames;
+    return frames;
 }
 
 bool FLACDecoder::Seek(int64_t frame) {
+    UNAUDIO_ZONE("FLAC Seek");
     currentFrame_ = frame;
     return true;
 }
@@ -38,3 +46,4 @@ bool FLACDecoder::Seek(int64_t frame) {
 UNAudioFormat FLACDecoder::GetFormat()   const { return format_; }
 bool FLACDecoder::SupportsStreaming()     const { return true; }
 int64_t FLACDecoder::GetTotalFrames()    const { return totalFrames_; }
+size_t  FLACDecoder::GetStateSize()      const { return sizeof(*this); }
@@ -1,4 +1,6 @@
 #include "MP3Decoder.h"
+#include "../Core/ZoneTrace.h"
+#include <algorithm>
 #include <cstring>
 
 // TODO: #include <mpg123.h>  – integrate libmpg123 in a later phase
@@ -23,15 +25,20 @@ bool MP3Decoder::Open(const uint8_t* data, size_t size) {
 
 int MP3Decoder::Decode(float* buffer, int frameCount) {
     if (!data_) return 0;
+    UNAUDIO_ZONE("MP3 Decode");
     // TODO: Decode via mpg123
-    // Stub: fill silence
+    // Stub: fill silence up to the clip length (0 until the header is parsed)
+    int64_t remaining = totalFrames_ - currentFrame_;
+    int frames = static_cast<int>(std::min<int64_t>(frameCount, remaining));
+    if (frames <= 0) return 0;
     std::memset(buffer, 0,
-                static_cast<size_t>(frameCount) * format_.channels * sizeof(float));
-    currentFrame_ += frameCount;
-    return frameCount;
+                static_cast<size_t>(frames) * format_.channels * sizeof(float));
+    currentFrame_ += frames;
+    return frames;
 }
 
 bool MP3Decoder::Seek(int64_t frame) {
+    UNAUDIO_ZONE("MP3 Seek");
     // TODO: mpg123_seek
     currentFrame_ = frame;
     return true;
@@ -40,3 +47,6 @@ bool MP3Decoder::Seek(int64_t frame) {
 UNAudioFormat MP3Decoder::GetFormat()   const { return format_; }
 bool MP3Decoder::SupportsStreaming()     const { return true; }
 int64_t MP3Decoder::GetTotalFrames()    const { return totalFrames_; }
+// The mpg123 handle will be opaque (the library does not report its size),
+// so it stays out of the budget; see AudioDecoder::GetStateSize.
+size_t  MP3Decoder::GetStateSize()      const { return sizeof(*this); }
@@ -15,6 +15,7 @@ public:
     UNAudioFormat GetFormat() const override;
     bool SupportsStreaming() const override;
     int64_t GetTotalFrames() const override;
+    size_t GetStateSize() const override;
 
 private:
     UNAudioFormat format_{};
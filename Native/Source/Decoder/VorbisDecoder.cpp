@@ -1,4 +1,6 @@
 #include "VorbisDecoder.h"
+#include "../Core/ZoneTrace.h"
+#include <algorithm>
 #include <cstring>
 
 // TODO: #include <vorbis/vorbisfile.h>  – integrate libvorbis in a later phase
@@ -23,14 +25,20 @@ bool VorbisDecoder::Open(const uint8_t* data, size_t size) {
 
 int VorbisDecoder::Decode(float* buffer, int frameCount) {
     if (!data_) return 0;
+    UNAUDIO_ZONE("Vorbis Decode");
     // TODO: Decode via libvorbis
+    // Stub: fill silence up to the clip length (0 until the header is parsed)
+    int64_t remaining = totalFrames_ - currentFrame_;
+    int frames = static_cast<int>(std::min<int64_t>(frameCount, remaining));
+    if (frames <= 0) return 0;
     std::memset(buffer, 0,
-                static_cast<size_t>(frameCount) * format_.channels * sizeof(float));
-    currentFrame_ += frameCount;
-    return frameCount;
+                static_cast<size_t>(frames) * format_.channels * sizeof(float));
+    currentFrame_ += frames;
+    return frames;
 }
 
 bool VorbisDecoder::Seek(int64_t frame) {
+    UNAUDIO_ZONE("Vorbis Seek");
     currentFrame_ = frame;
     return true;
 }
@@ -38,3 +46,4 @@ bool VorbisDecoder::Seek(int64_t frame) {
 UNAudioFormat VorbisDecoder::GetFormat()   const { return format_; }
 bool VorbisDecoder::SupportsStreaming()     const { return true; }
 int64_t VorbisDecoder::GetTotalFrames()    const { return totalFrames_; }
+size_t  VorbisDecoder::GetStateSize()      const { return sizeof(*this); }
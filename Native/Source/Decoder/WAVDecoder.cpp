@@ -0,0 +1,129 @@
+#include "WAVDecoder.h"
+#include "../Core/ZoneTrace.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint16_t kFormatPCM        = 0x0001;
+constexpr uint16_t kFormatFloat      = 0x0003;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+uint16_t ReadU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t ReadU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+WAVDecoder::WAVDecoder()  = default;
+WAVDecoder::~WAVDecoder() = default;
+
+bool WAVDecoder::Open(const uint8_t* data, size_t size) {
+    if (!data || size < 12) return false;
+    if (std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0)
+        return false;
+
+    uint16_t formatTag = 0;
+    uint16_t channels  = 0;
+    uint32_t rate      = 0;
+    uint16_t bits      = 0;
+    bool haveFormat    = false;
+
+    size_t pos = 12;
+    while (pos + 8 <= size) {
+        const uint8_t* chunk = data + pos;
+        uint32_t chunkSize = ReadU32(chunk + 4);
+        size_t payload = pos + 8;
+        size_t available = size - payload;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && available >= 16) {
+            formatTag = ReadU16(data + payload);
+            channels  = ReadU16(data + payload + 2);
+            rate      = ReadU32(data + payload + 4);
+            bits      = ReadU16(data + payload + 14);
+            if (formatTag == kFormatExtensible && chunkSize >= 40 && available >= 40)
+                formatTag = ReadU16(data + payload + 24);   // SubFormat GUID prefix
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0 && haveFormat) {
+            bool supported =
+                (formatTag == kFormatPCM && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+                (formatTag == kFormatFloat && bits == 32);
+            if (!supported || channels == 0 || rate == 0) return false;
+
+            size_t bytes = std::min<size_t>(chunkSize, available);
+            samples_    = data + payload;
+            sourceBits_ = bits;
+            isFloat_    = formatTag == kFormatFloat;
+            totalFrames_ = static_cast<int64_t>(bytes / (channels * (bits / 8)));
+            currentFrame_ = 0;
+
+            format_.sampleRate    = static_cast<int32_t>(rate);
+            format_.channels      = channels;
+            format_.bitsPerSample = 32;    // float output
+            format_.blockAlign    = format_.channels * (format_.bitsPerSample / 8);
+            return true;
+        }
+
+        // Chunks are word-aligned.
+        pos = payload + chunkSize + (chunkSize & 1);
+    }
+    return false;
+}
+
+int WAVDecoder::Decode(float* buffer, int frameCount) {
+    if (!samples_ || frameCount <= 0) return 0;
+    UNAUDIO_ZONE("WAV Decode");
+
+    int64_t remaining = totalFrames_ - currentFrame_;
+    int frames = static_cast<int>(std::min<int64_t>(frameCount, remaining));
+    if (frames <= 0) return 0;
+
+    const int bytesPerSample = sourceBits_ / 8;
+    const size_t count = static_cast<size_t>(frames) * format_.channels;
+    const uint8_t* src = samples_ +
+        static_cast<size_t>(currentFrame_) * format_.channels * bytesPerSample;
+
+    switch (sourceBits_) {
+    case 8:
+        for (size_t i = 0; i < count; ++i)
+            buffer[i] = (static_cast<int>(src[i]) - 128) * (1.0f / 128.0f);
+        break;
+    case 16:
+        for (size_t i = 0; i < count; ++i)
+            buffer[i] = static_cast<int16_t>(ReadU16(src + i * 2)) * (1.0f / 32768.0f);
+        break;
+    case 24:
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* s = src + i * 3;
+            int32_t v = static_cast<int32_t>((static_cast<uint32_t>(s[0]) << 8) |
+                                             (static_cast<uint32_t>(s[1]) << 16) |
+                                             (static_cast<uint32_t>(s[2]) << 24)) >> 8;
+            buffer[i] = v * (1.0f / 8388608.0f);
+        }
+        break;
+    case 32:
+        if (isFloat_) {
+            std::memcpy(buffer, src, count * sizeof(float));
+        } else {
+            for (size_t i = 0; i < count; ++i)
+                buffer[i] = static_cast<int32_t>(ReadU32(src + i * 4)) * (1.0f / 2147483648.0f);
+        }
+        break;
+    }
+
+    currentFrame_ += frames;
+    return frames;
+}
+
+bool WAVDecoder::Seek(int64_t frame) {
+    if (frame < 0 || frame > totalFrames_) return false;
+    currentFrame_ = frame;
+    return true;
+}
+
+UNAudioFormat WAVDecoder::GetFormat()   const { return format_; }
+bool WAVDecoder::SupportsStreaming()     const { return true; }
+int64_t WAVDecoder::GetTotalFrames()    const { return totalFrames_; }
+size_t  WAVDecoder::GetStateSize()      const { return sizeof(*this); }
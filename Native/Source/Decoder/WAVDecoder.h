@@ -0,0 +1,29 @@
+#ifndef UNAUDIO_WAV_DECODER_H
+#define UNAUDIO_WAV_DECODER_H
+
+#include "AudioDecoder.h"
+
+/// RIFF/WAVE decoder for uncompressed PCM (8/16/24/32-bit integer, 32-bit float).
+class WAVDecoder : public AudioDecoder {
+public:
+    WAVDecoder();
+    ~WAVDecoder() override;
+
+    bool Open(const uint8_t* data, size_t size) override;
+    int  Decode(float* buffer, int frameCount) override;
+    bool Seek(int64_t frame) override;
+    UNAudioFormat GetFormat() const override;
+    bool SupportsStreaming() const override;
+    int64_t GetTotalFrames() const override;
+    size_t GetStateSize() const override;
+
+private:
+    UNAudioFormat format_{};
+    const uint8_t* samples_ = nullptr;   // start of the 'data' chunk payload
+    int32_t sourceBits_ = 0;             // bits per sample in the file
+    bool isFloat_ = false;
+    int64_t totalFrames_ = 0;
+    int64_t currentFrame_ = 0;
+};
+
+#endif // UNAUDIO_WAV_DECODER_H
@@ -1,17 +1,138 @@
 #include "AudioMixer.h"
+#include "Reverb.h"
+#include "../Core/ZoneTrace.h"
 #include <algorithm>
 #include <cstring>
 #include <cmath>
+#include <type_traits>
 
-AudioMixer::AudioMixer()  = default;
+namespace {
+
+// Per-frame gain sources for the kernels below.  Both inline to a plain
+// multiply, so the constant case keeps its straight vectorisable loop.
+struct ConstantGain {
+    float value;
+    float operator()(int) const { return value; }
+};
+
+struct RampGain {
+    const float* values;
+    float operator()(int frame) const { return values[frame]; }
+};
+
+// Where the kernels below deliver each weighted sample.  A source with a
+// steady send feeds the dry bus and the send bus in the same pass.
+struct BusSink {
+    float* bus;
+    void operator()(size_t i, float value) const { bus[i] += value; }
+};
+
+struct DrySendSink {
+    float* dry;
+    float* send;
+    float sendLevel;
+    void operator()(size_t i, float value) const {
+        dry[i] += value;
+        send[i] += value * sendLevel;
+    }
+};
+
+// Sum `frames` frames of src (srcChannels wide) into a sink (dstChannels wide).
+// Matching layouts take a straight multiply-add the compiler can vectorise;
+// mono is spread to every output channel, anything-to-mono is averaged, and
+// other mismatches map channel-for-channel.
+template <typename Gain, typename Sink>
+void Accumulate(Sink sink, int dstChannels, const float* src, int srcChannels,
+                int frames, Gain gain) {
+    if (srcChannels == dstChannels) {
+        if constexpr (std::is_same_v<Gain, ConstantGain>) {
+            const size_t count = static_cast<size_t>(frames) * dstChannels;
+            for (size_t i = 0; i < count; ++i)
+                sink(i, src[i] * gain.value);
+        } else if (dstChannels == 2) {
+            // Ramped stereo, the usual fade: fixed width so the frame loop vectorises.
+            for (int f = 0; f < frames; ++f) {
+                const float g = gain(f);
+                sink(2 * f, src[2 * f] * g);
+                sink(2 * f + 1, src[2 * f + 1] * g);
+            }
+        } else {
+            for (int f = 0; f < frames; ++f) {
+                const float g = gain(f);
+                for (int c = 0; c < dstChannels; ++c)
+                    sink(f * dstChannels + c, src[f * dstChannels + c] * g);
+            }
+        }
+    } else if (srcChannels == 1) {
+        for (int f = 0; f < frames; ++f) {
+            const float s = src[f] * gain(f);
+            for (int c = 0; c < dstChannels; ++c)
+                sink(f * dstChannels + c, s);
+        }
+    } else if (dstChannels == 1) {
+        const float scale = 1.0f / static_cast<float>(srcChannels);
+        for (int f = 0; f < frames; ++f) {
+            float sum = 0.0f;
+            for (int c = 0; c < srcChannels; ++c)
+                sum += src[f * srcChannels + c];
+            sink(f, sum * scale * gain(f));
+        }
+    } else {
+        const int common = std::min(srcChannels, dstChannels);
+        for (int f = 0; f < frames; ++f) {
+            const float g = gain(f);
+            for (int c = 0; c < common; ++c)
+                sink(f * dstChannels + c, src[f * srcChannels + c] * g);
+        }
+    }
+}
+
+template <typename Sink>
+void Accumulate(Sink sink, int dstChannels, const float* src, int srcChannels, int frames,
+                bool ramping, const GainRamp& ramp, const float* gains) {
+    if (ramping)
+        Accumulate(sink, dstChannels, src, srcChannels, frames, RampGain{gains});
+    else
+        Accumulate(sink, dstChannels, src, srcChannels, frames, ConstantGain{ramp.Value()});
+}
+
+// Mix a source through its gain (per-frame `gains` when ramping) into the dry
+// bus and, while its send is active, the send bus.  Returns whether the send
+// bus was fed.
+bool MixSource(float* dry, float* sendBus, int channels, const float* src, int srcChannels,
+               int frames, bool ramping, const GainRamp& gain, const float* gains,
+               GainRamp* send, float* sendGains) {
+    if (!sendBus || !send || send->IsIdleAt(0.0f)) {
+        Accumulate(BusSink{dry}, channels, src, srcChannels, frames, ramping, gain, gains);
+        return false;
+    }
+
+    if (!send->Render(sendGains, frames)) {
+        Accumulate(DrySendSink{dry, sendBus, send->Value()}, channels, src, srcChannels,
+                   frames, ramping, gain, gains);
+        return true;
+    }
+
+    // The send itself is gliding: two passes, the second at gain x send.
+    Accumulate(BusSink{dry}, channels, src, srcChannels, frames, ramping, gain, gains);
+    for (int f = 0; f < frames; ++f)
+        sendGains[f] *= ramping ? gains[f] : gain.Value();
+    Accumulate(BusSink{sendBus}, channels, src, srcChannels, frames, RampGain{sendGains});
+    return true;
+}
+
+} // namespace
+
+AudioMixer::AudioMixer(int sampleRate) : masterMeter_(sampleRate) {}
 AudioMixer::~AudioMixer() = default;
 
-void AudioMixer::AddSource(UNAudioSourceHandle source) {
+void AudioMixer::AddSource(MixerSource* source) {
     std::lock_guard<std::mutex> lock(mutex_);
-    activeSources_.push_back(source);
+    if (std::find(activeSources_.begin(), activeSources_.end(), source) == activeSources_.end())
+        activeSources_.push_back(source);
 }
 
-void AudioMixer::RemoveSource(UNAudioSourceHandle source) {
+void AudioMixer::RemoveSource(MixerSource* source) {
     std::lock_guard<std::mutex> lock(mutex_);
     activeSources_.erase(
         std::remove(activeSources_.begin(), activeSources_.end(), source),
@@ -19,28 +140,103 @@ void AudioMixer::RemoveSource(UNAudioSourceHandle source) {
 }
 
 void AudioMixer::Process(float* outputBuffer, int frameCount, int channels) {
+    UNAUDIO_ZONE("Mix");
     const size_t totalSamples = static_cast<size_t>(frameCount) * channels;
 
     // Clear output
     std::memset(outputBuffer, 0, totalSamples * sizeof(float));
+    if (gainBuffer_.size() < static_cast<size_t>(frameCount)) gainBuffer_.resize(frameCount);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t needed = static_cast<size_t>(frameCount) * kMaxChannels;
+        if (mixBuffer_.size() < needed) mixBuffer_.resize(needed);
+        if (reverb_) {
+            if (sendBuffer_.size() < totalSamples) sendBuffer_.resize(totalSamples);
+            if (sendGains_.size() < static_cast<size_t>(frameCount)) sendGains_.resize(frameCount);
+        }
+        bool sent = false;
+        const uint32_t metering = voiceMetering_.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < activeSources_.size();) {
+            MixerSource* source = activeSources_[i];
+            UNAUDIO_ZONE("Voice");
+            // Query the layout first: a source may become ready inside Read().
+            const int sourceChannels = source->GetChannels();
+            int frames;
+            {
+                UNAUDIO_ZONE("Read");
+                frames = source->Read(mixBuffer_.data(), frameCount);
+            }
+            if (frames > 0 && sourceChannels > 0 && sourceChannels <= kMaxChannels) {
+                GainRamp* send = reverb_ ? source->GetSend() : nullptr;
+                if (send && !sent && !send->IsIdleAt(0.0f)) {
+                    // The send bus is cleared lazily, by the first source that feeds it.
+                    std::memset(sendBuffer_.data(), 0, totalSamples * sizeof(float));
+                }
+                GainRamp& gain = source->GetGain();
+                const bool ramping = gain.Render(gainBuffer_.data(), frames);
+                sent |= MixSource(outputBuffer, reverb_ ? sendBuffer_.data() : nullptr,
+                                  channels, mixBuffer_.data(), sourceChannels, frames,
+                                  ramping, gain, gainBuffer_.data(), send, sendGains_.data());
+                // Metered on the data just mixed, while it is still in cache.
+                if (LevelMeter* meter = source->GetMeter()) {
+                    if (ramping) {
+                        // The gain moved within the block: meter the gained
+                        // signal itself, not the samples scaled by the end gain.
+                        for (int f = 0; f < frames; ++f)
+                            for (int c = 0; c < sourceChannels; ++c)
+                                mixBuffer_[static_cast<size_t>(f) * sourceChannels + c] *= gainBuffer_[f];
+                        meter->Process(mixBuffer_.data(), frames, sourceChannels, 1.0f, metering);
+                    } else {
+                        meter->Process(mixBuffer_.data(), frames, sourceChannels, gain.Value(),
+                                       metering);
+                    }
+                }
+            }
 
-    // TODO: For each active source, decode into mixBuffer_ and sum into outputBuffer.
-    // This will be implemented once decoders are fully integrated.
+            if (frames < frameCount) {
+                // Finished, paused or stopped – drop it from the bus.
+                activeSources_[i] = activeSources_.back();
+                activeSources_.pop_back();
+            } else {
+                ++i;
+            }
+        }
 
-    // Apply master volume and track peak
-    float peak = 0.0f;
-    for (size_t i = 0; i < totalSamples; ++i) {
-        outputBuffer[i] *= masterVolume_;
-        float abs = std::fabs(outputBuffer[i]);
-        if (abs > peak) peak = abs;
+        // One reverb for the whole bus; it keeps ringing after the sends stop.
+        if (reverb_) {
+            UNAUDIO_ZONE("Reverb");
+            reverb_->Process(sent ? sendBuffer_.data() : nullptr, outputBuffer, frameCount,
+                             channels);
+        }
     }
-    peakLevel_ = peak;
+
+    // Apply master volume and meter the result
+    UNAUDIO_ZONE("Master");
+    if (masterGain_.Render(gainBuffer_.data(), frameCount)) {
+        for (int f = 0; f < frameCount; ++f)
+            for (int c = 0; c < channels; ++c)
+                outputBuffer[f * channels + c] *= gainBuffer_[f];
+    } else {
+        const float master = masterGain_.Value();
+        for (size_t i = 0; i < totalSamples; ++i)
+            outputBuffer[i] *= master;
+    }
+
+    masterMeter_.Process(outputBuffer, frameCount, channels, 1.0f, UNAUDIO_METER_ALL);
 }
 
-void AudioMixer::SetMasterVolume(float volume) {
-    masterVolume_ = volume;
+void AudioMixer::SetMasterVolume(float volume, int32_t frames, UNAudioFadeCurve curve) {
+    masterGain_.Set(volume, frames, curve);
+}
+
+std::unique_ptr<FdnReverb> AudioMixer::SetReverb(std::unique_ptr<FdnReverb> reverb) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(reverb_, reverb);
+    return reverb;
 }
 
 float AudioMixer::GetPeakLevel() const {
-    return peakLevel_;
+    return masterMeter_.Read().peak;
 }
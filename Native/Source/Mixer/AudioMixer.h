@@ -2,39 +2,99 @@
 #define UNAUDIO_AUDIO_MIXER_H
 
 #include "../Core/AudioTypes.h"
+#include "GainRamp.h"
+#include "LevelMeter.h"
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <mutex>
 #include <cstdint>
 
+/// Render-side view of something the mixer can play.  Read() is only ever
+/// called from the mixing thread, while the mixer lock is held.
+class MixerSource {
+public:
+    virtual ~MixerSource() = default;
+
+    /// Write up to frameCount frames (interleaved, GetChannels() wide).
+    /// Returning fewer frames removes the source from the mix bus.
+    virtual int Read(float* buffer, int frameCount) = 0;
+
+    /// Channel count of the data produced by Read (0 = not ready, mix silence).
+    virtual int GetChannels() const = 0;
+
+    /// Gain applied per frame while summing.  Only the mixer advances it.
+    virtual GainRamp& GetGain() = 0;
+
+    /// Level sent to the reverb bus, on top of GetGain() (nullptr = no send).
+    virtual GainRamp* GetSend() { return nullptr; }
+
+    /// Meter fed with what Read() produced through GetGain(), ramp included
+    /// (nullptr = unmetered).
+    virtual LevelMeter* GetMeter() { return nullptr; }
+};
+
+class FdnReverb;
+
 /// Multi-track audio mixer with SIMD-ready mixing path.
 class AudioMixer {
 public:
-    AudioMixer();
+    /// Widest source layout the mixer accepts (7.1).
+    static constexpr int kMaxChannels = 8;
+
+    explicit AudioMixer(int sampleRate = 48000);
     ~AudioMixer();
 
-    /// Add a source to the mix bus.
-    void AddSource(UNAudioSourceHandle source);
+    /// Add a source to the mix bus (no-op if already present).
+    void AddSource(MixerSource* source);
 
-    /// Remove a source from the mix bus.
-    void RemoveSource(UNAudioSourceHandle source);
+    /// Remove a source from the mix bus.  Blocks until any block that is
+    /// reading it has finished, so the caller may then release it.
+    void RemoveSource(MixerSource* source);
 
     /// Mix all active sources into outputBuffer (interleaved float).
     void Process(float* outputBuffer, int frameCount, int channels);
 
-    /// Set the master volume applied after mixing.
-    void SetMasterVolume(float volume);
+    /// Ramp the master volume applied after mixing (0 frames = next block).
+    /// Callers must serialise calls (see GainRamp::Set).
+    void SetMasterVolume(float volume, int32_t frames = 0,
+                         UNAudioFadeCurve curve = UNAUDIO_FADE_LINEAR);
 
-    /// Get the current peak level (linear, 0..1+).
+    /// Get the current peak level (linear, 0..1+, held over 400 ms).
     float GetPeakLevel() const;
 
+    /// Meter reading of the output, after master volume.  Any thread.
+    UNAudioLevels GetMasterLevels() const { return masterMeter_.Read(); }
+
+    /// Restart integrated loudness of the output.  Any thread.
+    void ResetMasterLoudness() { masterMeter_.Reset(); }
+
+    /// Which optional measurements source meters run (UNAudioMeterFlags,
+    /// loudness only by default).  The output is always metered in full.
+    void SetVoiceMetering(uint32_t flags) { voiceMetering_.store(flags, std::memory_order_relaxed); }
+
+    /// Install the reverb on the send bus (nullptr removes it) and return the
+    /// previous one, so it is freed off the mixing thread.  Waits for the
+    /// current block.
+    std::unique_ptr<FdnReverb> SetReverb(std::unique_ptr<FdnReverb> reverb);
+
+    /// Reverb on the send bus, for parameter updates.  Callers must serialise
+    /// this with SetReverb.
+    FdnReverb* GetReverb() const { return reverb_.get(); }
+
 private:
-    std::vector<UNAudioSourceHandle> activeSources_;
+    std::vector<MixerSource*> activeSources_;
     std::mutex mutex_;
-    float masterVolume_ = 1.0f;
-    float peakLevel_    = 0.0f;
+    GainRamp masterGain_;
+    LevelMeter masterMeter_;
+    std::atomic<uint32_t> voiceMetering_{UNAUDIO_METER_LOUDNESS};
 
-    // Temporary buffer used during mixing
+    // Temporary buffers used during mixing
     std::vector<float> mixBuffer_;
+    std::vector<float> gainBuffer_;   // per-frame gain of the current ramp
+    std::vector<float> sendBuffer_;   // reverb send bus, output layout
+    std::vector<float> sendGains_;    // per-frame send gain of the current source
+    std::unique_ptr<FdnReverb> reverb_;   // under mutex_
 };
 
 #endif // UNAUDIO_AUDIO_MIXER_H
@@ -0,0 +1,87 @@
+#include "GainRamp.h"
+#include <algorithm>
+#include <cmath>
+
+GainRamp::GainRamp(float initial)
+    : requestTarget_(initial), target_(initial),
+      current_(initial), start_(initial), end_(initial) {}
+
+void GainRamp::Set(float target, int32_t frames, UNAudioFadeCurve curve, float from) {
+    const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    requestTarget_.store(target, std::memory_order_relaxed);
+    requestFrom_.store(from, std::memory_order_relaxed);
+    requestFrames_.store(std::max(frames, 0), std::memory_order_relaxed);
+    requestCurve_.store(curve, std::memory_order_relaxed);
+    target_.store(target, std::memory_order_relaxed);
+
+    sequence_.store(seq + 2, std::memory_order_release);
+}
+
+void GainRamp::Poll() {
+    const uint32_t seq = sequence_.load(std::memory_order_acquire);
+    if (seq == seen_ || (seq & 1u)) return;   // nothing new, or mid-write: next block
+
+    const float target = requestTarget_.load(std::memory_order_relaxed);
+    const float from   = requestFrom_.load(std::memory_order_relaxed);
+    const int32_t frames = requestFrames_.load(std::memory_order_relaxed);
+    const int32_t curve  = requestCurve_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != seq) return;   // torn read
+    seen_ = seq;
+
+    start_   = std::isnan(from) ? current_ : from;
+    end_     = target;
+    elapsed_ = 0;
+    length_  = frames;
+    curve_   = static_cast<UNAudioFadeCurve>(curve);
+    if (curve_ == UNAUDIO_FADE_EQUAL_POWER && length_ > 0) {
+        constexpr double kHalfPi = 1.57079632679489661923;
+        stepAngle_ = kHalfPi / length_;
+        stepSin_   = std::sin(stepAngle_);
+        stepCos_   = std::cos(stepAngle_);
+    }
+    if (length_ == 0) current_ = end_;
+}
+
+bool GainRamp::Render(float* gains, int frames) {
+    Poll();
+    if (frames <= 0 || elapsed_ >= length_) return false;
+
+    const int ramped = std::min(frames, length_ - elapsed_);
+    const double inv = 1.0 / length_;
+    const float delta = end_ - start_;
+
+    if (curve_ == UNAUDIO_FADE_EQUAL_POWER) {
+        // sin rising / cos falling: paired fades keep constant summed power.
+        // The angle advances by a fixed step, so (sin, cos) is rotated frame
+        // to frame; it is taken exactly once per block to bound the drift.
+        const double angle = (elapsed_ + 1) * stepAngle_;
+        double s = std::sin(angle), c = std::cos(angle);
+        for (int i = 0; i < ramped; ++i) {
+            gains[i] = delta >= 0.0f ? start_ + delta * static_cast<float>(s)
+                                     : end_ - delta * static_cast<float>(c);
+            const double next = s * stepCos_ + c * stepSin_;
+            c = c * stepCos_ - s * stepSin_;
+            s = next;
+        }
+    } else {
+        for (int i = 0; i < ramped; ++i)
+            gains[i] = start_ + delta * static_cast<float>((elapsed_ + i + 1) * inv);
+    }
+    elapsed_ += ramped;
+    // The last frame of the ramp is the target itself, not start + delta
+    // rounded, so the block after it continues without a step.
+    if (elapsed_ >= length_) gains[ramped - 1] = end_;
+    std::fill(gains + ramped, gains + frames, end_);
+
+    current_ = gains[ramped - 1];
+    return true;
+}
+
+bool GainRamp::IsIdleAt(float value) const {
+    return elapsed_ >= length_ && current_ == value &&
+           sequence_.load(std::memory_order_acquire) == seen_;
+}
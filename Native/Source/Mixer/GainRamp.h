@@ -0,0 +1,65 @@
+#ifndef UNAUDIO_GAIN_RAMP_H
+#define UNAUDIO_GAIN_RAMP_H
+
+#include "../Core/AudioTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+/// Sample-accurate gain automation.  Requests come from API threads and are
+/// picked up by the mixer at the start of its next block without locking;
+/// the mixer then evaluates the curve once per frame.
+class GainRamp {
+public:
+    /// Passed as `from` to start the ramp at the gain currently playing.
+    static constexpr float kFromCurrent = std::numeric_limits<float>::quiet_NaN();
+
+    explicit GainRamp(float initial = 1.0f);
+
+    /// Ramp to `target` over `frames` frames (0 = jump).  A newer request
+    /// replaces one the mixer has not picked up yet.  Callers must serialise
+    /// requests (the engine holds its lock).
+    void Set(float target, int32_t frames, UNAudioFadeCurve curve = UNAUDIO_FADE_LINEAR,
+             float from = kFromCurrent);
+
+    /// Target of the most recent request.
+    float GetTarget() const { return target_.load(std::memory_order_relaxed); }
+
+    // ── Mixer thread ─────────────────────────────────────────────
+
+    /// Advance by `frames`.  While ramping, writes one gain per frame into
+    /// `gains` and returns true; otherwise returns false and the block is
+    /// constant at Value().
+    bool Render(float* gains, int frames);
+
+    /// Gain at the end of the last rendered block.
+    float Value() const { return current_; }
+
+    /// True once the ramp has settled at `value` with nothing pending.
+    bool IsIdleAt(float value) const;
+
+private:
+    void Poll();
+
+    // Pending request, published with a sequence lock (odd = being written)
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<float>    requestTarget_{1.0f};
+    std::atomic<float>    requestFrom_{0.0f};
+    std::atomic<int32_t>  requestFrames_{0};
+    std::atomic<int32_t>  requestCurve_{UNAUDIO_FADE_LINEAR};
+    std::atomic<float>    target_{1.0f};
+
+    // Mixer thread only
+    uint32_t seen_ = 0;
+    float current_ = 1.0f;
+    float start_ = 1.0f;
+    float end_ = 1.0f;
+    int32_t elapsed_ = 0;
+    int32_t length_ = 0;
+    UNAudioFadeCurve curve_ = UNAUDIO_FADE_LINEAR;
+    double stepAngle_ = 0.0;   // equal-power: quarter turn / length_
+    double stepSin_ = 0.0;
+    double stepCos_ = 1.0;
+};
+
+#endif // UNAUDIO_GAIN_RAMP_H
@@ -0,0 +1,417 @@
+#include "LevelMeter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Integrated-loudness gates (ITU-R BS.1770-4 §2.8).
+constexpr float kAbsoluteGate = -70.0f;   // LUFS
+constexpr float kRelativeGate = -10.0f;   // LU below the ungated mean
+constexpr float kBinWidth = 0.5f;         // LU per histogram bin
+
+// Four-phase interpolator from BS.1770-4 Annex 2 (48 taps, 12 per phase).
+constexpr float kInterpolator[4][12] = {
+    { 0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+     -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+      0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f},
+    {-0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+     -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+      0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f},
+    {-0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+     -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+      0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f},
+    {-0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+     -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+      0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f},
+};
+
+// Largest gain any phase can apply: max over phases of the sum of |taps|.
+// No interpolated value exceeds the sample peak by more than this.
+constexpr float InterpolatorBound() {
+    float bound = 0.0f;
+    for (const auto& phase : kInterpolator) {
+        float sum = 0.0f;
+        for (float tap : phase) sum += tap < 0.0f ? -tap : tap;
+        bound = sum > bound ? sum : bound;
+    }
+    return bound;
+}
+
+float Lufs(double power) {
+    if (!(power > 0.0)) return -std::numeric_limits<float>::infinity();
+    return static_cast<float>(-0.691 + 10.0 * std::log10(power));
+}
+
+// BS.1770 channel weights: surrounds +1.5 dB, LFE excluded.
+float ChannelWeight(int channel, int channels) {
+    if (channels < 6) return 1.0f;
+    if (channel == 3) return 0.0f;
+    return channel >= 4 ? 1.41f : 1.0f;
+}
+
+// Peak magnitude and sum of squares of count samples.  Independent lanes
+// break the dependency chains so the loop vectorises.
+void Fold(const float* samples, size_t count, float& peak, double& energy) {
+    constexpr int kLanes = 8;
+    float hi[kLanes] = {}, sq[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (int l = 0; l < kLanes; ++l) {
+            const float s = samples[i + l];
+            const float m = std::fabs(s);
+            hi[l] = m > hi[l] ? m : hi[l];
+            sq[l] += s * s;
+        }
+    }
+    for (int l = 0; i < count; ++i, ++l) {
+        const float s = samples[i];
+        hi[l] = std::max(hi[l], std::fabs(s));
+        sq[l] += s * s;
+    }
+    float sum = 0.0f;
+    for (int l = 0; l < kLanes; ++l) {
+        peak = std::max(peak, hi[l]);
+        sum += sq[l];
+    }
+    energy += sum;
+}
+
+} // namespace
+
+LevelMeter::LevelMeter(int sampleRate)
+    : sliceFrames_(std::max(sampleRate, 8000) * kSliceMs / 1000) {
+    // K-weighting filters for this rate, derived from the analogue
+    // prototypes behind the 48 kHz coefficients in BS.1770.
+    const double fs = std::max(sampleRate, 8000);
+    {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const double k = std::tan(kPi * f0 / fs);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        shelf_ = {static_cast<float>((vh + vb * k / q + k * k) / a0),
+                  static_cast<float>(2.0 * (k * k - vh) / a0),
+                  static_cast<float>((vh - vb * k / q + k * k) / a0),
+                  static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                  static_cast<float>((1.0 - k / q + k * k) / a0)};
+    }
+    {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        const double k = std::tan(kPi * f0 / fs);
+        const double a0 = 1.0 + k / q + k * k;
+        highPass_ = {1.0f, -2.0f, 1.0f,
+                     static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                     static_cast<float>((1.0 - k / q + k * k) / a0)};
+    }
+
+    Clear();
+    const UNAudioLevels silence = Silence();
+    momentary_.store(silence.momentaryLufs, std::memory_order_relaxed);
+    shortTerm_.store(silence.shortTermLufs, std::memory_order_relaxed);
+    integratedOut_.store(silence.integratedLufs, std::memory_order_relaxed);
+}
+
+UNAudioLevels LevelMeter::Silence() {
+    const float none = -std::numeric_limits<float>::infinity();
+    return UNAudioLevels{0.0f, 0.0f, 0.0f, none, none, none};
+}
+
+void LevelMeter::Clear() {
+    std::memset(state_, 0, sizeof(state_));
+    std::memset(history_, 0, sizeof(history_));
+    for (Slice& slice : slices_) slice = Slice{};
+    current_ = 0;
+    completed_ = 0;
+    std::memset(binEnergy_, 0, sizeof(binEnergy_));
+    std::memset(binCount_, 0, sizeof(binCount_));
+    integrated_ = -std::numeric_limits<float>::infinity();
+}
+
+// ── Measurement ──────────────────────────────────────────────────
+
+void LevelMeter::Process(const float* samples, int frames, int channels, float gain,
+                         uint32_t flags) {
+    if (resetRequested_.exchange(false, std::memory_order_acquire)) Clear();
+    if (!samples || frames <= 0 || channels <= 0) return;
+    if (channels != channels_) {
+        // New layout: filter state and interpolator history no longer line up.
+        channels_ = channels;
+        std::memset(state_, 0, sizeof(state_));
+        std::memset(history_, 0, sizeof(history_));
+    }
+
+    const double energyScale = static_cast<double>(gain) * gain;
+    const float peakScale = std::fabs(gain);
+    for (int done = 0; done < frames;) {
+        Slice& slice = slices_[current_];
+        const int n = std::min(frames - done, sliceFrames_ - slice.frames);
+        // Unscaled true peak this block must beat to matter.
+        const float known = peakScale > 0.0f ? slice.truePeak / peakScale
+                                             : std::numeric_limits<float>::infinity();
+        Slice block;
+        Measure(samples + static_cast<size_t>(done) * channels, n, channels, flags, known, block);
+
+        slice.energy += block.energy * energyScale;
+        slice.weighted += block.weighted * energyScale;
+        slice.peak = std::max(slice.peak, block.peak * peakScale);
+        slice.truePeak = std::max(slice.truePeak, block.truePeak * peakScale);
+        slice.frames += n;
+        done += n;
+        if (slice.frames == sliceFrames_) CloseSlice();
+    }
+    Publish(flags);
+}
+
+void LevelMeter::Measure(const float* samples, int frames, int channels, uint32_t flags,
+                         float knownTruePeak, Slice& out) {
+    Fold(samples, static_cast<size_t>(frames) * channels, out.peak, out.energy);
+
+    const int metered = std::min(channels, kMaxChannels);
+    if (flags & UNAUDIO_METER_LOUDNESS) {
+        switch (channels) {
+        case 1:  out.weighted = KWeight<1>(samples, frames, channels, metered); break;
+        case 2:  out.weighted = KWeight<2>(samples, frames, channels, metered); break;
+        case 6:  out.weighted = KWeight<6>(samples, frames, channels, metered); break;
+        case 8:  out.weighted = KWeight<8>(samples, frames, channels, metered); break;
+        default: out.weighted = KWeight<0>(samples, frames, channels, metered); break;
+        }
+    }
+    if (flags & UNAUDIO_METER_TRUE_PEAK) {
+        // Quiet blocks (tails, silence, anything well below the slice's
+        // peak so far) cannot move the reading: skip the interpolator.
+        constexpr float kBound = InterpolatorBound();
+        if (out.peak * kBound > knownTruePeak)
+            out.truePeak = TruePeak(samples, frames, channels, metered);
+        else
+            KeepHistory(samples, frames, channels, metered);
+    }
+}
+
+template <int C>
+double LevelMeter::KWeight(const float* samples, int frames, int stride, int channels) {
+    // C > 0 fixes the lane count at compile time so the channel loops unroll
+    // into packed arithmetic; 0 handles the odd layouts.
+    const int lanes = C > 0 ? C : channels;
+    float s1[kMaxChannels], s2[kMaxChannels], h1[kMaxChannels], h2[kMaxChannels];
+    float sum[kMaxChannels] = {};
+    for (int c = 0; c < kMaxChannels; ++c) {
+        s1[c] = state_[0][c];
+        s2[c] = state_[1][c];
+        h1[c] = state_[2][c];
+        h2[c] = state_[3][c];
+    }
+
+    // Both stages in transposed direct form II; the high-pass numerator is
+    // (1, -2, 1).
+    const Biquad a = shelf_, b = highPass_;
+    for (int f = 0; f < frames; ++f) {
+        const float* in = samples + static_cast<size_t>(f) * stride;
+        for (int c = 0; c < lanes; ++c) {
+            const float x = in[c];
+            const float y = a.b0 * x + s1[c];
+            s1[c] = a.b1 * x - a.a1 * y + s2[c];
+            s2[c] = a.b2 * x - a.a2 * y;
+            const float w = y + h1[c];
+            h1[c] = -2.0f * y - b.a1 * w + h2[c];
+            h2[c] = y - b.a2 * w;
+            sum[c] += w * w;
+        }
+    }
+
+    // Flush decaying state before it turns denormal on silent input.
+    constexpr float kTiny = 1e-20f;
+    double weighted = 0.0;
+    for (int c = 0; c < lanes; ++c) {
+        state_[0][c] = std::fabs(s1[c]) < kTiny ? 0.0f : s1[c];
+        state_[1][c] = std::fabs(s2[c]) < kTiny ? 0.0f : s2[c];
+        state_[2][c] = std::fabs(h1[c]) < kTiny ? 0.0f : h1[c];
+        state_[3][c] = std::fabs(h2[c]) < kTiny ? 0.0f : h2[c];
+        weighted += static_cast<double>(sum[c]) * ChannelWeight(c, channels_);
+    }
+    return weighted;
+}
+
+void LevelMeter::Interpolate(const float* x, float* peaks) {
+    // Eight outputs of two phases at a time, as four groups of four: each
+    // group is one register accumulating a broadcast coefficient times a
+    // vector of inputs, and the four are independent so the add latency hides.
+    for (int p = 0; p < kPhases; p += 2) {
+        float even0[4] = {}, even1[4] = {}, odd0[4] = {}, odd1[4] = {};
+        for (int k = 0; k < kTaps; ++k) {
+            const float he = kInterpolator[p][k], ho = kInterpolator[p + 1][k];
+            const float* in = x - k;
+            for (int f = 0; f < 4; ++f) {
+                even0[f] += he * in[f];
+                even1[f] += he * in[4 + f];
+                odd0[f] += ho * in[f];
+                odd1[f] += ho * in[4 + f];
+            }
+        }
+        for (int f = 0; f < 4; ++f) {
+            const float m0 = std::max(std::fabs(even0[f]), std::fabs(odd0[f]));
+            const float m1 = std::max(std::fabs(even1[f]), std::fabs(odd1[f]));
+            peaks[f] = m0 > peaks[f] ? m0 : peaks[f];
+            peaks[4 + f] = m1 > peaks[4 + f] ? m1 : peaks[4 + f];
+        }
+    }
+}
+
+float LevelMeter::TruePeak(const float* samples, int frames, int stride, int channels) {
+    // Deinterleave a chunk behind the previous kTaps - 1 inputs of the same
+    // channel, then interpolate eight frames at a time.
+    constexpr int kHistory = kTaps - 1;
+    alignas(32) float buffer[kHistory + kChunkFrames];
+    float peaks[8] = {};
+
+    for (int c = 0; c < channels; ++c) {
+        std::memcpy(buffer, history_[c], sizeof(history_[c]));
+        for (int done = 0; done < frames;) {
+            const int n = std::min(kChunkFrames, frames - done);
+            for (int i = 0; i < n; ++i)
+                buffer[kHistory + i] = samples[static_cast<size_t>(done + i) * stride + c];
+
+            int i = 0;
+            for (; i + 8 <= n; i += 8) Interpolate(buffer + kHistory + i, peaks);
+            for (; i < n; ++i) {
+                const float* in = buffer + kHistory + i;
+                for (int p = 0; p < kPhases; ++p) {
+                    float acc = 0.0f;
+                    for (int k = 0; k < kTaps; ++k) acc += kInterpolator[p][k] * in[-k];
+                    peaks[0] = std::max(peaks[0], std::fabs(acc));
+                }
+            }
+
+            std::memmove(buffer, buffer + n, sizeof(float) * kHistory);
+            done += n;
+        }
+        std::memcpy(history_[c], buffer, sizeof(history_[c]));
+    }
+
+    float peak = 0.0f;
+    for (float p : peaks) peak = std::max(peak, p);
+    return peak;
+}
+
+void LevelMeter::KeepHistory(const float* samples, int frames, int stride, int channels) {
+    constexpr int kHistory = kTaps - 1;
+    const int keep = std::min(frames, kHistory);
+    for (int c = 0; c < channels; ++c) {
+        float* history = history_[c];
+        std::memmove(history, history + keep, sizeof(float) * (kHistory - keep));
+        for (int i = 0; i < keep; ++i)
+            history[kHistory - keep + i] =
+                samples[static_cast<size_t>(frames - keep + i) * stride + c];
+    }
+}
+
+// ── Windows and gating ───────────────────────────────────────────
+
+void LevelMeter::CloseSlice() {
+    completed_ = std::min(completed_ + 1, kShortTermSlices);
+
+    // The newest four slices form a 400 ms gating block; stepping one slice
+    // at a time gives the 75% overlap BS.1770 asks for.
+    if (completed_ >= kMomentarySlices) {
+        double weighted = 0.0;
+        int64_t frames = 0;
+        for (int s = 0; s < kMomentarySlices; ++s) {
+            const Slice& slice = slices_[(current_ - s + kShortTermSlices) % kShortTermSlices];
+            weighted += slice.weighted;
+            frames += slice.frames;
+        }
+        const double power = weighted / static_cast<double>(frames);
+        const float loudness = Lufs(power);
+        if (loudness > kAbsoluteGate) {
+            const int bin = std::min(static_cast<int>((loudness - kAbsoluteGate) / kBinWidth),
+                                     kGateBins - 1);
+            binEnergy_[bin] += power;
+            ++binCount_[bin];
+
+            // Relative gate: 10 LU below the mean of the absolute-gated
+            // blocks.  Bins are kept whole, so the threshold is exact to
+            // half a bin.
+            double energy = 0.0;
+            uint64_t count = 0;
+            for (int b = 0; b < kGateBins; ++b) {
+                energy += binEnergy_[b];
+                count += binCount_[b];
+            }
+            const float threshold = Lufs(energy / static_cast<double>(count)) + kRelativeGate;
+            energy = 0.0;
+            count = 0;
+            for (int b = 0; b < kGateBins; ++b) {
+                if (kAbsoluteGate + (b + 0.5f) * kBinWidth < threshold) continue;
+                energy += binEnergy_[b];
+                count += binCount_[b];
+            }
+            integrated_ = count ? Lufs(energy / static_cast<double>(count))
+                                : -std::numeric_limits<float>::infinity();
+        }
+    }
+
+    current_ = (current_ + 1) % kShortTermSlices;
+    slices_[current_] = Slice{};
+}
+
+void LevelMeter::Publish(uint32_t flags) {
+    // Windows end with the slice being filled, so readings move every block.
+    double energy = 0.0, weighted = 0.0, shortTerm = 0.0;
+    float peak = 0.0f, truePeak = 0.0f;
+    int64_t frames = 0, shortFrames = 0;
+    for (int s = 0; s < kShortTermSlices; ++s) {
+        const Slice& slice = slices_[(current_ - s + kShortTermSlices) % kShortTermSlices];
+        if (s < kMomentarySlices) {
+            energy += slice.energy;
+            weighted += slice.weighted;
+            peak = std::max(peak, slice.peak);
+            truePeak = std::max(truePeak, slice.truePeak);
+            frames += slice.frames;
+        }
+        shortTerm += slice.weighted;
+        shortFrames += slice.frames;
+    }
+
+    const float none = -std::numeric_limits<float>::infinity();
+    const bool loudness = (flags & UNAUDIO_METER_LOUDNESS) != 0;
+    const float rms = frames ? static_cast<float>(std::sqrt(
+                                   energy / (static_cast<double>(frames) * channels_)))
+                             : 0.0f;
+
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    rms_.store(rms, std::memory_order_relaxed);
+    peak_.store(peak, std::memory_order_relaxed);
+    truePeak_.store((flags & UNAUDIO_METER_TRUE_PEAK) ? truePeak : peak,
+                    std::memory_order_relaxed);
+    momentary_.store(loudness && frames ? Lufs(weighted / frames) : none,
+                     std::memory_order_relaxed);
+    shortTerm_.store(loudness && shortFrames ? Lufs(shortTerm / shortFrames) : none,
+                     std::memory_order_relaxed);
+    integratedOut_.store(loudness ? integrated_ : none, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+UNAudioLevels LevelMeter::Read() const {
+    for (;;) {
+        const uint32_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();   // the mixer is mid-publish
+            continue;
+        }
+        UNAudioLevels levels;
+        levels.rms = rms_.load(std::memory_order_relaxed);
+        levels.peak = peak_.load(std::memory_order_relaxed);
+        levels.truePeak = truePeak_.load(std::memory_order_relaxed);
+        levels.momentaryLufs = momentary_.load(std::memory_order_relaxed);
+        levels.shortTermLufs = shortTerm_.load(std::memory_order_relaxed);
+        levels.integratedLufs = integratedOut_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) return levels;
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef UNAUDIO_LEVEL_METER_H
+#define UNAUDIO_LEVEL_METER_H
+
+#include "../Core/AudioTypes.h"
+#include <atomic>
+#include <cstdint>
+
+/// Incremental level and loudness meter for one signal (a voice or the master
+/// bus), fed block by block from the mixing thread.
+///
+/// Everything is kept per 100 ms slice: unweighted energy, sample peak,
+/// 4x oversampled true peak (ITU-R BS.1770 Annex 2 interpolator) and
+/// K-weighted energy.  Windows are sums over the newest slices, so a reading
+/// costs a few adds however long the window.  Each completed 400 ms block
+/// (75% overlap) also lands in a 0.5 LU histogram from which the gated
+/// integrated loudness is recomputed in constant time.
+///
+/// K-weighting runs the two BS.1770 biquads with channels as SIMD lanes; the
+/// true-peak FIR runs eight frames of one channel per step and is skipped
+/// for blocks too quiet to raise the reading.
+///
+/// Readings are published through a sequence lock: the mixer never waits and
+/// readers on any thread see a consistent set.
+class LevelMeter {
+public:
+    /// Widest layout metered; further channels are ignored.
+    static constexpr int kMaxChannels = 8;
+
+    /// Slice length, and the windows in slices.
+    static constexpr int kSliceMs = 100;
+    static constexpr int kMomentarySlices = 4;    // 400 ms
+    static constexpr int kShortTermSlices = 30;   // 3 s
+
+    explicit LevelMeter(int sampleRate = 48000);
+
+    /// Any thread: start over (integrated loudness included) at the next block.
+    void Reset() { resetRequested_.store(true, std::memory_order_release); }
+
+    /// Mixing thread.  Measure frames of interleaved samples (channels wide).
+    /// The signal is measured as given and the readings scaled by gain, so a
+    /// voice can be metered post-volume without a gained copy.  flags is a
+    /// UNAudioMeterFlags mask; sample peak and RMS are always measured.
+    void Process(const float* samples, int frames, int channels, float gain, uint32_t flags);
+
+    /// Any thread: the latest published reading.
+    UNAudioLevels Read() const;
+
+    /// Reading for a signal that has never been measured (or is silent).
+    static UNAudioLevels Silence();
+
+private:
+    struct Slice {
+        double energy = 0.0;     // sum of squares over all channels
+        double weighted = 0.0;   // K-weighted, channel-weighted sum of squares
+        float peak = 0.0f;
+        float truePeak = 0.0f;
+        int32_t frames = 0;
+    };
+
+    struct Biquad {
+        float b0, b1, b2, a1, a2;
+    };
+
+    static constexpr int kTaps = 12;               // per interpolator phase
+    static constexpr int kPhases = 4;
+    static constexpr int kChunkFrames = 256;       // true-peak scratch
+    static constexpr int kGateBins = 160;          // -70 .. +10 LUFS in 0.5 LU
+
+    void Clear();
+    void Measure(const float* samples, int frames, int channels, uint32_t flags,
+                 float knownTruePeak, Slice& out);
+    template <int C>
+    double KWeight(const float* samples, int frames, int stride, int channels);
+    float TruePeak(const float* samples, int frames, int stride, int channels);
+    static void Interpolate(const float* x, float* peaks);
+    void KeepHistory(const float* samples, int frames, int stride, int channels);
+    void CloseSlice();
+    void Publish(uint32_t flags);
+
+    int sliceFrames_;
+    Biquad shelf_;        // stage 1: high-frequency shelf
+    Biquad highPass_;     // stage 2: RLB high-pass
+
+    // Mixing thread state
+    int channels_ = 0;
+    float state_[4][kMaxChannels] = {};            // z1/z2 of both stages
+    float history_[kMaxChannels][kTaps - 1] = {};  // last input samples per channel
+    Slice slices_[kShortTermSlices];
+    int current_ = 0;          // slice being filled
+    int completed_ = 0;        // slices closed since reset (saturates)
+    double binEnergy_[kGateBins] = {};
+    uint32_t binCount_[kGateBins] = {};
+    float integrated_ = 0.0f;  // LUFS, recomputed per slice
+    std::atomic<bool> resetRequested_{false};
+
+    // Published reading (sequence lock: odd while being written)
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<float> rms_{0.0f};
+    std::atomic<float> peak_{0.0f};
+    std::atomic<float> truePeak_{0.0f};
+    std::atomic<float> momentary_{0.0f};
+    std::atomic<float> shortTerm_{0.0f};
+    std::atomic<float> integratedOut_{0.0f};
+};
+
+#endif // UNAUDIO_LEVEL_METER_H
@@ -0,0 +1,258 @@
+#include "OutputConverter.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// ── Channel matrices ─────────────────────────────────────────────
+//
+// Speaker slots: 0 L, 1 R, 2 C, 3 LFE; 5.1 adds 4 Ls, 5 Rs; 7.1 adds
+// 4 Lb, 5 Rb, 6 Ls, 7 Rs.  Downmixes follow ITU-R BS.775 (centre and
+// surrounds at -3 dB, LFE dropped) and are not normalised: the converter
+// clamps instead.  Upmixes only route, they never synthesise.
+
+constexpr float kMinus3dB = 0.70710678f;
+
+// Gain of source slot s in the left (side 0) or right (side 1) of a stereo fold.
+constexpr float StereoFold(int src, int side, int s) {
+    if (s == side) return 1.0f;
+    if (src > 2 && s == 2) return kMinus3dB;
+    if (src > 2 && s >= 4 && (s & 1) == side) return kMinus3dB;
+    return 0.0f;
+}
+
+// Gain from source slot s to device slot d.
+constexpr float Coefficient(int src, int dst, int d, int s) {
+    if (src == dst) return d == s ? 1.0f : 0.0f;
+    if (dst == 1) return 0.5f * (StereoFold(src, 0, s) + StereoFold(src, 1, s));
+    if (src == 1) return d < 2 ? 1.0f : 0.0f;               // mono feeds the front pair
+    if (dst == 2) return StereoFold(src, d, s);
+    if (src == 2) return d == s ? 1.0f : 0.0f;              // stereo keeps the front pair
+    if (src == 6) {                                         // 5.1 -> 7.1: surrounds to sides
+        if (d < 4) return d == s ? 1.0f : 0.0f;
+        return d >= 6 && s == d - 2 ? 1.0f : 0.0f;
+    }
+    if (d < 4) return d == s ? 1.0f : 0.0f;                 // 7.1 -> 5.1: backs fold into sides
+    return s == d + 2 ? 1.0f : (s == d ? kMinus3dB : 0.0f);
+}
+
+template <int Src, int Dst>
+struct Matrix {
+    static constexpr float Gain(int d, int s) { return Coefficient(Src, Dst, d, s); }
+
+    static constexpr int First(int d) {
+        int s = 0;
+        while (s < Src && Gain(d, s) == 0.0f) ++s;
+        return s;
+    }
+};
+
+// Terms are expanded at compile time: zero gains vanish and unit gains
+// skip the multiply, so e.g. 5.1 -> stereo is three multiply-adds per side.
+template <typename M, int D, int S>
+inline float Term(const float* in) {
+    constexpr float gain = M::Gain(D, S);
+    if constexpr (gain == 1.0f) return in[S];
+    else return gain * in[S];
+}
+
+template <typename M, int Src, int D, int S>
+inline float Sum(const float* in, float acc) {
+    if constexpr (S == Src) {
+        return acc;
+    } else if constexpr (M::Gain(D, S) == 0.0f) {
+        return Sum<M, Src, D, S + 1>(in, acc);
+    } else {
+        return Sum<M, Src, D, S + 1>(in, acc + Term<M, D, S>(in));
+    }
+}
+
+template <typename M, int Src, int D>
+inline float Row(const float* in) {
+    constexpr int first = M::First(D);
+    if constexpr (first == Src) return 0.0f;
+    else return Sum<M, Src, D, first + 1>(in, Term<M, D, first>(in));
+}
+
+template <int Src, int Dst, int... D>
+inline void MixFrame(const float* in, float* out, std::integer_sequence<int, D...>) {
+    ((out[D] = Row<Matrix<Src, Dst>, Src, D>(in)), ...);
+}
+
+// ── Sample formats ───────────────────────────────────────────────
+
+template <UNAudioSampleFormat Format> struct Quantizer;
+
+template <> struct Quantizer<UNAUDIO_SAMPLE_S16> {
+    static constexpr float kScale = 32768.0f;
+    static constexpr float kMin = -32768.0f;
+    static constexpr float kMax = 32767.0f;
+    static constexpr bool kDither = true;
+};
+
+template <> struct Quantizer<UNAUDIO_SAMPLE_S24> {
+    static constexpr float kScale = 8388608.0f;
+    static constexpr float kMin = -8388608.0f;
+    static constexpr float kMax = 8388607.0f;
+    static constexpr bool kDither = true;
+};
+
+template <> struct Quantizer<UNAUDIO_SAMPLE_S32> {
+    static constexpr float kScale = 2147483648.0f;
+    static constexpr float kMin = -2147483648.0f;
+    static constexpr float kMax = 2147483520.0f;   // largest float below 2^31
+    // A float mix has 24 bits of mantissa; dither below that is lost.
+    static constexpr bool kDither = false;
+};
+
+// Scale, dither, clamp and round half away from zero.  Branch-free so the
+// loop compiles to packed multiply / min / max / convert.
+template <UNAudioSampleFormat Format, typename T>
+inline void Quantize(const float* in, T* out, int count, const float* noise) {
+    using Q = Quantizer<Format>;
+    for (int i = 0; i < count; ++i) {
+        float v = in[i] * Q::kScale;
+        if constexpr (Q::kDither) v += noise[i];
+        v += v < 0.0f ? -0.5f : 0.5f;
+        v = v < Q::kMin ? Q::kMin : v;
+        v = v > Q::kMax ? Q::kMax : v;
+        out[i] = static_cast<T>(v);
+    }
+}
+
+template <int Src, int Dst, UNAudioSampleFormat Format>
+void Convert(const float* source, uint8_t* device, int frames, const float* noise) {
+    const float* samples = source;
+    float mixed[OutputConverter::kChunkFrames * Dst];
+    if constexpr (Src != Dst) {
+        for (int f = 0; f < frames; ++f)
+            MixFrame<Src, Dst>(source + f * Src, mixed + f * Dst,
+                               std::make_integer_sequence<int, Dst>{});
+        samples = mixed;
+    }
+
+    const int count = frames * Dst;
+    if constexpr (Format == UNAUDIO_SAMPLE_FLOAT32) {
+        std::memcpy(device, samples, static_cast<size_t>(count) * sizeof(float));
+    } else if constexpr (Format == UNAUDIO_SAMPLE_S16) {
+        Quantize<Format>(samples, reinterpret_cast<int16_t*>(device), count, noise);
+    } else if constexpr (Format == UNAUDIO_SAMPLE_S32) {
+        Quantize<Format>(samples, reinterpret_cast<int32_t*>(device), count, noise);
+    } else {
+        // Packed 24-bit: quantise wide, then narrow to three bytes.
+        int32_t wide[OutputConverter::kChunkFrames * Dst];
+        Quantize<Format>(samples, wide, count, noise);
+        for (int i = 0; i < count; ++i) {
+            const uint32_t v = static_cast<uint32_t>(wide[i]);
+            device[3 * i]     = static_cast<uint8_t>(v);
+            device[3 * i + 1] = static_cast<uint8_t>(v >> 8);
+            device[3 * i + 2] = static_cast<uint8_t>(v >> 16);
+        }
+    }
+}
+
+// ── Kernel table ─────────────────────────────────────────────────
+
+using Kernel = void (*)(const float*, uint8_t*, int, const float*);
+
+template <int Src, int Dst>
+Kernel SelectFormat(UNAudioSampleFormat format) {
+    switch (format) {
+    case UNAUDIO_SAMPLE_FLOAT32: return &Convert<Src, Dst, UNAUDIO_SAMPLE_FLOAT32>;
+    case UNAUDIO_SAMPLE_S16:     return &Convert<Src, Dst, UNAUDIO_SAMPLE_S16>;
+    case UNAUDIO_SAMPLE_S24:     return &Convert<Src, Dst, UNAUDIO_SAMPLE_S24>;
+    case UNAUDIO_SAMPLE_S32:     return &Convert<Src, Dst, UNAUDIO_SAMPLE_S32>;
+    }
+    return nullptr;
+}
+
+template <int Src>
+Kernel SelectDevice(int dst, UNAudioSampleFormat format) {
+    switch (dst) {
+    case 1: return SelectFormat<Src, 1>(format);
+    case 2: return SelectFormat<Src, 2>(format);
+    case 6: return SelectFormat<Src, 6>(format);
+    case 8: return SelectFormat<Src, 8>(format);
+    }
+    return nullptr;
+}
+
+Kernel SelectKernel(int src, int dst, UNAudioSampleFormat format) {
+    switch (src) {
+    case 1: return SelectDevice<1>(dst, format);
+    case 2: return SelectDevice<2>(dst, format);
+    case 6: return SelectDevice<6>(dst, format);
+    case 8: return SelectDevice<8>(dst, format);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// ── OutputConverter ──────────────────────────────────────────────
+
+bool OutputConverter::IsSupportedLayout(int channels) {
+    return channels == 1 || channels == 2 || channels == 6 || channels == 8;
+}
+
+int OutputConverter::BytesPerSample(UNAudioSampleFormat format) {
+    switch (format) {
+    case UNAUDIO_SAMPLE_FLOAT32: return 4;
+    case UNAUDIO_SAMPLE_S16:     return 2;
+    case UNAUDIO_SAMPLE_S24:     return 3;
+    case UNAUDIO_SAMPLE_S32:     return 4;
+    }
+    return 0;
+}
+
+bool OutputConverter::Configure(int sourceChannels, int deviceChannels,
+                                UNAudioSampleFormat format, bool dither) {
+    kernel_ = SelectKernel(sourceChannels, deviceChannels, format);
+    if (!kernel_) return false;
+
+    sourceChannels_ = sourceChannels;
+    deviceChannels_ = deviceChannels;
+    format_ = format;
+    dither_ = dither && (format == UNAUDIO_SAMPLE_S16 || format == UNAUDIO_SAMPLE_S24);
+
+    for (int l = 0; l < kLanes; ++l) {
+        rngA_[l] = 0x9E3779B9u * static_cast<uint32_t>(l + 1);
+        rngB_[l] = 0x85EBCA6Bu * static_cast<uint32_t>(l + 1) + 1u;
+    }
+    std::memset(noise_, 0, sizeof(noise_));
+    return true;
+}
+
+void OutputConverter::Process(const float* source, void* device, int frames) {
+    if (!kernel_ || !source || !device || frames <= 0) return;
+
+    auto* out = static_cast<uint8_t*>(device);
+    const size_t frameBytes = static_cast<size_t>(deviceChannels_) * BytesPerSample(format_);
+    for (int done = 0; done < frames;) {
+        const int n = std::min(kChunkFrames, frames - done);
+        if (dither_) FillNoise(n * deviceChannels_);
+        kernel_(source + static_cast<size_t>(done) * sourceChannels_,
+                out + static_cast<size_t>(done) * frameBytes, n, noise_);
+        done += n;
+    }
+}
+
+void OutputConverter::FillNoise(int count) {
+    // TPDF: the sum of two independent uniform values in [-0.5, 0.5) LSB,
+    // i.e. a triangle over +-1 LSB.  Successive outputs of one LCG are
+    // correlated, so each value takes one draw from each bank (both
+    // full-period generators).  Rounded up to whole lanes; the buffer is a
+    // multiple of kLanes.
+    constexpr float kToUnit = 1.0f / 4294967296.0f;
+    for (int i = 0; i < count; i += kLanes) {
+        for (int l = 0; l < kLanes; ++l) {
+            const uint32_t a = rngA_[l] * 1664525u + 1013904223u;
+            const uint32_t b = rngB_[l] * 22695477u + 1u;
+            rngA_[l] = a;
+            rngB_[l] = b;
+            noise_[i + l] = (static_cast<float>(static_cast<int32_t>(a)) +
+                             static_cast<float>(static_cast<int32_t>(b))) * kToUnit;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef UNAUDIO_OUTPUT_CONVERTER_H
+#define UNAUDIO_OUTPUT_CONVERTER_H
+
+#include "../Core/AudioTypes.h"
+#include <cstdint>
+
+/// Last stage between the float mix and a device buffer: up/downmix from the
+/// mix layout to the device layout, then convert to the device sample format
+/// with clamping and (16/24-bit) TPDF dither.
+///
+/// Layouts are mono, stereo, 5.1 and 7.1 in WAVE speaker order: L R C LFE
+/// Ls Rs for 5.1, L R C LFE Lb Rb Ls Rs for 7.1.  Every (source layout, device layout, format)
+/// combination is a separate kernel with the matrix baked in as constants, so
+/// the inner loops have fixed trip counts and auto-vectorise.
+class OutputConverter {
+public:
+    /// Frames converted per pass; bounds the scratch kept in the object.
+    static constexpr int kChunkFrames = 256;
+
+    /// True for 1, 2, 6 and 8 channels.
+    static bool IsSupportedLayout(int channels);
+
+    /// Bytes per sample of format (0 if unknown).
+    static int BytesPerSample(UNAudioSampleFormat format);
+
+    /// Select the kernel.  Returns false (and leaves the converter invalid)
+    /// for an unsupported layout or format.
+    bool Configure(int sourceChannels, int deviceChannels, UNAudioSampleFormat format,
+                   bool dither = true);
+
+    bool IsValid() const { return kernel_ != nullptr; }
+    bool Matches(int sourceChannels, int deviceChannels, UNAudioSampleFormat format) const {
+        return kernel_ && sourceChannels_ == sourceChannels &&
+               deviceChannels_ == deviceChannels && format_ == format;
+    }
+
+    /// Convert frames of interleaved float (source layout) into device,
+    /// which must hold frames * deviceChannels samples.  Mixing thread only.
+    void Process(const float* source, void* device, int frames);
+
+private:
+    using Kernel = void (*)(const float* source, uint8_t* device, int frames,
+                            const float* noise);
+
+    void FillNoise(int count);
+
+    Kernel kernel_ = nullptr;
+    int sourceChannels_ = 0;
+    int deviceChannels_ = 0;
+    UNAudioSampleFormat format_ = UNAUDIO_SAMPLE_FLOAT32;
+    bool dither_ = false;
+
+    // Dither source: independent LCG lanes so the generator vectorises, in
+    // two banks (different generators) for the two uniforms of each value.
+    static constexpr int kLanes = 8;
+    uint32_t rngA_[kLanes] = {};
+    uint32_t rngB_[kLanes] = {};
+    float noise_[kChunkFrames * 8] = {};
+};
+
+#endif // UNAUDIO_OUTPUT_CONVERTER_H
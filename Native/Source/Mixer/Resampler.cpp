@@ -0,0 +1,64 @@
+#include "Resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void Resampler::Configure(int channels, int sourceRate, int outputRate, int maxFrames) {
+    channels_ = std::max(channels, 0);
+    active_ = channels_ > 0 && sourceRate > 0 && outputRate > 0 && sourceRate != outputRate;
+    step_ = active_ ? static_cast<double>(sourceRate) / outputRate : 1.0;
+    // Worst case per block: 2 frames of history + the span read + 3 taps.
+    if (active_) Reserve(static_cast<int64_t>(std::ceil(std::max(maxFrames, 1) * step_)) + 6);
+    Reset();
+}
+
+void Resampler::Reset() {
+    // One silent frame of history, so the first output is the first input.
+    position_ = 1.0;
+    stored_ = 1;
+    if (!input_.empty()) std::fill(input_.begin(), input_.begin() + channels_, 0.0f);
+}
+
+void Resampler::Reserve(int64_t frames) {
+    const size_t samples = static_cast<size_t>(frames) * channels_;
+    if (input_.size() < samples) input_.resize(samples, 0.0f);
+}
+
+int Resampler::Interpolate(float* out, int frames, int64_t available) {
+    const int channels = channels_;
+    const int64_t needed = static_cast<int64_t>(position_ + (frames - 1) * step_) + 3;
+    // Past the end of the source the missing taps read as silence.
+    if (available < needed)
+        std::memset(input_.data() + static_cast<size_t>(available) * channels, 0,
+                    static_cast<size_t>(needed - available) * channels * sizeof(float));
+
+    int produced = 0;
+    double t = position_;
+    for (; produced < frames; ++produced, t += step_) {
+        const int64_t i = static_cast<int64_t>(t);
+        if (i >= available) break;   // source ran dry
+        const float f = static_cast<float>(t - static_cast<double>(i));
+        const float* x0 = input_.data() + static_cast<size_t>(i - 1) * channels;
+        const float* x1 = x0 + channels;
+        const float* x2 = x1 + channels;
+        const float* x3 = x2 + channels;
+        float* dst = out + static_cast<size_t>(produced) * channels;
+        for (int c = 0; c < channels; ++c) {
+            const float c1 = 0.5f * (x2[c] - x0[c]);
+            const float c2 = x0[c] - 2.5f * x1[c] + 2.0f * x2[c] - 0.5f * x3[c];
+            const float c3 = 0.5f * (x3[c] - x0[c]) + 1.5f * (x1[c] - x2[c]);
+            dst[c] = ((c3 * f + c2) * f + c1) * f + x1[c];
+        }
+    }
+
+    // Keep one frame of history before the next read position.
+    const int64_t drop = std::min<int64_t>(static_cast<int64_t>(t) - 1, available);
+    if (drop > 0) {
+        std::memmove(input_.data(), input_.data() + static_cast<size_t>(drop) * channels,
+                     static_cast<size_t>(available - drop) * channels * sizeof(float));
+        t -= static_cast<double>(drop);
+    }
+    stored_ = available - std::max<int64_t>(drop, 0);
+    position_ = t;
+    return produced;
+}
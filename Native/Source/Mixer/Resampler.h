@@ -0,0 +1,72 @@
+#ifndef UNAUDIO_RESAMPLER_H
+#define UNAUDIO_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Streaming sample-rate converter for one voice: plays source-rate audio at
+/// the output rate with 4-point (Catmull-Rom) interpolation.  There is no
+/// anti-alias filter, which suits the usual 44.1 kHz <-> 48 kHz pairs; clips
+/// far above the output rate alias.
+///
+/// Configure() runs while the voice is off the mix bus; Process() and
+/// Reset() belong to the mixer thread.
+class Resampler {
+public:
+    /// Convert `channels`-wide audio from sourceRate to outputRate, with room
+    /// for blocks of up to maxFrames output frames (longer blocks are split).
+    /// Drops buffered input.  The only call that allocates.
+    void Configure(int channels, int sourceRate, int outputRate, int maxFrames);
+
+    /// True when the rates differ (Process() must be used).
+    bool IsActive() const { return active_; }
+
+    /// Drop buffered input, e.g. after the source was repositioned.
+    void Reset();
+
+    /// Write up to `frames` output frames, pulling source frames with
+    /// pull(float* dst, int frames) -> frames written.  Returns fewer than
+    /// `frames` once the source ran dry.
+    template <typename Pull>
+    int Process(float* out, int frames, Pull&& pull);
+
+private:
+    void Reserve(int64_t frames);
+    int Interpolate(float* out, int frames, int64_t available);
+
+    int channels_ = 0;
+    bool active_ = false;
+    double step_ = 1.0;      // source frames per output frame
+    double position_ = 1.0;  // read position in input_, always >= 1
+    int64_t stored_ = 1;     // frames held in input_ (one of history)
+    std::vector<float> input_;
+};
+
+template <typename Pull>
+int Resampler::Process(float* out, int frames, Pull&& pull) {
+    // A block longer than Configure() allowed runs in chunks that fit input_;
+    // the mixer thread never grows the buffer.
+    const int64_t capacity = static_cast<int64_t>(input_.size()) / (channels_ > 0 ? channels_ : 1);
+    int produced = 0;
+    while (produced < frames) {
+        // Output frame k reads input frames [i - 1, i + 2] around i = position + k * step.
+        const double room = (static_cast<double>(capacity - 3) - position_) / step_;
+        if (room < 0.0) break;
+        const int chunk = room < frames - produced - 1 ? static_cast<int>(room) + 1 : frames - produced;
+        const int64_t needed = static_cast<int64_t>(position_ + (chunk - 1) * step_) + 3;
+
+        int64_t available = stored_;
+        if (needed > stored_) {
+            const int got = pull(input_.data() + static_cast<size_t>(stored_) * channels_,
+                                 static_cast<int>(needed - stored_));
+            available += got > 0 ? got : 0;
+        }
+        const int written = Interpolate(out + static_cast<size_t>(produced) * channels_, chunk, available);
+        produced += written;
+        if (written < chunk) break;   // source ran dry
+    }
+    return produced;
+}
+
+#endif // UNAUDIO_RESAMPLER_H
@@ -0,0 +1,181 @@
+#include "Reverb.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Delay lengths are spread geometrically over this range, then moved to the
+// next prime so no two lines share a period.
+constexpr float kShortestDelayMs = 30.0f;
+constexpr float kLongestDelayMs  = 85.0f;
+
+// Below this the tail is inaudible (-120 dBFS) and the network may sleep.
+constexpr float kSilence = 1e-6f;
+
+bool IsPrime(int32_t n) {
+    if (n < 2) return false;
+    for (int32_t d = 2; d * d <= n; ++d)
+        if (n % d == 0) return false;
+    return true;
+}
+
+// Entry (row, column) of the Sylvester Hadamard matrix.
+float HadamardSign(int row, int column) {
+    int bits = row & column;
+    int parity = 0;
+    for (; bits; bits &= bits - 1) parity ^= 1;
+    return parity ? -1.0f : 1.0f;
+}
+
+} // namespace
+
+FdnReverb::FdnReverb(int lineCount, int sampleRate)
+    : lineCount_(lineCount == kMaxLines ? kMaxLines : 8),
+      sampleRate_(std::max(sampleRate, 8000)) {
+    int32_t longest = 0;
+    for (int l = 0; l < lineCount_; ++l) {
+        const float t = static_cast<float>(l) / static_cast<float>(lineCount_ - 1);
+        const float ms = kShortestDelayMs * std::pow(kLongestDelayMs / kShortestDelayMs, t);
+        int32_t frames = static_cast<int32_t>(ms * 0.001f * sampleRate_);
+        while (!IsPrime(frames)) ++frames;
+        delay_[l] = frames;
+        longest = std::max(longest, frames);
+    }
+
+    uint32_t size = 1;
+    while (size <= static_cast<uint32_t>(longest)) size <<= 1;
+    mask_ = size - 1;
+    lines_.assign(static_cast<size_t>(size) * lineCount_, 0.0f);
+
+    // Each channel enters and leaves through its own Hadamard row, which keeps
+    // the outputs decorrelated.  The LFE of 5.1 / 7.1 neither feeds nor gets
+    // reverb.
+    const float scale = 1.0f / std::sqrt(static_cast<float>(lineCount_));
+    for (int c = 0; c < 8; ++c) {
+        for (int l = 0; l < lineCount_; ++l) {
+            inputSigns_[c][l]  = c == 3 ? 0.0f : HadamardSign((c + 1) % lineCount_, l) * scale;
+            outputSigns_[c][l] = c == 3 ? 0.0f : HadamardSign(lineCount_ - 1 - c, l) * scale;
+        }
+    }
+}
+
+void FdnReverb::SetParams(float decayTime, float damping, float wetLevel) {
+    const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    decayTime_.store(decayTime, std::memory_order_relaxed);
+    damping_.store(damping, std::memory_order_relaxed);
+    wetLevel_.store(wetLevel, std::memory_order_relaxed);
+
+    sequence_.store(seq + 2, std::memory_order_release);
+}
+
+void FdnReverb::UpdateCoefficients(float decayTime, float damping, float wetLevel) {
+    // Each line loses 60 dB per decayTime at DC and per hfDecay at Nyquist.
+    // A one-pole lowpass with those two gains sits in every feedback path:
+    //   H(z) = g0 (1 - a) / (1 - a z^-1),  (1 - a) / (1 + a) = gNyquist / g0
+    const float decay = std::max(decayTime, 0.05f);
+    damping = std::clamp(damping, 0.0f, 1.0f);
+    const float hfDecay = std::max(decay * (1.0f - 0.95f * damping), 0.02f);
+    for (int l = 0; l < lineCount_; ++l) {
+        const float seconds = static_cast<float>(delay_[l]) / sampleRate_;
+        const float g0 = std::pow(10.0f, -3.0f * seconds / decay);
+        const float gNyquist = std::pow(10.0f, -3.0f * seconds / hfDecay);
+        const float ratio = gNyquist / g0;
+        const float a = (1.0f - ratio) / (1.0f + ratio);
+        pole_[l] = a;
+        feed_[l] = g0 * (1.0f - a);
+    }
+    wet_ = std::max(wetLevel, 0.0f);
+}
+
+void FdnReverb::Process(const float* input, float* output, int frames, int channels) {
+    if (!output || frames <= 0 || channels <= 0) return;
+
+    const uint32_t seq = sequence_.load(std::memory_order_acquire);
+    if (seq != appliedSequence_ && !(seq & 1u)) {   // mid-write: next block
+        const float decayTime = decayTime_.load(std::memory_order_relaxed);
+        const float damping = damping_.load(std::memory_order_relaxed);
+        const float wetLevel = wetLevel_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == seq) {   // else torn: next block
+            appliedSequence_ = seq;
+            UpdateCoefficients(decayTime, damping, wetLevel);
+        }
+    }
+
+    const bool inputSilent = input == nullptr;
+    if (inputSilent && idle_) return;
+    idle_ = false;
+
+    const float peak = lineCount_ == kMaxLines ? Run<kMaxLines>(input, output, frames, channels)
+                                               : Run<8>(input, output, frames, channels);
+
+    // Sleep once a whole longest delay has passed below the threshold, so
+    // nothing louder is still in flight.
+    quietFrames_ = inputSilent && peak < kSilence ? quietFrames_ + frames : 0;
+    if (quietFrames_ > static_cast<int64_t>(mask_)) idle_ = true;
+}
+
+template <int N>
+float FdnReverb::Run(const float* input, float* output, int frames, int channels) {
+    const int taps = std::min(channels, 8);
+    const int inputs = input ? taps : 0;
+    const uint32_t mask = mask_;
+    float* lines = lines_.data();
+
+    // Work on local copies so the stores to output cannot alias the state.
+    alignas(64) float feed[N], pole[N], filtered[N], delayed[N], inject[N];
+    int32_t delay[N];
+    for (int l = 0; l < N; ++l) {
+        feed[l] = feed_[l];
+        pole[l] = pole_[l];
+        filtered[l] = filtered_[l];
+        delay[l] = delay_[l];
+    }
+
+    const float householder = 2.0f / N;
+    const float wetStep = (wet_ - wetCurrent_) / static_cast<float>(frames);
+    float wet = wetCurrent_;
+    float peak = 0.0f;
+    uint32_t cursor = cursor_;
+    for (int f = 0; f < frames; ++f, ++cursor) {
+        const float* in = input ? input + static_cast<size_t>(f) * channels : nullptr;
+        float* out = output + static_cast<size_t>(f) * channels;
+
+        for (int l = 0; l < N; ++l) inject[l] = 0.0f;
+        for (int c = 0; c < inputs; ++c)
+            for (int l = 0; l < N; ++l) inject[l] += in[c] * inputSigns_[c][l];
+
+        // The one scalar step: each line reads at its own distance.
+        for (int l = 0; l < N; ++l)
+            delayed[l] = lines[((cursor - static_cast<uint32_t>(delay[l])) & mask) * N + l];
+
+        float sum = 0.0f;
+        for (int l = 0; l < N; ++l) {
+            filtered[l] = feed[l] * delayed[l] + pole[l] * filtered[l];
+            sum += filtered[l];
+        }
+        sum *= householder;
+
+        float* write = lines + (cursor & mask) * N;
+        for (int l = 0; l < N; ++l) {
+            write[l] = filtered[l] - sum + inject[l];
+            const float magnitude = std::fabs(filtered[l]);
+            peak = magnitude > peak ? magnitude : peak;
+        }
+
+        for (int c = 0; c < taps; ++c) {
+            float tap = 0.0f;
+            for (int l = 0; l < N; ++l) tap += filtered[l] * outputSigns_[c][l];
+            out[c] += tap * wet;
+        }
+        wet += wetStep;
+    }
+
+    cursor_ = cursor;
+    wetCurrent_ = wet_;
+    for (int l = 0; l < N; ++l) filtered_[l] = filtered[l];
+    return peak;
+}
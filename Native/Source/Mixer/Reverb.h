@@ -0,0 +1,80 @@
+#ifndef UNAUDIO_REVERB_H
+#define UNAUDIO_REVERB_H
+
+#include "../Core/AudioTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// Feedback delay network reverb for the mixer's shared send bus.
+///
+/// 8 or 16 delay lines of mutually prime lengths feed back through a
+/// Householder matrix (I - 2/N 11^T) and a per-line one-pole damping filter
+/// whose DC and Nyquist gains give the requested decay at low and high
+/// frequencies.  Line state is kept as struct-of-arrays and the delay memory
+/// is interleaved by line, so every per-frame step except the delayed read is
+/// a fixed-width loop across lines that fills whole SIMD registers.
+///
+/// One instance serves every voice: its cost depends on the line count and
+/// output layout, not on how many voices send to it.
+class FdnReverb {
+public:
+    static constexpr int kMaxLines = 16;
+
+    /// Allocates the delay memory.  lineCount is 8 or 16.
+    FdnReverb(int lineCount, int sampleRate);
+
+    int GetLineCount() const { return lineCount_; }
+
+    /// Parameter update from any thread; the mixer applies it at its next
+    /// block, all three values together.  Callers must serialise calls (the
+    /// engine holds its lock).
+    void SetParams(float decayTime, float damping, float wetLevel);
+
+    /// Mixer thread.  Run `frames` frames of the send bus (interleaved,
+    /// channels wide) through the network and add the wet signal to output.
+    /// Pass a null input when nothing was sent this block: once the tail has
+    /// died away the reverb then costs nothing.
+    void Process(const float* input, float* output, int frames, int channels);
+
+    /// Mixer thread.  True while the network sleeps: no input since the tail
+    /// fell below -120 dBFS, so Process() returns at once.
+    bool IsIdle() const { return idle_; }
+
+private:
+    /// Returns the block's peak line level, for idle detection.
+    template <int N>
+    float Run(const float* input, float* output, int frames, int channels);
+    void UpdateCoefficients(float decayTime, float damping, float wetLevel);
+
+    int lineCount_;
+    int sampleRate_;
+
+    // Requested parameters, published with a sequence lock (odd = being
+    // written) so the mixer never applies half an update.
+    std::atomic<uint32_t> sequence_{2};
+    std::atomic<float> decayTime_{1.5f};
+    std::atomic<float> damping_{0.5f};
+    std::atomic<float> wetLevel_{0.3f};
+    uint32_t appliedSequence_ = 0;
+
+    // Mixer thread: per-line coefficients and state
+    alignas(64) float feed_[kMaxLines] = {};       // damping filter input gain
+    alignas(64) float pole_[kMaxLines] = {};       // damping filter feedback
+    alignas(64) float filtered_[kMaxLines] = {};   // damping filter state
+    int32_t delay_[kMaxLines] = {};
+    float wet_ = 0.0f;          // target return gain
+    float wetCurrent_ = 0.0f;   // glides to wet_ over a block
+
+    // Input and output sign patterns (Hadamard rows), per output channel.
+    float inputSigns_[8][kMaxLines] = {};
+    float outputSigns_[8][kMaxLines] = {};
+
+    std::vector<float> lines_;   // [frame & mask_][line]
+    uint32_t mask_ = 0;
+    uint32_t cursor_ = 0;
+    int64_t quietFrames_ = 0;
+    bool idle_ = true;
+};
+
+#endif // UNAUDIO_REVERB_H
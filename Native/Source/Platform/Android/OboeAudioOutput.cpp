@@ -1,4 +1,5 @@
 #include "../AudioOutput.h"
+#include "../../Core/ZoneTrace.h"
 
 #ifdef __ANDROID__
 
@@ -30,18 +31,21 @@ OboeAudioOutput::OboeAudioOutput()  = default;
 OboeAudioOutput::~OboeAudioOutput() { Stop(); }
 
 bool OboeAudioOutput::Initialize(const UNAudioOutputConfig& config) {
+    UNAUDIO_ZONE("Oboe Initialize");
     config_ = config;
     // TODO: Build Oboe AudioStream with LowLatency + Exclusive mode
     return true;
 }
 
 bool OboeAudioOutput::Start() {
+    UNAUDIO_ZONE("Oboe Start");
     // TODO: stream->requestStart()
     running_ = true;
     return true;
 }
 
 void OboeAudioOutput::Stop() {
+    UNAUDIO_ZONE("Oboe Stop");
     // TODO: stream->requestStop(); stream->close();
     running_ = false;
 }
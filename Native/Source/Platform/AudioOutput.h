@@ -4,6 +4,10 @@
 #include "../Core/AudioTypes.h"
 
 /// Abstract base class for platform-specific audio output.
+///
+/// Backends wrap their device callback in UNAUDIO_ZONE("<Backend> Callback")
+/// (see ZoneTrace.h) so device scheduling shows up around the engine's Render
+/// zone in a trace.
 class AudioOutput {
 public:
     virtual ~AudioOutput() = default;
@@ -1,4 +1,5 @@
 #include "../AudioOutput.h"
+#include "../../Core/ZoneTrace.h"
 
 #ifdef __linux__
 
@@ -29,18 +30,21 @@ ALSAOutput::ALSAOutput()  = default;
 ALSAOutput::~ALSAOutput() { Stop(); }
 
 bool ALSAOutput::Initialize(const UNAudioOutputConfig& config) {
+    UNAUDIO_ZONE("ALSA Initialize");
     config_ = config;
     // TODO: snd_pcm_open, snd_pcm_hw_params, etc.
     return true;
 }
 
 bool ALSAOutput::Start() {
+    UNAUDIO_ZONE("ALSA Start");
     // TODO: snd_pcm_start
     running_ = true;
     return true;
 }
 
 void ALSAOutput::Stop() {
+    UNAUDIO_ZONE("ALSA Stop");
     // TODO: snd_pcm_drop / snd_pcm_close
     running_ = false;
 }
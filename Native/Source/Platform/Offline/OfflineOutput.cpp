@@ -0,0 +1,48 @@
+#include "OfflineOutput.h"
+#include "../../Core/ZoneTrace.h"
+#include "../../Mixer/OutputConverter.h"
+
+OfflineOutput::OfflineOutput(RenderCallback callback, void* user)
+    : callback_(callback), user_(user) {}
+
+OfflineOutput::~OfflineOutput() { Stop(); }
+
+void OfflineOutput::SetDeviceFormat(int32_t channels, UNAudioSampleFormat format) {
+    deviceChannels_ = channels;
+    deviceFormat_ = format;
+}
+
+bool OfflineOutput::Initialize(const UNAudioOutputConfig& config) {
+    if (!callback_ || config.channels <= 0 || config.bufferSize <= 0) return false;
+    const int32_t channels = deviceChannels_ > 0 ? deviceChannels_ : config.channels;
+    const int bytes = OutputConverter::BytesPerSample(deviceFormat_);
+    if (bytes == 0) return false;
+    config_ = config;
+    buffer_.assign(static_cast<size_t>(config.bufferSize) * channels * bytes, 0);
+    renderedFrames_ = 0;
+    return true;
+}
+
+bool OfflineOutput::Start() {
+    if (buffer_.empty()) return false;
+    running_ = true;
+    return true;
+}
+
+void OfflineOutput::Stop() { running_ = false; }
+
+const void* OfflineOutput::RenderBlock() {
+    if (!running_) return nullptr;
+    UNAUDIO_ZONE("Offline Callback");
+    callback_(buffer_.data(), config_.bufferSize, user_);
+    renderedFrames_ += config_.bufferSize;
+    return buffer_.data();
+}
+
+int32_t OfflineOutput::GetActualSampleRate() const { return config_.sampleRate; }
+int32_t OfflineOutput::GetActualBufferSize() const { return config_.bufferSize; }
+float   OfflineOutput::GetLatencyMs() const {
+    if (config_.sampleRate > 0)
+        return static_cast<float>(config_.bufferSize) / config_.sampleRate * 1000.0f;
+    return 0.0f;
+}
@@ -0,0 +1,48 @@
+#ifndef UNAUDIO_OFFLINE_OUTPUT_H
+#define UNAUDIO_OFFLINE_OUTPUT_H
+
+#include "../AudioOutput.h"
+#include <vector>
+
+/// Device-less output: blocks are pulled by the caller instead of a
+/// hardware callback, so the engine can render as fast as the CPU allows
+/// (trace replay, benchmarks, bouncing to a file).
+class OfflineOutput : public AudioOutput {
+public:
+    /// Fills `frames` interleaved frames in the device format; usually
+    /// AudioEngine::Render, or AudioEngine::RenderDevice for a converted one.
+    using RenderCallback = void (*)(void* buffer, int32_t frames, void* user);
+
+    OfflineOutput(RenderCallback callback, void* user);
+    ~OfflineOutput() override;
+
+    /// Emulate a device whose buffer differs from the mix (0 channels = the
+    /// config's).  Takes effect at the next Initialize.
+    void SetDeviceFormat(int32_t channels, UNAudioSampleFormat format);
+
+    bool Initialize(const UNAudioOutputConfig& config) override;
+    bool Start() override;
+    void Stop() override;
+    int32_t GetActualSampleRate() const override;
+    int32_t GetActualBufferSize() const override;
+    float   GetLatencyMs() const override;
+
+    /// Render one bufferSize block.  Returns the interleaved block in the
+    /// device format, or nullptr when the output is not running.
+    const void* RenderBlock();
+
+    /// Frames rendered since Initialize.
+    int64_t GetRenderedFrames() const { return renderedFrames_; }
+
+private:
+    RenderCallback callback_;
+    void* user_;
+    UNAudioOutputConfig config_{};
+    int32_t deviceChannels_ = 0;
+    UNAudioSampleFormat deviceFormat_ = UNAUDIO_SAMPLE_FLOAT32;
+    std::vector<uint8_t> buffer_;
+    int64_t renderedFrames_ = 0;
+    bool running_ = false;
+};
+
+#endif // UNAUDIO_OFFLINE_OUTPUT_H
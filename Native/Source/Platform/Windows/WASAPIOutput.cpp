@@ -1,4 +1,5 @@
 #include "../AudioOutput.h"
+#include "../../Core/ZoneTrace.h"
 
 #ifdef _WIN32
 
@@ -30,18 +31,21 @@ WASAPIOutput::WASAPIOutput()  = default;
 WASAPIOutput::~WASAPIOutput() { Stop(); }
 
 bool WASAPIOutput::Initialize(const UNAudioOutputConfig& config) {
+    UNAUDIO_ZONE("WASAPI Initialize");
     config_ = config;
     // TODO: CoInitialize, enumerate devices, create audio client
     return true;
 }
 
 bool WASAPIOutput::Start() {
+    UNAUDIO_ZONE("WASAPI Start");
     // TODO: IAudioClient::Start()
     running_ = true;
     return true;
 }
 
 void WASAPIOutput::Stop() {
+    UNAUDIO_ZONE("WASAPI Stop");
     // TODO: IAudioClient::Stop()
     running_ = false;
 }
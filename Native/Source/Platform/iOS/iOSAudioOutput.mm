@@ -1,4 +1,5 @@
 #include "../AudioOutput.h"
+#include "../../Core/ZoneTrace.h"
 
 #if defined(__APPLE__) && defined(TARGET_OS_IPHONE)
 
@@ -29,17 +30,20 @@ iOSAudioOutput::iOSAudioOutput()  = default;
 iOSAudioOutput::~iOSAudioOutput() { Stop(); }
 
 bool iOSAudioOutput::Initialize(const UNAudioOutputConfig& config) {
+    UNAUDIO_ZONE("iOS Initialize");
     config_ = config;
     // TODO: AVAudioSession setup, AudioUnit creation
     return true;
 }
 
 bool iOSAudioOutput::Start() {
+    UNAUDIO_ZONE("iOS Start");
     running_ = true;
     return true;
 }
 
 void iOSAudioOutput::Stop() {
+    UNAUDIO_ZONE("iOS Stop");
     running_ = false;
 }
 
@@ -1,4 +1,5 @@
 #include "../AudioOutput.h"
+#include "../../Core/ZoneTrace.h"
 
 #ifdef __APPLE__
 
@@ -30,18 +31,21 @@ CoreAudioOutput::CoreAudioOutput()  = default;
 CoreAudioOutput::~CoreAudioOutput() { Stop(); }
 
 bool CoreAudioOutput::Initialize(const UNAudioOutputConfig& config) {
+    UNAUDIO_ZONE("CoreAudio Initialize");
     config_ = config;
     // TODO: Create AudioUnit, set stream format, set render callback
     return true;
 }
 
 bool CoreAudioOutput::Start() {
+    UNAUDIO_ZONE("CoreAudio Start");
     // TODO: AudioOutputUnitStart()
     running_ = true;
     return true;
 }
 
 void CoreAudioOutput::Stop() {
+    UNAUDIO_ZONE("CoreAudio Stop");
     // TODO: AudioOutputUnitStop()
     running_ = false;
 }
@@ -0,0 +1,189 @@
+// Block ADPCM: encode -> decode fidelity, partial and independent blocks,
+// seeks across block boundaries, and UNAudio_TranscodeADPCM.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Decoder/ADPCMCodec.h"
+#include "Decoder/ADPCMDecoder.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kBlock = adpcm::kFramesPerBlock;
+
+/// Interleaved sine with a different frequency per channel.
+std::vector<float> MakeSine(int64_t frames, int channels) {
+    std::vector<float> pcm(static_cast<size_t>(frames) * channels);
+    for (int64_t i = 0; i < frames; ++i)
+        for (int c = 0; c < channels; ++c)
+            pcm[static_cast<size_t>(i) * channels + c] =
+                0.5f * static_cast<float>(std::sin(0.01 * (c + 1) * static_cast<double>(i)));
+    return pcm;
+}
+
+std::vector<float> DecodeAll(ADPCMDecoder& decoder, int channels, int chunk) {
+    std::vector<float> out;
+    std::vector<float> buffer(static_cast<size_t>(chunk) * channels);
+    int got;
+    while ((got = decoder.Decode(buffer.data(), chunk)) > 0)
+        out.insert(out.end(), buffer.begin(), buffer.begin() + static_cast<size_t>(got) * channels);
+    return out;
+}
+
+double SnrDb(const std::vector<float>& reference, const std::vector<float>& decoded) {
+    double signal = 0.0, noise = 0.0;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        const double d = reference[i] - decoded[i];
+        signal += static_cast<double>(reference[i]) * reference[i];
+        noise += d * d;
+    }
+    return 10.0 * std::log10(signal / std::max(noise, 1e-30));
+}
+
+} // namespace
+
+UNAUDIO_TEST(RoundTripKeepsSignal) {
+    for (int channels : { 1, 2, 6 }) {
+        const int64_t frames = 48000;
+        const std::vector<float> pcm = MakeSine(frames, channels);
+        std::vector<uint8_t> encoded;
+        UNAUDIO_CHECK(adpcm::Encode(pcm.data(), frames, channels, 48000, encoded));
+        UNAUDIO_CHECK(adpcm::IsADPCM(encoded.data(), encoded.size()));
+
+        ADPCMDecoder decoder;
+        UNAUDIO_CHECK(decoder.Open(encoded.data(), encoded.size()));
+        UNAUDIO_CHECK(decoder.GetFormat().channels == channels);
+        UNAUDIO_CHECK(decoder.GetFormat().sampleRate == 48000);
+        UNAUDIO_CHECK(decoder.GetTotalFrames() == frames);
+
+        const std::vector<float> decoded = DecodeAll(decoder, channels, 1024);
+        UNAUDIO_CHECK(decoded.size() == pcm.size());
+        if (decoded.size() == pcm.size()) UNAUDIO_CHECK(SnrDb(pcm, decoded) > 30.0);
+        // Roughly 4:1 against 16-bit PCM.
+        UNAUDIO_CHECK(encoded.size() < static_cast<size_t>(frames) * channels * 2 / 3);
+    }
+}
+
+UNAUDIO_TEST(PartialFinalBlock) {
+    for (int64_t frames : { int64_t{1}, int64_t{kBlock - 1}, int64_t{kBlock},
+                            int64_t{kBlock + 1}, int64_t{3 * kBlock + 17} }) {
+        const std::vector<float> pcm = MakeSine(frames, 2);
+        std::vector<uint8_t> encoded;
+        UNAUDIO_CHECK(adpcm::Encode(pcm.data(), frames, 2, 44100, encoded));
+
+        const int64_t blocks = (frames + kBlock - 1) / kBlock;
+        UNAUDIO_CHECK(encoded.size() ==
+                      sizeof(adpcm::ADPCMHeader) + static_cast<size_t>(blocks) * adpcm::BlockBytes(2));
+
+        ADPCMDecoder decoder;
+        UNAUDIO_CHECK(decoder.Open(encoded.data(), encoded.size()));
+        UNAUDIO_CHECK(decoder.GetTotalFrames() == frames);
+        // Chunks that straddle every block boundary; nothing past the end.
+        UNAUDIO_CHECK(DecodeAll(decoder, 2, 100).size() == pcm.size());
+        float tail[2];
+        UNAUDIO_CHECK(decoder.Decode(tail, 1) == 0);
+    }
+    std::vector<uint8_t> encoded;
+    const float sample = 0.0f;
+    UNAUDIO_CHECK(!adpcm::Encode(&sample, 0, 1, 48000, encoded));
+    UNAUDIO_CHECK(!adpcm::Encode(&sample, 1, adpcm::kMaxChannels + 1, 48000, encoded));
+}
+
+UNAUDIO_TEST(BlocksDecodeIndependently) {
+    const int64_t frames = 5 * kBlock + 40;
+    const std::vector<float> pcm = MakeSine(frames, 2);
+    std::vector<uint8_t> encoded;
+    UNAUDIO_CHECK(adpcm::Encode(pcm.data(), frames, 2, 48000, encoded));
+
+    ADPCMDecoder decoder;
+    UNAUDIO_CHECK(decoder.Open(encoded.data(), encoded.size()));
+    const std::vector<float> sequential = DecodeAll(decoder, 2, 77);
+    UNAUDIO_CHECK(sequential.size() == pcm.size());
+    if (sequential.size() != pcm.size()) return;
+
+    // Each block carries its own state: decoding it alone gives the same samples.
+    float block[kBlock * 2];
+    for (int64_t b = 0; b * kBlock < frames; ++b) {
+        const int count = static_cast<int>(std::min<int64_t>(kBlock, frames - b * kBlock));
+        adpcm::DecodeBlock(encoded.data() + sizeof(adpcm::ADPCMHeader) + b * adpcm::BlockBytes(2),
+                           2, count, block);
+        UNAUDIO_CHECK(std::equal(block, block + count * 2,
+                                 sequential.begin() + static_cast<size_t>(b) * kBlock * 2));
+    }
+}
+
+UNAUDIO_TEST(SeekMatchesSequentialDecode) {
+    const int64_t frames = 4 * kBlock + 100;
+    const std::vector<float> pcm = MakeSine(frames, 2);
+    std::vector<uint8_t> encoded;
+    UNAUDIO_CHECK(adpcm::Encode(pcm.data(), frames, 2, 48000, encoded));
+
+    ADPCMDecoder decoder;
+    UNAUDIO_CHECK(decoder.Open(encoded.data(), encoded.size()));
+    const std::vector<float> sequential = DecodeAll(decoder, 2, 512);
+    if (sequential.size() != pcm.size()) return;
+
+    std::vector<float> buffer(300 * 2);
+    for (int64_t target : { int64_t{0}, int64_t{kBlock - 1}, int64_t{kBlock}, int64_t{kBlock + 1},
+                            int64_t{3 * kBlock - 5}, frames - 1 }) {
+        UNAUDIO_CHECK(decoder.Seek(target));
+        const int got = decoder.Decode(buffer.data(), 300);
+        UNAUDIO_CHECK(got == static_cast<int>(std::min<int64_t>(300, frames - target)));
+        UNAUDIO_CHECK(std::equal(buffer.begin(), buffer.begin() + got * 2,
+                                 sequential.begin() + static_cast<size_t>(target) * 2));
+    }
+    UNAUDIO_CHECK(decoder.Seek(frames));
+    UNAUDIO_CHECK(decoder.Decode(buffer.data(), 1) == 0);
+    UNAUDIO_CHECK(!decoder.Seek(frames + 1));
+    UNAUDIO_CHECK(!decoder.Seek(-1));
+}
+
+UNAUDIO_TEST(RejectsTruncatedContainer) {
+    const std::vector<float> pcm = MakeSine(3 * kBlock, 1);
+    std::vector<uint8_t> encoded;
+    UNAUDIO_CHECK(adpcm::Encode(pcm.data(), 3 * kBlock, 1, 48000, encoded));
+    UNAUDIO_CHECK(!adpcm::IsADPCM(encoded.data(), encoded.size() - 1));
+    UNAUDIO_CHECK(!adpcm::IsADPCM(encoded.data(), sizeof(adpcm::ADPCMHeader) - 1));
+
+    ADPCMDecoder decoder;
+    UNAUDIO_CHECK(!decoder.Open(encoded.data(), encoded.size() - 1));
+    encoded[0] = 'X';
+    UNAUDIO_CHECK(!adpcm::IsADPCM(encoded.data(), encoded.size()));
+}
+
+UNAUDIO_TEST(TranscodeThroughApi) {
+    const std::vector<uint8_t> wav = test::MakeSineWav(3000, 2, 44100);
+    const int32_t wavSize = static_cast<int32_t>(wav.size());
+
+    // A null or undersized buffer reports the size without writing.
+    const int32_t size = UNAudio_TranscodeADPCM(wav.data(), wavSize, nullptr, 0);
+    UNAUDIO_CHECK(size > 0);
+    if (size <= 0) return;
+    std::vector<uint8_t> encoded(static_cast<size_t>(size) + 1, 0xEE);
+    UNAUDIO_CHECK(UNAudio_TranscodeADPCM(wav.data(), wavSize, encoded.data(), size - 1) == size);
+    UNAUDIO_CHECK(encoded[0] == 0xEE);
+    UNAUDIO_CHECK(UNAudio_TranscodeADPCM(wav.data(), wavSize, encoded.data(), size) == size);
+    UNAUDIO_CHECK(encoded[static_cast<size_t>(size)] == 0xEE);
+    UNAUDIO_CHECK(adpcm::IsADPCM(encoded.data(), static_cast<size_t>(size)));
+    UNAUDIO_CHECK(UNAudio_TranscodeADPCM(wav.data(), 0, nullptr, 0) == UNAUDIO_ERROR_INVALID_PARAM);
+
+    // Loading the container, or the WAV in ADPCM mode, gives the same clip.
+    const int32_t fromContainer = UNAudio_LoadAudio(encoded.data(), size, UNAUDIO_COMPRESS_IN_MEMORY);
+    const int32_t fromWav = UNAudio_LoadAudio(wav.data(), wavSize, UNAUDIO_ADPCM_IN_MEMORY);
+    for (int32_t handle : { fromContainer, fromWav }) {
+        UNAUDIO_CHECK(handle >= 0);
+        const UNAudioClipInfo info = UNAudio_GetClipInfo(handle);
+        UNAUDIO_CHECK(info.totalFrames == 3000);
+        UNAUDIO_CHECK(info.channels == 2);
+        UNAUDIO_CHECK(info.sampleRate == 44100);
+    }
+}
+
+int main() {
+    const UNAudioOutputConfig config{ 48000, 2, 256, 2, 0 };
+    if (UNAudio_Initialize(config) != UNAUDIO_OK) return 1;
+    const int result = test::RunAll();
+    UNAudio_Shutdown();
+    return result;
+}
@@ -0,0 +1,153 @@
+// Asynchronous loading: status polling, batch queries, cancelling a queued
+// load, and Shutdown while loads are queued, running or being issued.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+const UNAudioOutputConfig kConfig{ 48000, 2, 256, 2, 0 };
+
+int32_t LoadAsync(const std::vector<uint8_t>& data, int32_t mode) {
+    return UNAudio_LoadAudioAsync(data.data(), static_cast<int32_t>(data.size()), mode);
+}
+
+/// Poll until every load is complete; false after ten seconds.
+bool WaitForLoads(const std::vector<int32_t>& handles) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (UNAudio_GetLoadStatusBatch(handles.data(), static_cast<int32_t>(handles.size()),
+                                      nullptr) < static_cast<int32_t>(handles.size())) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+UNAUDIO_TEST(LoadsInBackgroundAndReportsStatus) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000);
+    const std::vector<uint8_t> garbage(4096, 0x5A);
+
+    const std::vector<int32_t> handles = {
+        LoadAsync(wav, UNAUDIO_DECOMPRESS_ON_LOAD),
+        LoadAsync(wav, UNAUDIO_COMPRESS_IN_MEMORY),
+        LoadAsync(wav, UNAUDIO_ADPCM_IN_MEMORY),
+        LoadAsync(garbage, UNAUDIO_DECOMPRESS_ON_LOAD),
+    };
+    for (int32_t handle : handles) UNAUDIO_CHECK(handle >= 0);
+    UNAUDIO_CHECK(WaitForLoads(handles));
+
+    int32_t status[5];
+    const int32_t query[] = { handles[0], handles[1], handles[2], handles[3], 9999 };
+    UNAUDIO_CHECK(UNAudio_GetLoadStatusBatch(query, 5, status) == 4);
+    for (int i = 0; i < 3; ++i) UNAUDIO_CHECK(status[i] == UNAUDIO_LOAD_LOADED);
+    UNAUDIO_CHECK(status[3] == UNAUDIO_LOAD_FAILED);
+    UNAUDIO_CHECK(status[4] == UNAUDIO_LOAD_NONE);
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(handles[0]) == UNAUDIO_LOAD_LOADED);
+
+    // Same clip info as a synchronous load, whatever the mode.
+    const int32_t sync = UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()),
+                                           UNAUDIO_DECOMPRESS_ON_LOAD);
+    const UNAudioClipInfo expected = UNAudio_GetClipInfo(sync);
+    for (int i = 0; i < 3; ++i) {
+        const UNAudioClipInfo info = UNAudio_GetClipInfo(handles[static_cast<size_t>(i)]);
+        UNAUDIO_CHECK(info.sampleRate == expected.sampleRate && info.channels == expected.channels);
+        UNAUDIO_CHECK(info.totalFrames == expected.totalFrames);
+    }
+    UNAUDIO_CHECK(UNAudio_PlayInstance(handles[0]) >= 0);
+    UNAUDIO_CHECK(UNAudio_PlayInstance(handles[3]) < 0);
+
+    // A finished load cannot be cancelled.
+    UNAUDIO_CHECK(UNAudio_CancelLoad(handles[0]) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_CancelLoad(9999) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(CancelWhileQueued) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+
+    // Transcodes keep every load worker busy well past the last submit.
+    const std::vector<uint8_t> big = test::MakeSineWav(10 * 48000, 2, 48000);
+    const unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int32_t> blockers;
+    for (unsigned i = 0; i < 2 * workers + 2; ++i)
+        blockers.push_back(LoadAsync(big, UNAUDIO_ADPCM_IN_MEMORY));
+
+    const std::vector<uint8_t> wav = test::MakeSineWav(4800, 1, 48000);
+    const int32_t queued = LoadAsync(wav, UNAUDIO_DECOMPRESS_ON_LOAD);
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(queued) == UNAUDIO_LOAD_PENDING);
+    UNAUDIO_CHECK(UNAudio_CancelLoad(queued) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(queued) == UNAUDIO_LOAD_CANCELLED);
+    UNAUDIO_CHECK(UNAudio_CancelLoad(queued) == UNAUDIO_ERROR_INVALID_PARAM);
+
+    // When the worker reaches the job it leaves it cancelled.
+    UNAUDIO_CHECK(WaitForLoads(blockers));
+    UNAUDIO_CHECK(WaitForLoads({ queued }));
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(queued) == UNAUDIO_LOAD_CANCELLED);
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(blockers.back()) == UNAUDIO_LOAD_LOADED);
+    UNAUDIO_CHECK(UNAudio_PlayInstance(queued) < 0);
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(ShutdownWithLoadsInFlight) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const std::vector<uint8_t> big = test::MakeSineWav(10 * 48000, 2, 48000);
+    std::vector<int32_t> handles;
+    for (int i = 0; i < 16; ++i) handles.push_back(LoadAsync(big, UNAUDIO_DECOMPRESS_ON_LOAD));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));   // let some start
+    UNAudio_Shutdown();
+
+    // Nothing is queued after Shutdown, and no handle survives it.
+    UNAUDIO_CHECK(LoadAsync(big, UNAUDIO_DECOMPRESS_ON_LOAD) == -1);
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(handles.front()) == UNAUDIO_LOAD_NONE);
+
+    // The engine comes back up clean.
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const int32_t handle = LoadAsync(big, UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAUDIO_CHECK(WaitForLoads({ handle }));
+    UNAUDIO_CHECK(UNAudio_GetLoadStatus(handle) == UNAUDIO_LOAD_LOADED);
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(ShutdownRacesApiCalls) {
+    // Loads, plays and promotions issued while the engine shuts down must
+    // either complete or fail, never touch a pool that is going away.
+    const std::vector<uint8_t> wav = test::MakeSineWav(4800, 2, 48000);
+    for (int round = 0; round < 20; ++round) {
+        UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+        const int32_t clip = UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()),
+                                               UNAUDIO_COMPRESS_IN_MEMORY);
+        UNAudio_SetAttackCache(clip, 20.0f);   // Play warms the decoder on the pool
+        // Over budget, every new load demotes the last one and replaying it
+        // queues a promotion.
+        UNAudio_SetMemoryBudget(1);
+        const int32_t demoted = UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()),
+                                                  UNAUDIO_DECOMPRESS_ON_LOAD);
+
+        std::atomic<bool> stop{false};
+        std::thread caller([&] {
+            while (!stop.load()) {
+                LoadAsync(wav, UNAUDIO_DECOMPRESS_ON_LOAD);
+                UNAudio_Play(clip);
+                UNAudio_Stop(clip);
+                UNAudio_PlayInstance(clip);
+                UNAudio_Play(demoted);
+                UNAudio_Stop(demoted);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        UNAudio_Shutdown();
+        stop = true;
+        caller.join();
+    }
+    UNAUDIO_CHECK(!UNAudio_IsInitialized());
+}
+
+int main() { return test::RunAll(); }
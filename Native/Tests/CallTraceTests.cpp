@@ -0,0 +1,172 @@
+// Call traces: the records, DSP clock, argument encoding, blob store and
+// ring of a recorded session.  The trace written by RecordSession is then
+// replayed by unaudio_replay (the CallTraceReplay test).
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Core/CallTrace.h"
+
+#include <cstdio>
+
+namespace {
+
+using TraceRecord = CallTrace::TraceRecord;
+
+const char* const kTracePath = "CallTraceTests.untr";
+const char* const kWrapPath  = "CallTraceTests.wrap.untr";
+constexpr int kBlockFrames = 256;
+
+/// Whole trace file, with accessors for its parts.
+struct TraceFile {
+    std::vector<uint8_t> bytes;
+
+    bool Read(const char* path) {
+        bytes.clear();
+        FILE* file = std::fopen(path, "rb");
+        if (!file) return false;
+        uint8_t chunk[4096];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            bytes.insert(bytes.end(), chunk, chunk + n);
+        std::fclose(file);
+        return bytes.size() >= sizeof(CallTrace::TraceFileHeader);
+    }
+
+    CallTrace::TraceFileHeader Header() const {
+        CallTrace::TraceFileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        return header;
+    }
+
+    /// Ring slot `slot` (not reordered).
+    TraceRecord Slot(uint64_t slot) const {
+        TraceRecord record;
+        std::memcpy(&record, bytes.data() + sizeof(CallTrace::TraceFileHeader) + slot * sizeof(record),
+                    sizeof(record));
+        return record;
+    }
+
+    /// Bytes of the blob at `offset`.
+    std::vector<uint8_t> Blob(uint64_t offset) const {
+        uint64_t size = 0;
+        if (offset + sizeof(size) > bytes.size()) return {};
+        std::memcpy(&size, bytes.data() + offset, sizeof(size));
+        if (size > bytes.size() - offset - sizeof(size)) return {};
+        const uint8_t* data = bytes.data() + offset + sizeof(size);
+        return std::vector<uint8_t>(data, data + size);
+    }
+};
+
+void Render(int blocks) {
+    std::vector<float> out(kBlockFrames * 2);
+    for (int i = 0; i < blocks; ++i) AudioEngine::Instance().Render(out.data(), kBlockFrames);
+}
+
+uint64_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+UNAUDIO_TEST(RecordSession) {
+    const UNAudioOutputConfig config{ 48000, 2, kBlockFrames, 2, 0 };
+    UNAUDIO_CHECK(UNAudio_Initialize(config) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_StartCallTrace(kTracePath, 0) == UNAUDIO_OK);
+
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000);
+    const int32_t size = static_cast<int32_t>(wav.size());
+    const int32_t a = UNAudio_LoadAudio(wav.data(), size, UNAUDIO_DECOMPRESS_ON_LOAD);
+    const int32_t b = UNAudio_LoadAudio(wav.data(), size, UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAudio_SetLoop(a, 1);
+    UNAudio_Play(a);
+    Render(10);
+    UNAudio_SetVolume(a, 0.5f);
+    const int32_t voice = UNAudio_PlayInstance(b);
+    UNAudio_SetVoiceVolume(voice, 0.25f);
+    Render(10);
+    UNAudio_Stop(a);
+    UNAudio_StopCallTrace();
+    UNAudio_Shutdown();
+
+    TraceFile trace;
+    UNAUDIO_CHECK(trace.Read(kTracePath));
+    if (trace.bytes.empty()) return;
+    const CallTrace::TraceFileHeader header = trace.Header();
+    UNAUDIO_CHECK(std::memcmp(header.magic, "UNTR", 4) == 0);
+    UNAUDIO_CHECK(header.version == CallTrace::kVersion);
+    UNAUDIO_CHECK(header.recordSize == sizeof(TraceRecord));
+    UNAUDIO_CHECK(header.blobEnd <= trace.bytes.size());
+
+    // Joining a running engine opens with a synthetic Initialize.
+    const TraceOp expected[] = {
+        TraceOp::Initialize, TraceOp::LoadAudio, TraceOp::LoadAudio, TraceOp::SetLoop,
+        TraceOp::Play, TraceOp::SetVolume, TraceOp::PlayInstance, TraceOp::SetVoiceVolume,
+        TraceOp::Stop,
+    };
+    const int64_t frames[] = { 0, 0, 0, 0, 0, 10 * kBlockFrames, 10 * kBlockFrames,
+                               10 * kBlockFrames, 20 * kBlockFrames };
+    const uint64_t count = sizeof(expected) / sizeof(expected[0]);
+    UNAUDIO_CHECK(header.recordCount == count);
+    if (header.recordCount != count) return;
+    for (uint64_t i = 0; i < count; ++i) {
+        UNAUDIO_CHECK(trace.Slot(i).op == static_cast<uint16_t>(expected[i]));
+        UNAUDIO_CHECK(trace.Slot(i).dspFrame == frames[i]);
+    }
+
+    // The config blob, and the header's copy of it for wrapped rings.
+    const TraceRecord init = trace.Slot(0);
+    UNAUDIO_CHECK(header.configBlob == init.args[0]);
+    const std::vector<uint8_t> stored = trace.Blob(init.args[0]);
+    UNAUDIO_CHECK(stored.size() == sizeof(config) && std::memcmp(stored.data(), &config, sizeof(config)) == 0);
+
+    // Clip data is stored once and referenced by both loads.
+    const TraceRecord loadA = trace.Slot(1), loadB = trace.Slot(2);
+    UNAUDIO_CHECK(loadA.args[0] == loadB.args[0]);
+    UNAUDIO_CHECK(trace.Blob(loadA.args[0]) == wav);
+    UNAUDIO_CHECK(static_cast<int32_t>(loadA.result) == a && static_cast<int32_t>(loadB.result) == b);
+    UNAUDIO_CHECK(loadA.args[1] == UNAUDIO_DECOMPRESS_ON_LOAD && loadB.args[1] == UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAUDIO_CHECK(header.blobEnd - header.blobOffset < 2 * wav.size());
+
+    // Integers and float bits.
+    UNAUDIO_CHECK(static_cast<int32_t>(trace.Slot(5).args[0]) == a);
+    UNAUDIO_CHECK(trace.Slot(5).args[1] == FloatBits(0.5f));
+    UNAUDIO_CHECK(static_cast<int32_t>(trace.Slot(6).result) == voice);
+    UNAUDIO_CHECK(trace.Slot(7).args[1] == FloatBits(0.25f));
+}
+
+UNAUDIO_TEST(RingKeepsNewestCalls) {
+    const UNAudioOutputConfig config{ 44100, 1, 128, 2, 0 };
+    UNAUDIO_CHECK(UNAudio_Initialize(config) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_StartCallTrace(kWrapPath, 4) == UNAUDIO_OK);
+    for (int i = 0; i < 10; ++i) UNAudio_SetMasterVolume(i / 10.0f);
+    UNAudio_StopCallTrace();
+    UNAudio_Shutdown();
+
+    TraceFile trace;
+    UNAUDIO_CHECK(trace.Read(kWrapPath));
+    if (trace.bytes.empty()) return;
+    const CallTrace::TraceFileHeader header = trace.Header();
+    UNAUDIO_CHECK(header.capacity == 4);
+    UNAUDIO_CHECK(header.recordCount == 11);
+    // Oldest surviving record sits at recordCount % capacity: volumes 6..9.
+    for (uint64_t i = 0; i < 4; ++i) {
+        const TraceRecord record = trace.Slot((header.recordCount + i) % header.capacity);
+        UNAUDIO_CHECK(record.op == static_cast<uint16_t>(TraceOp::SetMasterVolume));
+        UNAUDIO_CHECK(record.args[0] == FloatBits((6 + static_cast<int>(i)) / 10.0f));
+    }
+    // The overwritten Initialize survives in the header.
+    const std::vector<uint8_t> stored = trace.Blob(header.configBlob);
+    UNAUDIO_CHECK(stored.size() == sizeof(config) && std::memcmp(stored.data(), &config, sizeof(config)) == 0);
+    std::remove(kWrapPath);
+}
+
+UNAUDIO_TEST(StartRejectsBadArguments) {
+    UNAUDIO_CHECK(UNAudio_StartCallTrace(kWrapPath, -1) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_StartCallTrace(nullptr, 0) != UNAUDIO_OK);
+    UNAUDIO_CHECK(!CallTrace::IsActive());
+}
+
+// kTracePath is left in place for CallTraceReplay.
+int main() { return test::RunAll(); }
@@ -0,0 +1,204 @@
+// Clip banks: UNAudio_WriteBank -> ClipBank::Open -> index lookup and
+// LoadFromBank, and rejection of damaged files.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Core/ClipBank.h"
+
+#include <cstddef>
+#include <cstdio>
+
+namespace {
+
+const char* const kBankPath = "ClipBankTests.unab";
+
+/// Three clips of different lengths, channel counts and rates.
+struct Clips {
+    std::vector<std::vector<uint8_t>> files = {
+        test::MakeSineWav(1000, 1, 48000),
+        test::MakeSineWav(4410, 2, 44100, 1000.0),
+        test::MakeSineWav(7, 2, 22050),
+    };
+
+    UNAudioResult Write(const char* path) const {
+        std::vector<uint8_t> packed;
+        std::vector<int32_t> sizes;
+        for (const auto& file : files) {
+            packed.insert(packed.end(), file.begin(), file.end());
+            sizes.push_back(static_cast<int32_t>(file.size()));
+        }
+        return static_cast<UNAudioResult>(UNAudio_WriteBank(path, packed.data(), sizes.data(),
+                                                            static_cast<int32_t>(sizes.size())));
+    }
+};
+
+std::vector<uint8_t> ReadFile(const char* path) {
+    std::vector<uint8_t> bytes;
+    if (FILE* file = std::fopen(path, "rb")) {
+        uint8_t chunk[4096];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            bytes.insert(bytes.end(), chunk, chunk + n);
+        std::fclose(file);
+    }
+    return bytes;
+}
+
+void WriteFile(const char* path, const std::vector<uint8_t>& bytes) {
+    if (FILE* file = std::fopen(path, "wb")) {
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+}
+
+/// Write `bytes` with `patch` applied at `offset`, and try to open the result.
+template <typename T>
+bool OpensWithPatch(const std::vector<uint8_t>& bytes, size_t offset, T patch) {
+    std::vector<uint8_t> damaged = bytes;
+    std::memcpy(&damaged[offset], &patch, sizeof(patch));
+    WriteFile("ClipBankTests.damaged.unab", damaged);
+    return ClipBank::Open("ClipBankTests.damaged.unab") != nullptr;
+}
+
+size_t EntryField(int index, size_t fieldOffset) {
+    return sizeof(ClipBank::BankHeader) + index * sizeof(ClipBank::BankEntry) + fieldOffset;
+}
+
+} // namespace
+
+UNAUDIO_TEST(WriteThenLookUp) {
+    const Clips clips;
+    UNAUDIO_CHECK(clips.Write(kBankPath) == UNAUDIO_OK);
+
+    auto bank = ClipBank::Open(kBankPath);
+    UNAUDIO_CHECK(bank != nullptr);
+    if (!bank) return;
+    UNAUDIO_CHECK(bank->GetClipCount() == 3);
+    UNAUDIO_CHECK(bank->GetEntry(-1) == nullptr);
+    UNAUDIO_CHECK(bank->GetEntry(3) == nullptr);
+
+    const int64_t frames[] = { 1000, 4410, 7 };
+    const int32_t rates[] = { 48000, 44100, 22050 };
+    const int16_t channels[] = { 1, 2, 2 };
+    for (int i = 0; i < 3; ++i) {
+        const ClipBank::BankEntry* entry = bank->GetEntry(i);
+        UNAUDIO_CHECK(entry != nullptr);
+        if (!entry) continue;
+        UNAUDIO_CHECK(entry->dataOffset % ClipBank::kAlignment == 0);
+        UNAUDIO_CHECK(entry->totalFrames == frames[i]);
+        UNAUDIO_CHECK(entry->sampleRate == rates[i]);
+        UNAUDIO_CHECK(entry->channels == channels[i]);
+        // Payloads are stored verbatim.
+        UNAUDIO_CHECK(entry->dataSize == clips.files[i].size());
+        UNAUDIO_CHECK(std::memcmp(bank->GetClipData(*entry), clips.files[i].data(),
+                                  clips.files[i].size()) == 0);
+    }
+}
+
+UNAUDIO_TEST(LoadFromBankMatchesClip) {
+    const Clips clips;
+    UNAUDIO_CHECK(clips.Write(kBankPath) == UNAUDIO_OK);
+
+    const int32_t bankId = UNAudio_OpenBank(kBankPath);
+    UNAUDIO_CHECK(bankId >= 0);
+    UNAUDIO_CHECK(UNAudio_GetBankClipCount(bankId) == 3);
+
+    for (int32_t mode : { UNAUDIO_DECOMPRESS_ON_LOAD, UNAUDIO_COMPRESS_IN_MEMORY }) {
+        const int32_t handle = UNAudio_LoadFromBank(bankId, 1, mode);
+        UNAUDIO_CHECK(handle >= 0);
+        const UNAudioClipInfo info = UNAudio_GetClipInfo(handle);
+        UNAUDIO_CHECK(info.sampleRate == 44100);
+        UNAUDIO_CHECK(info.channels == 2);
+        UNAUDIO_CHECK(info.totalFrames == 4410);
+        UNAudio_UnloadAudio(handle);
+    }
+    UNAUDIO_CHECK(UNAudio_LoadFromBank(bankId, 3, UNAUDIO_DECOMPRESS_ON_LOAD) < 0);
+    UNAUDIO_CHECK(UNAudio_LoadFromBank(bankId + 1, 0, UNAUDIO_DECOMPRESS_ON_LOAD) < 0);
+
+    // Loaded clips outlive the bank; the bank itself is gone.
+    const int32_t kept = UNAudio_LoadFromBank(bankId, 0, UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAudio_CloseBank(bankId);
+    UNAUDIO_CHECK(UNAudio_GetClipInfo(kept).totalFrames == 1000);
+    UNAUDIO_CHECK(UNAudio_GetBankClipCount(bankId) == 0);
+    UNAUDIO_CHECK(UNAudio_LoadFromBank(bankId, 0, UNAUDIO_DECOMPRESS_ON_LOAD) < 0);
+}
+
+UNAUDIO_TEST(RejectsCorruptHeader) {
+    const Clips clips;
+    UNAUDIO_CHECK(clips.Write(kBankPath) == UNAUDIO_OK);
+    const std::vector<uint8_t> bytes = ReadFile(kBankPath);
+    UNAUDIO_CHECK(bytes.size() > 256);
+    if (bytes.size() <= 256) return;
+
+    using Header = ClipBank::BankHeader;
+    using Entry = ClipBank::BankEntry;
+    UNAUDIO_CHECK(OpensWithPatch(bytes, 0, bytes[0]));                       // unchanged
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, offsetof(Header, magic), 'X'));
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, offsetof(Header, version), ClipBank::kVersion + 1));
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, offsetof(Header, clipCount), 0x10000000u));
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, offsetof(Header, dataAlignment), 0u));
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, offsetof(Header, dataAlignment), 48u));
+    // Entries pointing inside the index, off alignment or past the end.
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, EntryField(1, offsetof(Entry, dataOffset)), uint64_t{0}));
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, EntryField(1, offsetof(Entry, dataOffset)),
+                                  uint64_t{ClipBank::kAlignment * 4 + 1}));
+    UNAUDIO_CHECK(!OpensWithPatch(bytes, EntryField(2, offsetof(Entry, dataSize)),
+                                  uint64_t{bytes.size()}));
+
+    // Truncated files, down to a partial header.
+    for (size_t size : { bytes.size() - 1, sizeof(Header) + sizeof(Entry), sizeof(Header) - 1 }) {
+        WriteFile("ClipBankTests.damaged.unab", std::vector<uint8_t>(bytes.begin(), bytes.begin() + size));
+        UNAUDIO_CHECK(ClipBank::Open("ClipBankTests.damaged.unab") == nullptr);
+    }
+    UNAUDIO_CHECK(ClipBank::Open("ClipBankTests.missing.unab") == nullptr);
+}
+
+UNAUDIO_TEST(RejectsStaleIndex) {
+    const Clips clips;
+    UNAUDIO_CHECK(clips.Write(kBankPath) == UNAUDIO_OK);
+    const std::vector<uint8_t> bytes = ReadFile(kBankPath);
+    if (bytes.size() <= 256) return;
+
+    // Each file opens fine, but clip 0's entry no longer describes its
+    // payload: every mode refuses it, before decoding or transcoding.
+    using Entry = ClipBank::BankEntry;
+    const auto stale = [&](size_t field, auto value) {
+        std::vector<uint8_t> damaged = bytes;
+        std::memcpy(&damaged[EntryField(0, field)], &value, sizeof(value));
+        WriteFile("ClipBankTests.damaged.unab", damaged);
+        const int32_t bankId = UNAudio_OpenBank("ClipBankTests.damaged.unab");
+        UNAUDIO_CHECK(bankId >= 0);
+        for (int32_t mode : { UNAUDIO_DECOMPRESS_ON_LOAD, UNAUDIO_COMPRESS_IN_MEMORY,
+                              UNAUDIO_STREAMING, UNAUDIO_ADPCM_IN_MEMORY })
+            UNAUDIO_CHECK(UNAudio_LoadFromBank(bankId, 0, mode) < 0);
+        UNAUDIO_CHECK(UNAudio_LoadFromBank(bankId, 1, UNAUDIO_DECOMPRESS_ON_LOAD) >= 0);
+        UNAudio_CloseBank(bankId);
+    };
+    stale(offsetof(Entry, totalFrames), int64_t{999});
+    stale(offsetof(Entry, sampleRate), int32_t{44100});
+    stale(offsetof(Entry, channels), int16_t{2});
+    stale(offsetof(Entry, format), static_cast<uint16_t>(AudioFileFormat::ADPCM));
+}
+
+UNAUDIO_TEST(WriteRejectsBadInput) {
+    const std::vector<uint8_t> wav = test::MakeSineWav(100, 1, 48000);
+    const std::vector<uint8_t> junk(64, 0x5A);
+    const int32_t wavSize = static_cast<int32_t>(wav.size());
+    const int32_t junkSize = static_cast<int32_t>(junk.size());
+    const int32_t zero = 0;
+    UNAUDIO_CHECK(UNAudio_WriteBank(kBankPath, junk.data(), &junkSize, 1) ==
+                  UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED);
+    UNAUDIO_CHECK(UNAudio_WriteBank(kBankPath, wav.data(), &zero, 1) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_WriteBank(kBankPath, wav.data(), &wavSize, 0) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_WriteBank(nullptr, wav.data(), &wavSize, 1) == UNAUDIO_ERROR_INVALID_PARAM);
+}
+
+int main() {
+    const UNAudioOutputConfig config{ 48000, 2, 256, 2, 0 };
+    if (UNAudio_Initialize(config) != UNAUDIO_OK) return 1;
+    const int result = test::RunAll();
+    UNAudio_Shutdown();
+    std::remove(kBankPath);
+    std::remove("ClipBankTests.damaged.unab");
+    return result;
+}
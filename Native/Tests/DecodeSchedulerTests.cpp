@@ -0,0 +1,176 @@
+// Decode-ahead: a stream returns exactly the decoder's output across seeks,
+// and the engine renders the same samples with workers as without.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Core/DecodeScheduler.h"
+#include "Decoder/AudioDecoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+/// Mono decoder whose frame n (0-based) is n + 1, so every sample names its
+/// own position.
+class CountingDecoder : public AudioDecoder {
+public:
+    explicit CountingDecoder(int64_t total) : total_(total) {}
+
+    bool Open(const uint8_t*, size_t) override { return true; }
+    int Decode(float* buffer, int frameCount) override {
+        const int frames = static_cast<int>(std::min<int64_t>(frameCount, total_ - position_));
+        for (int i = 0; i < frames; ++i) buffer[i] = static_cast<float>(position_ + i + 1);
+        position_ += frames;
+        return frames;
+    }
+    bool Seek(int64_t frame) override {
+        position_ = frame;
+        return true;
+    }
+    UNAudioFormat GetFormat() const override { return UNAudioFormat{}; }
+    bool SupportsStreaming() const override { return true; }
+    int64_t GetTotalFrames() const override { return total_; }
+    size_t GetStateSize() const override { return sizeof(*this); }
+
+private:
+    int64_t total_;
+    int64_t position_ = 0;
+};
+
+constexpr int kBlock = 256;
+
+/// Renders a fixed scenario of compressed voices (loops, restarts, voices
+/// stopped and replaced, an attack cache) and returns every output sample.
+std::vector<float> RenderScenario(int32_t decodeThreads, int paceMicros, UNAudioDecodeStats& stats) {
+    UNAudio_SetDecodeThreads(decodeThreads);
+    const UNAudioOutputConfig config{ 48000, 2, kBlock, 2, 0 };
+    if (UNAudio_Initialize(config) != UNAUDIO_OK) return {};
+
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000 + 123, 2, 48000);
+    const int32_t wavSize = static_cast<int32_t>(wav.size());
+    std::vector<uint8_t> adpcm(static_cast<size_t>(UNAudio_TranscodeADPCM(wav.data(), wavSize, nullptr, 0)));
+    UNAudio_TranscodeADPCM(wav.data(), wavSize, adpcm.data(), static_cast<int32_t>(adpcm.size()));
+
+    const int32_t looped = UNAudio_LoadAudio(adpcm.data(), static_cast<int32_t>(adpcm.size()),
+                                             UNAUDIO_COMPRESS_IN_MEMORY);
+    const int32_t cached = UNAudio_LoadAudio(adpcm.data(), static_cast<int32_t>(adpcm.size()),
+                                             UNAUDIO_COMPRESS_IN_MEMORY);
+    const int32_t pcm = UNAudio_LoadAudio(wav.data(), wavSize, UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAudio_SetAttackCache(cached, 30.0f);
+    UNAudio_SetLoop(looped, 1);
+    UNAudio_Play(looped);
+
+    const int32_t clips[] = { looped, cached, pcm };
+    std::vector<int32_t> voices;
+    for (int i = 0; i < 24; ++i) {
+        voices.push_back(UNAudio_PlayInstance(clips[i % 3]));
+        UNAudio_SetVoiceVolume(voices.back(), 0.02f);
+    }
+
+    std::vector<float> output;
+    std::vector<float> block(kBlock * 2);
+    for (int b = 0; b < 300; ++b) {
+        if (b == 100) UNAudio_Stop(looped);
+        if (b == 120) UNAudio_Play(looped);
+        if (b == 150) {
+            for (size_t i = 0; i < voices.size(); i += 3) {
+                UNAudio_StopVoice(voices[i]);
+                voices[i] = UNAudio_PlayInstance(cached);
+                UNAudio_SetVoiceVolume(voices[i], 0.02f);
+            }
+        }
+        AudioEngine::Instance().Render(block.data(), kBlock);
+        output.insert(output.end(), block.begin(), block.end());
+        if (paceMicros > 0) std::this_thread::sleep_for(std::chrono::microseconds(paceMicros));
+    }
+
+    stats = UNAudio_GetDecodeStats();
+    UNAudio_Shutdown();
+    return output;
+}
+
+} // namespace
+
+UNAUDIO_TEST(StreamFollowsDecoderAcrossSeeks) {
+    DecodeScheduler scheduler(3, 64);
+    CountingDecoder decoder(int64_t{1} << 30);
+    DecodeStream stream;
+    stream.Attach(scheduler, &decoder, 1);
+    UNAUDIO_CHECK(stream.IsAttached());
+    stream.Reposition(0);
+
+    std::vector<float> buffer(64);
+    int64_t expected = 1;
+    int64_t wrong = 0;
+    uint32_t seed = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        if ((seed >> 24) < 5) {
+            const int64_t frame = (seed >> 8) % 100000;
+            stream.Reposition(frame);
+            expected = frame + 1;
+        }
+        // A short read (a stalled worker) resumes where it stopped.
+        const int got = stream.Read(buffer.data(), 64);
+        UNAUDIO_CHECK(got == 64 || stream.Stalled());
+        for (int f = 0; f < got; ++f) {
+            if (buffer[static_cast<size_t>(f)] != static_cast<float>(expected)) {
+                ++wrong;
+                expected = static_cast<int64_t>(buffer[static_cast<size_t>(f)]);
+            }
+            ++expected;
+        }
+        stream.Request();
+        if (i % 8 == 0) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    UNAUDIO_CHECK(wrong == 0);
+
+    const UNAudioDecodeStats stats = scheduler.GetStats();
+    UNAUDIO_CHECK(stats.aheadFrames > 0);
+    stream.Detach();
+    UNAUDIO_CHECK(!stream.IsAttached());
+}
+
+UNAUDIO_TEST(StreamEndsWithDecoder) {
+    DecodeScheduler scheduler(1, 64);
+    CountingDecoder decoder(1000);
+    DecodeStream stream;
+    stream.Attach(scheduler, &decoder, 1);
+    stream.Reposition(900);
+
+    std::vector<float> buffer(64);
+    int64_t frames = 0;
+    int got;
+    while ((got = stream.Read(buffer.data(), 64)) == 64) {
+        frames += got;
+        stream.Request();
+    }
+    frames += got;
+    UNAUDIO_CHECK(frames == 100);
+    UNAUDIO_CHECK(buffer[static_cast<size_t>(got) - 1] == 1000.0f);
+    UNAUDIO_CHECK(stream.Read(buffer.data(), 64) == 0);
+}
+
+UNAUDIO_TEST(WorkersRenderLikeInlineDecode) {
+    UNAudioDecodeStats inlineStats{}, pacedStats{}, unpacedStats{};
+    const std::vector<float> reference = RenderScenario(0, 0, inlineStats);
+    UNAUDIO_CHECK(!reference.empty());
+    UNAUDIO_CHECK(inlineStats.workerCount == 0 && inlineStats.aheadFrames == 0);
+
+    // Real-time pacing gives the workers time to decode ahead.
+    const std::vector<float> paced = RenderScenario(2, 2000, pacedStats);
+    UNAUDIO_CHECK(pacedStats.workerCount == 2);
+    UNAUDIO_CHECK(pacedStats.aheadFrames > 0);
+    UNAUDIO_CHECK(pacedStats.dropouts == 0);
+    UNAUDIO_CHECK(paced == reference);
+
+    // Back to back, the mixer catches up with the workers and decodes inline,
+    // waiting for a chunk a worker has in flight rather than padding.
+    const std::vector<float> unpaced = RenderScenario(-1, 0, unpacedStats);
+    UNAUDIO_CHECK(unpacedStats.dropouts == 0);
+    UNAUDIO_CHECK(unpaced == reference);
+}
+
+int main() { return test::RunAll(); }
@@ -0,0 +1,136 @@
+// Gain automation: linear and equal-power curves hit their endpoints
+// exactly, follow the curve across block boundaries, and pair up to
+// constant power.
+
+#include "TestHarness.h"
+#include "Mixer/GainRamp.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr double kHalfPi = 1.57079632679489661923;
+
+/// Render `total` frames in blocks of `block`; idle blocks repeat Value().
+std::vector<float> RenderFrames(GainRamp& ramp, int total, int block) {
+    std::vector<float> gains(static_cast<size_t>(total));
+    for (int done = 0; done < total; done += block) {
+        const int frames = std::min(block, total - done);
+        if (!ramp.Render(gains.data() + done, frames))
+            std::fill(gains.begin() + done, gains.begin() + done + frames, ramp.Value());
+    }
+    return gains;
+}
+
+} // namespace
+
+UNAUDIO_TEST(IdleAndJump) {
+    GainRamp ramp(0.25f);
+    float gains[16];
+    UNAUDIO_CHECK(!ramp.Render(gains, 16));
+    UNAUDIO_CHECK(ramp.Value() == 0.25f);
+    UNAUDIO_CHECK(ramp.IsIdleAt(0.25f));
+
+    // frames = 0 jumps; the request is only seen by the next block.
+    ramp.Set(0.75f, 0);
+    UNAUDIO_CHECK(ramp.GetTarget() == 0.75f);
+    UNAUDIO_CHECK(!ramp.IsIdleAt(0.75f));
+    UNAUDIO_CHECK(!ramp.Render(gains, 16));
+    UNAUDIO_CHECK(ramp.Value() == 0.75f);
+    UNAUDIO_CHECK(ramp.IsIdleAt(0.75f));
+}
+
+UNAUDIO_TEST(LinearEndpoints) {
+    GainRamp ramp(0.0f);
+    ramp.Set(1.0f, 100, UNAUDIO_FADE_LINEAR);
+    float gains[256];
+    UNAUDIO_CHECK(ramp.Render(gains, 256));
+    // Frame i carries the gain after i + 1 steps; the last ramped frame is the target.
+    UNAUDIO_CHECK_NEAR(gains[0], 0.01, 1e-7);
+    UNAUDIO_CHECK_NEAR(gains[49], 0.5, 1e-7);
+    UNAUDIO_CHECK(gains[99] == 1.0f);
+    UNAUDIO_CHECK(gains[100] == 1.0f && gains[255] == 1.0f);
+    UNAUDIO_CHECK(ramp.Value() == 1.0f);
+    UNAUDIO_CHECK(!ramp.Render(gains, 256));
+    UNAUDIO_CHECK(ramp.IsIdleAt(1.0f));
+
+    // Downward, from an explicit start.
+    ramp.Set(0.2f, 4, UNAUDIO_FADE_LINEAR, 1.0f);
+    UNAUDIO_CHECK(ramp.Render(gains, 4));
+    UNAUDIO_CHECK_NEAR(gains[0], 0.8, 1e-7);
+    UNAUDIO_CHECK_NEAR(gains[1], 0.6, 1e-7);
+    UNAUDIO_CHECK_NEAR(gains[2], 0.4, 1e-7);
+    UNAUDIO_CHECK(gains[3] == 0.2f);
+}
+
+UNAUDIO_TEST(LinearAcrossBlocks) {
+    GainRamp ramp(0.0f);
+    ramp.Set(2.0f, 1000, UNAUDIO_FADE_LINEAR);
+    const std::vector<float> gains = RenderFrames(ramp, 1100, 64);
+    double worst = 0.0;
+    for (int i = 0; i < 1000; ++i)
+        worst = std::max(worst, std::fabs(gains[static_cast<size_t>(i)] - 2.0 * (i + 1) / 1000.0));
+    UNAUDIO_CHECK(worst < 1e-6);
+    UNAUDIO_CHECK(gains[999] == 2.0f && gains[1099] == 2.0f);
+}
+
+UNAUDIO_TEST(EqualPowerEndpoints) {
+    const int length = 480;
+    GainRamp rising(0.0f), falling(1.0f);
+    rising.Set(1.0f, length, UNAUDIO_FADE_EQUAL_POWER);
+    falling.Set(0.0f, length, UNAUDIO_FADE_EQUAL_POWER);
+    const std::vector<float> in = RenderFrames(rising, length + 32, 128);
+    const std::vector<float> out = RenderFrames(falling, length + 32, 128);
+
+    UNAUDIO_CHECK_NEAR(in[0], std::sin(kHalfPi / length), 1e-6);
+    UNAUDIO_CHECK_NEAR(out[0], std::cos(kHalfPi / length), 1e-6);
+    UNAUDIO_CHECK_NEAR(in[length / 2 - 1], std::sqrt(0.5), 1e-6);
+    UNAUDIO_CHECK_NEAR(out[length / 2 - 1], std::sqrt(0.5), 1e-6);
+    UNAUDIO_CHECK_NEAR(in[length - 1], 1.0, 1e-6);
+    UNAUDIO_CHECK_NEAR(out[length - 1], 0.0, 1e-6);
+    // Settled values are exact, whatever the rotation accumulated.
+    UNAUDIO_CHECK(rising.Value() == 1.0f && in[length + 31] == 1.0f);
+    UNAUDIO_CHECK(falling.Value() == 0.0f && out[length + 31] == 0.0f);
+
+    // A crossfade pair keeps the summed power at unity on every frame.
+    double worst = 0.0;
+    for (int i = 0; i < length; ++i) {
+        const double power = static_cast<double>(in[static_cast<size_t>(i)]) * in[static_cast<size_t>(i)] +
+                             static_cast<double>(out[static_cast<size_t>(i)]) * out[static_cast<size_t>(i)];
+        worst = std::max(worst, std::fabs(power - 1.0));
+    }
+    UNAUDIO_CHECK(worst < 1e-5);
+}
+
+UNAUDIO_TEST(EqualPowerLongRampStaysOnCurve) {
+    // Ten seconds at 48 kHz in 256-frame blocks: the per-frame rotation must
+    // not drift away from sin().
+    const int length = 480000;
+    GainRamp ramp(0.5f);
+    ramp.Set(1.5f, length, UNAUDIO_FADE_EQUAL_POWER);
+    const std::vector<float> gains = RenderFrames(ramp, length, 256);
+    double worst = 0.0;
+    for (int i = 0; i < length; ++i) {
+        const double expected = 0.5 + std::sin(kHalfPi * (i + 1) / length);
+        worst = std::max(worst, std::fabs(gains[static_cast<size_t>(i)] - expected));
+    }
+    UNAUDIO_CHECK(worst < 1e-5);
+    UNAUDIO_CHECK(ramp.Value() == 1.5f);
+}
+
+UNAUDIO_TEST(NewestRequestWins) {
+    GainRamp ramp(1.0f);
+    ramp.Set(0.0f, 1000, UNAUDIO_FADE_LINEAR);
+    ramp.Set(0.5f, 10, UNAUDIO_FADE_LINEAR);
+    float gains[16];
+    UNAUDIO_CHECK(ramp.Render(gains, 16));
+    UNAUDIO_CHECK_NEAR(gains[0], 0.95, 1e-7);
+    UNAUDIO_CHECK(gains[9] == 0.5f);
+
+    // kFromCurrent restarts from wherever the last block ended.
+    ramp.Set(1.0f, 100, UNAUDIO_FADE_LINEAR);
+    UNAUDIO_CHECK(ramp.Render(gains, 1));
+    UNAUDIO_CHECK_NEAR(gains[0], 0.505, 1e-7);
+}
+
+int main() { return test::RunAll(); }
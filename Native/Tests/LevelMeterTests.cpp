@@ -0,0 +1,199 @@
+// Level meter: LUFS and true peak on sines with known BS.1770 readings,
+// gating in the style of EBU Tech 3341, windows and flags, and a voice meter
+// following its gain ramp.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Mixer/LevelMeter.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr int kBlock = 256;
+
+/// Feeds a meter with a sine, block by block, keeping the phase running.
+struct SineFeed {
+    LevelMeter& meter;
+    int sampleRate;
+    int channels;
+    uint32_t flags = UNAUDIO_METER_ALL;
+    double phase = 0.0;
+
+    /// `seconds` of a sine at `dbfs` peak on every channel (or silence).
+    void Play(double seconds, double dbfs, double frequency = 997.0, float gain = 1.0f) {
+        const double amplitude = std::isinf(dbfs) ? 0.0 : std::pow(10.0, dbfs / 20.0);
+        const double step = 2.0 * kPi * frequency / sampleRate;
+        std::vector<float> block(static_cast<size_t>(kBlock) * channels);
+        for (int64_t left = static_cast<int64_t>(seconds * sampleRate); left > 0; left -= kBlock) {
+            const int frames = static_cast<int>(std::min<int64_t>(kBlock, left));
+            for (int f = 0; f < frames; ++f, phase += step)
+                for (int c = 0; c < channels; ++c)
+                    block[static_cast<size_t>(f) * channels + c] =
+                        static_cast<float>(amplitude * std::sin(phase));
+            meter.Process(block.data(), frames, channels, gain, flags);
+        }
+    }
+};
+
+} // namespace
+
+UNAUDIO_TEST(FullScaleStereoSine) {
+    // BS.1770: a 0 dBFS 997 Hz sine on L and R reads 0 LUFS (-3.01 per channel).
+    LevelMeter meter(48000);
+    SineFeed feed{ meter, 48000, 2 };
+    feed.Play(5.0, 0.0);
+    const UNAudioLevels levels = meter.Read();
+    UNAUDIO_CHECK_NEAR(levels.rms, std::sqrt(0.5), 1e-3);
+    UNAUDIO_CHECK_NEAR(levels.peak, 1.0, 1e-3);
+    UNAUDIO_CHECK_NEAR(levels.momentaryLufs, 0.0, 0.1);
+    UNAUDIO_CHECK_NEAR(levels.shortTermLufs, 0.0, 0.1);
+    UNAUDIO_CHECK_NEAR(levels.integratedLufs, 0.0, 0.1);
+    UNAUDIO_CHECK(levels.truePeak >= levels.peak && levels.truePeak < 1.02f);
+}
+
+UNAUDIO_TEST(MonoSineReadsThreeDbLower) {
+    LevelMeter meter(48000);
+    SineFeed feed{ meter, 48000, 1 };
+    feed.Play(5.0, 0.0);
+    UNAUDIO_CHECK_NEAR(meter.Read().integratedLufs, -3.01, 0.1);
+}
+
+UNAUDIO_TEST(GainScalesReadings) {
+    LevelMeter meter(48000);
+    SineFeed feed{ meter, 48000, 2 };
+    feed.Play(5.0, 0.0, 997.0, 0.1f);
+    const UNAudioLevels levels = meter.Read();
+    UNAUDIO_CHECK_NEAR(levels.rms, 0.1 * std::sqrt(0.5), 1e-4);
+    UNAUDIO_CHECK_NEAR(levels.peak, 0.1, 1e-4);
+    UNAUDIO_CHECK_NEAR(levels.momentaryLufs, -20.0, 0.1);
+    UNAUDIO_CHECK_NEAR(levels.integratedLufs, -20.0, 0.1);
+}
+
+UNAUDIO_TEST(Tech3341ConstantLevels) {
+    // Cases 1 and 2: 20 s stereo 1 kHz at -23 and -33 LUFS.
+    for (double lufs : { -23.0, -33.0 }) {
+        LevelMeter meter(48000);
+        SineFeed feed{ meter, 48000, 2 };
+        feed.Play(20.0, lufs, 1000.0);
+        const UNAudioLevels levels = meter.Read();
+        UNAUDIO_CHECK_NEAR(levels.momentaryLufs, lufs, 0.1);
+        UNAUDIO_CHECK_NEAR(levels.shortTermLufs, lufs, 0.1);
+        UNAUDIO_CHECK_NEAR(levels.integratedLufs, lufs, 0.1);
+    }
+}
+
+UNAUDIO_TEST(Tech3341Gating) {
+    // Case 4: -36 / -23 / -36 LUFS for 10 / 60 / 10 s integrates to -23; the
+    // quiet parts fall under the relative gate.
+    LevelMeter meter(48000);
+    SineFeed feed{ meter, 48000, 2 };
+    feed.Play(10.0, -36.0, 1000.0);
+    feed.Play(60.0, -23.0, 1000.0);
+    feed.Play(10.0, -36.0, 1000.0);
+    UNAUDIO_CHECK_NEAR(meter.Read().integratedLufs, -23.0, 0.1);
+
+    // Silence falls under the absolute gate and leaves the integral alone.
+    meter.Reset();
+    feed.Play(20.0, -20.0);
+    feed.Play(20.0, -std::numeric_limits<double>::infinity());
+    const UNAudioLevels levels = meter.Read();
+    UNAUDIO_CHECK_NEAR(levels.integratedLufs, -20.0, 0.1);
+    UNAUDIO_CHECK(std::isinf(levels.momentaryLufs) && levels.momentaryLufs < 0.0f);
+    UNAUDIO_CHECK(std::isinf(levels.shortTermLufs) && levels.shortTermLufs < 0.0f);
+}
+
+UNAUDIO_TEST(WindowsFollowTheSignal) {
+    LevelMeter meter(48000);
+    SineFeed feed{ meter, 48000, 2 };
+    feed.Play(3.0, -20.0);
+    // 1 s after the level drops 20 dB the 400 ms window has fully moved on,
+    // the 3 s window has not.
+    feed.Play(1.0, -40.0);
+    const UNAudioLevels levels = meter.Read();
+    UNAUDIO_CHECK_NEAR(levels.momentaryLufs, -40.0, 0.1);
+    UNAUDIO_CHECK(levels.shortTermLufs > -30.0f && levels.shortTermLufs < -20.0f);
+    UNAUDIO_CHECK_NEAR(levels.peak, std::pow(10.0, -2.0), 1e-4);
+}
+
+UNAUDIO_TEST(TruePeakBetweenSamples) {
+    // fs/4 sine at 45 degrees: every sample sits at 0.707 of a 0 dBFS peak
+    // that falls exactly between them.
+    LevelMeter meter(48000);
+    std::vector<float> block(kBlock);
+    for (int i = 0; i < kBlock; ++i)
+        block[static_cast<size_t>(i)] = static_cast<float>(std::sin(kPi / 2.0 * i + kPi / 4.0));
+    for (int i = 0; i < 20; ++i) meter.Process(block.data(), kBlock, 1, 1.0f, UNAUDIO_METER_ALL);
+    UNAudioLevels levels = meter.Read();
+    UNAUDIO_CHECK_NEAR(levels.peak, std::sqrt(0.5), 1e-4);
+    // BS.1770 allows the 4x interpolator to read within about 0.5 dB of the true peak.
+    UNAUDIO_CHECK(levels.truePeak > 0.95f && levels.truePeak < 1.05f);
+
+    // Without the flag, true peak reports the sample peak.
+    LevelMeter plain(48000);
+    for (int i = 0; i < 20; ++i) plain.Process(block.data(), kBlock, 1, 1.0f, UNAUDIO_METER_LOUDNESS);
+    levels = plain.Read();
+    UNAUDIO_CHECK(levels.truePeak == levels.peak);
+}
+
+UNAUDIO_TEST(OtherSampleRates) {
+    for (int rate : { 44100, 96000 }) {
+        LevelMeter meter(rate);
+        SineFeed feed{ meter, rate, 2 };
+        feed.Play(5.0, -23.0);
+        UNAUDIO_CHECK_NEAR(meter.Read().integratedLufs, -23.0, 0.1);
+    }
+}
+
+UNAUDIO_TEST(SilenceAndFlags) {
+    const UNAudioLevels silence = LevelMeter::Silence();
+    UNAUDIO_CHECK(silence.rms == 0.0f && silence.peak == 0.0f && silence.truePeak == 0.0f);
+    UNAUDIO_CHECK(std::isinf(silence.integratedLufs) && silence.integratedLufs < 0.0f);
+
+    // Loudness is not metered without UNAUDIO_METER_LOUDNESS.
+    LevelMeter meter(48000);
+    SineFeed feed{ meter, 48000, 2, 0u };
+    feed.Play(1.0, -6.0);
+    const UNAudioLevels levels = meter.Read();
+    UNAUDIO_CHECK_NEAR(levels.peak, std::pow(10.0, -6.0 / 20.0), 1e-4);
+    UNAUDIO_CHECK(std::isinf(levels.momentaryLufs) && std::isinf(levels.integratedLufs));
+
+    // Reset drops the integral along with the windows.
+    feed.flags = UNAUDIO_METER_ALL;
+    feed.Play(2.0, -6.0);
+    UNAUDIO_CHECK(!std::isinf(meter.Read().integratedLufs));
+    meter.Reset();
+    feed.Play(0.1, -std::numeric_limits<double>::infinity());
+    UNAUDIO_CHECK(std::isinf(meter.Read().integratedLufs));
+}
+
+UNAUDIO_TEST(VoiceMeterFollowsGainRamp) {
+    // A voice fades out across exactly one block.  Its meter reads the ramped
+    // signal, loud at the start of the block, not the block scaled by the
+    // final gain of zero; alone on the bus it reads like the output.
+    const UNAudioOutputConfig config{ 48000, 2, 480, 2, 0 };
+    UNAUDIO_CHECK(UNAudio_Initialize(config) == UNAUDIO_OK);
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000);
+    const int32_t clip = UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()),
+                                           UNAUDIO_DECOMPRESS_ON_LOAD);
+    const int32_t voice = UNAudio_PlayInstance(clip);
+    UNAUDIO_CHECK(UNAudio_FadeVoiceVolume(voice, 0.0f, 10.0f, UNAUDIO_FADE_LINEAR) == UNAUDIO_OK);
+
+    std::vector<float> block(480 * 2);
+    float outputPeak = 0.0f;
+    for (int b = 0; b < 12; ++b) {   // past the first 100 ms slice
+        AudioEngine::Instance().Render(block.data(), 480);
+        for (float sample : block) outputPeak = std::max(outputPeak, std::fabs(sample));
+    }
+
+    UNAudioLevels levels{};
+    UNAUDIO_CHECK(UNAudio_GetVoiceLevels(&voice, 1, &levels) == 1);
+    UNAUDIO_CHECK(levels.peak > 0.4f);
+    UNAUDIO_CHECK_NEAR(levels.peak, outputPeak, 1e-6);
+    UNAUDIO_CHECK_NEAR(levels.peak, UNAudio_GetMasterLevels().peak, 1e-6);
+    UNAudio_Shutdown();
+}
+
+int main() { return test::RunAll(); }
@@ -0,0 +1,159 @@
+// Memory budget: going over it demotes the least recently used idle
+// decompressed clip, samples a playing voice holds are left alone, replaying
+// a demoted clip promotes it again, and the engine totals always equal the
+// sum of the per-clip figures.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+const UNAudioOutputConfig kConfig{ 48000, 2, 256, 2, 0 };
+
+int32_t Load(const std::vector<uint8_t>& wav) {
+    return UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()), UNAUDIO_DECOMPRESS_ON_LOAD);
+}
+
+int64_t PcmBytes(int32_t handle) {
+    return UNAudio_GetClipMemory(handle).pcmBytes;
+}
+
+/// Engine totals against the per-clip figures of every loaded clip.
+bool TotalsMatchClips(const std::vector<int32_t>& handles) {
+    UNAudioMemoryUsage sum{};
+    for (int32_t handle : handles) {
+        const UNAudioMemoryUsage usage = UNAudio_GetClipMemory(handle);
+        sum.compressedBytes += usage.compressedBytes;
+        sum.pcmBytes        += usage.pcmBytes;
+        sum.streamBytes     += usage.streamBytes;
+        sum.decoderBytes    += usage.decoderBytes;
+    }
+    const UNAudioMemoryStats stats = UNAudio_GetMemoryStats();
+    return stats.usage.compressedBytes == sum.compressedBytes &&
+           stats.usage.pcmBytes == sum.pcmBytes && stats.usage.streamBytes == sum.streamBytes &&
+           stats.usage.decoderBytes == sum.decoderBytes &&
+           stats.totalBytes == sum.compressedBytes + sum.pcmBytes + sum.streamBytes + sum.decoderBytes &&
+           stats.clipCount == static_cast<int32_t>(handles.size());
+}
+
+/// Render until the clip holds PCM again; false after five seconds.
+bool WaitForPromotion(int32_t handle) {
+    std::vector<float> block(256 * 2);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (PcmBytes(handle) == 0) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        AudioEngine::Instance().Render(block.data(), 256);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+UNAUDIO_TEST(DemotesLeastRecentlyUsedIdleClip) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(0) == UNAUDIO_OK);   // outlives Shutdown
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000);
+    const int64_t clipPcm = 48000 * 2 * static_cast<int64_t>(sizeof(float));
+
+    const int32_t first = Load(wav);
+    const int32_t second = Load(wav);
+    const int32_t third = Load(wav);
+    const std::vector<int32_t> clips = { first, second, third };
+    UNAUDIO_CHECK(TotalsMatchClips(clips));
+    UNAUDIO_CHECK(UNAudio_GetMemoryStats().usage.pcmBytes == 3 * clipPcm);
+
+    // One byte over: only the oldest clip goes, and only its samples.
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(UNAudio_GetMemoryStats().totalBytes - 1) == UNAUDIO_OK);
+    UNAUDIO_CHECK(PcmBytes(first) == 0);
+    UNAUDIO_CHECK(PcmBytes(second) == clipPcm && PcmBytes(third) == clipPcm);
+    UNAUDIO_CHECK(UNAudio_GetClipMemory(first).compressedBytes > 0);
+    UNAudioMemoryStats stats = UNAudio_GetMemoryStats();
+    UNAUDIO_CHECK(stats.demotedClips == 1 && stats.demotions == 1);
+    UNAUDIO_CHECK(stats.totalBytes <= stats.budgetBytes);
+    UNAUDIO_CHECK(TotalsMatchClips(clips));
+
+    // The info of a demoted clip is unchanged.
+    UNAUDIO_CHECK(UNAudio_GetClipInfo(first).totalFrames == 48000);
+
+    // Unloading gives its bytes back to the totals.
+    UNAudio_UnloadAudio(third);
+    UNAUDIO_CHECK(TotalsMatchClips({ first, second }));
+    UNAUDIO_CHECK(UNAudio_GetMemoryStats().usage.pcmBytes == clipPcm);
+
+    // An attack cache counts as samples of its clip.
+    const int32_t compressed = UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()),
+                                                 UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAUDIO_CHECK(UNAudio_SetAttackCache(compressed, 50.0f) == UNAUDIO_OK);
+    UNAUDIO_CHECK(PcmBytes(compressed) == 2400 * 2 * static_cast<int64_t>(sizeof(float)));
+    UNAUDIO_CHECK(TotalsMatchClips({ first, second, compressed }));
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(SkipsClipsHeldByPlayingVoices) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(0) == UNAUDIO_OK);   // outlives Shutdown
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000);
+
+    // The oldest clip is playing, so the next oldest is the one demoted.
+    const int32_t playing = Load(wav);
+    const int32_t voice = UNAudio_PlayInstance(playing);
+    UNAUDIO_CHECK(voice >= 0);
+    const int32_t idle = Load(wav);
+    const int32_t newest = Load(wav);
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(UNAudio_GetMemoryStats().totalBytes - 1) == UNAUDIO_OK);
+    UNAUDIO_CHECK(PcmBytes(playing) > 0);
+    UNAUDIO_CHECK(PcmBytes(idle) == 0);
+    UNAUDIO_CHECK(PcmBytes(newest) > 0);
+    UNAUDIO_CHECK(TotalsMatchClips({ playing, idle, newest }));
+
+    // Nothing idle is left but the newest clip; still over, the voice's clip stays.
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(1) == UNAUDIO_OK);
+    UNAUDIO_CHECK(PcmBytes(playing) > 0);
+    UNAUDIO_CHECK(PcmBytes(newest) == 0);
+    UNAUDIO_CHECK(UNAudio_GetMemoryStats().demotedClips == 2);
+    UNAUDIO_CHECK(TotalsMatchClips({ playing, idle, newest }));
+
+    // Once the voice stops, its clip is fair game.
+    UNAUDIO_CHECK(UNAudio_StopVoice(voice) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(1) == UNAUDIO_OK);
+    UNAUDIO_CHECK(PcmBytes(playing) == 0);
+    UNAUDIO_CHECK(UNAudio_GetMemoryStats().demotedClips == 3);
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(ReplayPromotesDemotedClip) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(0) == UNAUDIO_OK);   // outlives Shutdown
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000);
+    const int64_t clipPcm = 48000 * 2 * static_cast<int64_t>(sizeof(float));
+
+    const int32_t first = Load(wav);
+    const int32_t second = Load(wav);
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(UNAudio_GetMemoryStats().totalBytes - 1) == UNAUDIO_OK);
+    UNAUDIO_CHECK(PcmBytes(first) == 0);
+
+    // Playing it decodes in the background; the re-decoded clip is now the
+    // most recently used, so the other one makes room.
+    UNAUDIO_CHECK(UNAudio_Play(first) == UNAUDIO_OK);
+    UNAUDIO_CHECK(WaitForPromotion(first));
+    UNAUDIO_CHECK(PcmBytes(first) == clipPcm);
+    UNAUDIO_CHECK(PcmBytes(second) == 0);
+    const UNAudioMemoryStats stats = UNAudio_GetMemoryStats();
+    UNAUDIO_CHECK(stats.promotions == 1 && stats.demotions == 2 && stats.demotedClips == 1);
+    UNAUDIO_CHECK(TotalsMatchClips({ first, second }));
+
+    // Without a budget nothing is demoted again.
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(0) == UNAUDIO_OK);
+    UNAUDIO_CHECK(UNAudio_Play(second) == UNAUDIO_OK);
+    UNAUDIO_CHECK(WaitForPromotion(second));
+    UNAUDIO_CHECK(UNAudio_GetMemoryStats().demotedClips == 0);
+    UNAUDIO_CHECK(TotalsMatchClips({ first, second }));
+    UNAUDIO_CHECK(UNAudio_SetMemoryBudget(-1) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAudio_Shutdown();
+}
+
+int main() { return test::RunAll(); }
@@ -0,0 +1,199 @@
+// Device output stage: every layout pair against the documented matrices,
+// and s16 / packed s24 / s32 scaling, rounding, clipping and dither.
+
+#include "TestHarness.h"
+#include "Mixer/OutputConverter.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kLayouts[] = { 1, 2, 6, 8 };
+constexpr float kMinus3dB = 0.70710678f;
+
+/// Expected gain from source slot s to device slot d, written out from the
+/// speaker order (L R C LFE Ls Rs / L R C LFE Lb Rb Ls Rs) and BS.775.
+float ExpectedGain(int src, int dst, int d, int s) {
+    if (src == dst) return d == s ? 1.0f : 0.0f;
+    auto isLeft = [&](int slot) {
+        return slot == 0 || (src == 6 && slot == 4) || (src == 8 && (slot == 4 || slot == 6));
+    };
+    auto isRight = [&](int slot) {
+        return slot == 1 || (src == 6 && slot == 5) || (src == 8 && (slot == 5 || slot == 7));
+    };
+    // Stereo fold: fronts at unity, centre and surrounds at -3 dB, LFE dropped.
+    auto fold = [&](int side, int slot) {
+        if (slot == side) return 1.0f;
+        if (src <= 2) return 0.0f;
+        if (slot == 2) return kMinus3dB;
+        return (side == 0 ? isLeft(slot) : isRight(slot)) && slot >= 4 ? kMinus3dB : 0.0f;
+    };
+
+    if (src == 1) return d < 2 ? 1.0f : 0.0f;
+    if (dst == 1) return 0.5f * (fold(0, s) + fold(1, s));
+    if (dst == 2) return fold(d, s);
+    if (src == 2) return d == s ? 1.0f : 0.0f;
+    if (src == 6) {   // 5.1 -> 7.1: surrounds become sides, backs stay silent
+        if (d < 4) return d == s ? 1.0f : 0.0f;
+        return (d == 6 && s == 4) || (d == 7 && s == 5) ? 1.0f : 0.0f;
+    }
+    // 7.1 -> 5.1: sides at unity, backs folded in at -3 dB.
+    if (d < 4) return d == s ? 1.0f : 0.0f;
+    if (s == d + 2) return 1.0f;
+    return s == d ? kMinus3dB : 0.0f;
+}
+
+int32_t Read24(const uint8_t* p) {
+    const uint32_t raw = static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+                         static_cast<uint32_t>(p[2]) << 16;
+    return static_cast<int32_t>(raw << 8) >> 8;
+}
+
+} // namespace
+
+UNAUDIO_TEST(LayoutsAndFormats) {
+    for (int channels = 0; channels <= 9; ++channels)
+        UNAUDIO_CHECK(OutputConverter::IsSupportedLayout(channels) ==
+                      (channels == 1 || channels == 2 || channels == 6 || channels == 8));
+    UNAUDIO_CHECK(OutputConverter::BytesPerSample(UNAUDIO_SAMPLE_FLOAT32) == 4);
+    UNAUDIO_CHECK(OutputConverter::BytesPerSample(UNAUDIO_SAMPLE_S16) == 2);
+    UNAUDIO_CHECK(OutputConverter::BytesPerSample(UNAUDIO_SAMPLE_S24) == 3);
+    UNAUDIO_CHECK(OutputConverter::BytesPerSample(UNAUDIO_SAMPLE_S32) == 4);
+
+    OutputConverter converter;
+    UNAUDIO_CHECK(!converter.IsValid());
+    UNAUDIO_CHECK(!converter.Configure(3, 2, UNAUDIO_SAMPLE_S16));
+    UNAUDIO_CHECK(!converter.Configure(2, 4, UNAUDIO_SAMPLE_S16));
+    UNAUDIO_CHECK(!converter.Configure(2, 2, static_cast<UNAudioSampleFormat>(99)));
+    UNAUDIO_CHECK(!converter.IsValid());
+    UNAUDIO_CHECK(converter.Configure(6, 2, UNAUDIO_SAMPLE_S24));
+    UNAUDIO_CHECK(converter.Matches(6, 2, UNAUDIO_SAMPLE_S24));
+    UNAUDIO_CHECK(!converter.Matches(6, 2, UNAUDIO_SAMPLE_S16));
+}
+
+UNAUDIO_TEST(MatricesMatchSpeakerLayouts) {
+    OutputConverter converter;
+    for (int src : kLayouts) {
+        for (int dst : kLayouts) {
+            UNAUDIO_CHECK(converter.Configure(src, dst, UNAUDIO_SAMPLE_FLOAT32));
+            // One frame per source slot, each an impulse on that slot.
+            std::vector<float> in(static_cast<size_t>(src) * src, 0.0f);
+            for (int s = 0; s < src; ++s) in[static_cast<size_t>(s) * src + s] = 1.0f;
+            std::vector<float> out(static_cast<size_t>(src) * dst, -1.0f);
+            converter.Process(in.data(), out.data(), src);
+
+            for (int s = 0; s < src; ++s) {
+                for (int d = 0; d < dst; ++d) {
+                    const float got = out[static_cast<size_t>(s) * dst + d];
+                    const float expected = ExpectedGain(src, dst, d, s);
+                    if (std::fabs(got - expected) > 1e-6f) {
+                        std::printf("  %d -> %d: slot %d -> %d is %g, expected %g\n", src, dst, s, d,
+                                    got, expected);
+                        UNAUDIO_CHECK(std::fabs(got - expected) <= 1e-6f);
+                    }
+                }
+            }
+        }
+    }
+}
+
+UNAUDIO_TEST(MatricesAreLinearAcrossChunks) {
+    // More frames than one scratch chunk, with all slots active at once.
+    const int frames = 3 * OutputConverter::kChunkFrames + 17;
+    OutputConverter converter;
+    for (int src : kLayouts) {
+        for (int dst : kLayouts) {
+            converter.Configure(src, dst, UNAUDIO_SAMPLE_FLOAT32);
+            std::vector<float> in(static_cast<size_t>(frames) * src);
+            for (size_t i = 0; i < in.size(); ++i) in[i] = std::sin(0.37 * static_cast<double>(i));
+            std::vector<float> out(static_cast<size_t>(frames) * dst);
+            converter.Process(in.data(), out.data(), frames);
+
+            double worst = 0.0;
+            for (int f = 0; f < frames; ++f) {
+                for (int d = 0; d < dst; ++d) {
+                    double expected = 0.0;
+                    for (int s = 0; s < src; ++s)
+                        expected += ExpectedGain(src, dst, d, s) * in[static_cast<size_t>(f) * src + s];
+                    worst = std::max(worst, std::fabs(out[static_cast<size_t>(f) * dst + d] - expected));
+                }
+            }
+            UNAUDIO_CHECK(worst < 1e-5);
+        }
+    }
+}
+
+UNAUDIO_TEST(S16RoundsAndClips) {
+    OutputConverter converter;
+    UNAUDIO_CHECK(converter.Configure(1, 1, UNAUDIO_SAMPLE_S16, false));
+    const float lsb = 1.0f / 32768.0f;
+    const float in[] = { 2.0f, -2.0f, 1.0f, -1.0f, 0.5f, -0.5f, 1.6f * lsb, -1.6f * lsb,
+                         0.4f * lsb, -0.4f * lsb, 0.0f };
+    const int16_t expected[] = { 32767, -32768, 32767, -32768, 16384, -16384, 2, -2, 0, 0, 0 };
+    int16_t out[11];
+    converter.Process(in, out, 11);
+    for (int i = 0; i < 11; ++i) UNAUDIO_CHECK(out[i] == expected[i]);
+}
+
+UNAUDIO_TEST(S24PacksAndClips) {
+    OutputConverter converter;
+    UNAUDIO_CHECK(converter.Configure(2, 2, UNAUDIO_SAMPLE_S24, false));
+    const float lsb = 1.0f / 8388608.0f;
+    const float in[] = { -1.0f, 0.25f, 1.5f, -1.5f, 1.0f, 0.6f * lsb, -0.6f * lsb, 0.0f };
+    const int32_t expected[] = { -8388608, 2097152, 8388607, -8388608, 8388607, 1, -1, 0 };
+    uint8_t out[8 * 3];
+    converter.Process(in, out, 4);
+    for (int i = 0; i < 8; ++i) UNAUDIO_CHECK(Read24(out + 3 * i) == expected[i]);
+}
+
+UNAUDIO_TEST(S32ClipsBelowFullScale) {
+    OutputConverter converter;
+    // Dither is never applied to 32-bit output, even when requested.
+    UNAUDIO_CHECK(converter.Configure(1, 1, UNAUDIO_SAMPLE_S32, true));
+    const float in[] = { 1.5f, -1.5f, 1.0f, -1.0f, 0.5f, -0.25f, 0.0f };
+    const int32_t expected[] = { 2147483520, INT32_MIN, 2147483520, INT32_MIN, 1073741824,
+                                 -536870912, 0 };
+    int32_t out[7];
+    converter.Process(in, out, 7);
+    for (int i = 0; i < 7; ++i) UNAUDIO_CHECK(out[i] == expected[i]);
+}
+
+UNAUDIO_TEST(DitherIsTriangularAndUnbiased) {
+    // A constant a quarter LSB above zero: TPDF dither spreads it over
+    // -1 .. +1 LSB around the value while keeping the mean.
+    const int frames = 100000;
+    OutputConverter converter;
+    UNAUDIO_CHECK(converter.Configure(2, 2, UNAUDIO_SAMPLE_S16, true));
+    std::vector<float> in(static_cast<size_t>(frames) * 2, 0.25f / 32768.0f);
+    std::vector<int16_t> out(in.size());
+    converter.Process(in.data(), out.data(), frames);
+
+    double mean = 0.0;
+    int lo = 0, hi = 0;
+    for (int16_t v : out) {
+        mean += v;
+        lo = std::min<int>(lo, v);
+        hi = std::max<int>(hi, v);
+    }
+    mean /= static_cast<double>(out.size());
+    UNAUDIO_CHECK_NEAR(mean, 0.25, 0.01);
+    UNAUDIO_CHECK(lo == -1 && hi == 1);
+
+    // Left and right are dithered independently.
+    double cross = 0.0, left = 0.0;
+    for (int f = 0; f < frames; ++f) {
+        const double l = out[2 * static_cast<size_t>(f)] - mean;
+        const double r = out[2 * static_cast<size_t>(f) + 1] - mean;
+        cross += l * r;
+        left += l * l;
+    }
+    UNAUDIO_CHECK(std::fabs(cross / left) < 0.02);
+
+    // Reconfiguring restarts the generator: the output is reproducible.
+    std::vector<int16_t> again(in.size());
+    converter.Configure(2, 2, UNAUDIO_SAMPLE_S16, true);
+    converter.Process(in.data(), again.data(), frames);
+    UNAUDIO_CHECK(again == out);
+}
+
+int main() { return test::RunAll(); }
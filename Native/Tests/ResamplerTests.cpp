@@ -0,0 +1,79 @@
+// Sample-rate conversion: matching rates stay inactive, a ramp converts to
+// the right length and shape, and blocks longer than configured are split
+// into chunks instead of growing the buffer on the mixer thread.
+
+#include "TestHarness.h"
+#include "Mixer/Resampler.h"
+
+#include <algorithm>
+
+namespace {
+
+/// Stereo source whose frame n holds (n, -n), ending after `total` frames.
+struct RampSource {
+    int64_t total;
+    int64_t position = 0;
+
+    int operator()(float* dst, int frames) {
+        const int n = static_cast<int>(std::min<int64_t>(frames, total - position));
+        for (int i = 0; i < n; ++i) {
+            dst[2 * i]     = static_cast<float>(position + i);
+            dst[2 * i + 1] = -static_cast<float>(position + i);
+        }
+        position += n;
+        return n;
+    }
+};
+
+/// Resample the whole source in blocks of `block`; returns every output sample.
+std::vector<float> Convert(int sourceRate, int outputRate, int maxFrames, int block, int64_t total) {
+    Resampler resampler;
+    resampler.Configure(2, sourceRate, outputRate, maxFrames);
+    RampSource source{ total };
+    std::vector<float> output;
+    std::vector<float> buffer(static_cast<size_t>(block) * 2);
+    int got;
+    do {
+        got = resampler.Process(buffer.data(), block, source);
+        output.insert(output.end(), buffer.begin(), buffer.begin() + got * 2);
+    } while (got == block);
+    return output;
+}
+
+} // namespace
+
+UNAUDIO_TEST(MatchingRatesStayInactive) {
+    Resampler resampler;
+    resampler.Configure(2, 48000, 48000, 256);
+    UNAUDIO_CHECK(!resampler.IsActive());
+    resampler.Configure(2, 44100, 48000, 256);
+    UNAUDIO_CHECK(resampler.IsActive());
+}
+
+UNAUDIO_TEST(RampKeepsItsShape) {
+    // Catmull-Rom reproduces a straight line exactly between its taps.
+    const std::vector<float> out = Convert(44100, 48000, 256, 256, 44100);
+    const size_t frames = out.size() / 2;
+    UNAUDIO_CHECK(frames >= 47990 && frames <= 48010);
+    const double step = 44100.0 / 48000.0;
+    for (size_t k = 4; k + 4 < frames; k += 97) {
+        const double expected = static_cast<double>(k) * step;
+        UNAUDIO_CHECK_NEAR(out[2 * k], expected, 1e-2);
+        UNAUDIO_CHECK_NEAR(out[2 * k + 1], -expected, 1e-2);
+    }
+}
+
+UNAUDIO_TEST(LongBlocksAreSplitNotGrown) {
+    for (const int sourceRate : { 22050, 44100, 96000 }) {
+        const std::vector<float> reference = Convert(sourceRate, 48000, 4096, 4096, 30000);
+        // Blocks sixteen times the configured size, and odd sizes around it.
+        for (const int block : { 4096, 255, 257 }) {
+            const std::vector<float> chunked = Convert(sourceRate, 48000, 256, block, 30000);
+            UNAUDIO_CHECK(chunked.size() == reference.size());
+            const size_t n = std::min(chunked.size(), reference.size());
+            for (size_t i = 0; i < n; ++i) UNAUDIO_CHECK_NEAR(chunked[i], reference[i], 1e-2);
+        }
+    }
+}
+
+int main() { return test::RunAll(); }
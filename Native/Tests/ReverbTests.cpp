@@ -0,0 +1,144 @@
+// Send-bus reverb: an impulse decays by 60 dB over the decay time, the
+// network sleeps once its tail has died away, and on the engine a zero send
+// or a removed reverb leaves the dry mix bit-identical.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Mixer/Reverb.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kRate = 48000;
+constexpr int kBlock = 256;
+
+/// Level in dB of the reverb's stereo impulse response over each 50 ms window.
+std::vector<double> ImpulseEnvelope(FdnReverb& reverb, double seconds) {
+    std::vector<float> input(kBlock * 2, 0.0f);
+    std::vector<float> output(kBlock * 2);
+    input[0] = 1.0f;
+
+    const int window = kRate / 20;
+    std::vector<double> levels;
+    double energy = 0.0;
+    int inWindow = 0;
+    for (int done = 0; done < seconds * kRate; done += kBlock) {
+        std::fill(output.begin(), output.end(), 0.0f);
+        reverb.Process(done == 0 ? input.data() : nullptr, output.data(), kBlock, 2);
+        for (int f = 0; f < kBlock; ++f) {
+            energy += output[2 * f] * output[2 * f] + output[2 * f + 1] * output[2 * f + 1];
+            if (++inWindow == window) {
+                levels.push_back(10.0 * std::log10(energy / window + 1e-30));
+                energy = 0.0;
+                inWindow = 0;
+            }
+        }
+    }
+    return levels;
+}
+
+const UNAudioOutputConfig kConfig{ kRate, 2, kBlock, 2, 0 };
+
+/// Render a looping voice for `blocks` blocks with the given reverb setup
+/// (null = never configured) and send level.
+std::vector<float> RenderVoice(const UNAudioReverbParams* first, const UNAudioReverbParams* second,
+                               float sendLevel, int blocks) {
+    if (UNAudio_Initialize(kConfig) != UNAUDIO_OK) return {};
+    if (first) UNAudio_SetReverb(*first);
+    if (second) UNAudio_SetReverb(*second);
+
+    const std::vector<uint8_t> wav = test::MakeSineWav(kRate, 2, kRate);
+    const int32_t clip = UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()),
+                                           UNAUDIO_DECOMPRESS_ON_LOAD);
+    const int32_t voice = UNAudio_PlayInstance(clip);
+    UNAudio_SetVoiceSendLevel(voice, sendLevel);
+
+    std::vector<float> output;
+    std::vector<float> block(kBlock * 2);
+    for (int b = 0; b < blocks; ++b) {
+        AudioEngine::Instance().Render(block.data(), kBlock);
+        output.insert(output.end(), block.begin(), block.end());
+    }
+    UNAudio_Shutdown();
+    return output;
+}
+
+} // namespace
+
+UNAUDIO_TEST(ImpulseDecaysSixtyDbOverDecayTime) {
+    for (const int lines : { 8, 16 }) {
+        for (const float decay : { 0.5f, 1.5f }) {
+            FdnReverb reverb(lines, kRate);
+            reverb.SetParams(decay, 0.0f, 1.0f);
+            const std::vector<double> levels = ImpulseEnvelope(reverb, decay + 0.5);
+
+            // Compare windows once the network is dense, decayTime apart.
+            const size_t from = 4;   // 200 ms
+            const size_t to = from + static_cast<size_t>(decay * 20.0f + 0.5f);
+            UNAUDIO_CHECK(to < levels.size());
+            if (to < levels.size()) UNAUDIO_CHECK_NEAR(levels[from] - levels[to], 60.0, 2.0);
+        }
+    }
+}
+
+UNAUDIO_TEST(SleepsOnceTheTailDiesAway) {
+    FdnReverb reverb(16, kRate);
+    reverb.SetParams(0.3f, 0.5f, 0.5f);
+    UNAUDIO_CHECK(reverb.IsIdle());
+
+    std::vector<float> input(kBlock * 2, 0.0f);
+    std::vector<float> output(kBlock * 2, 0.0f);
+    input[0] = 1.0f;
+    reverb.Process(input.data(), output.data(), kBlock, 2);
+    UNAUDIO_CHECK(!reverb.IsIdle());
+
+    // The lines start well below the impulse, so -120 dBFS comes in under
+    // two decay times; then a longest delay of quiet before it sleeps.
+    int blocks = 0;
+    float lastPeak = 0.0f;
+    while (!reverb.IsIdle() && blocks < 2 * kRate / kBlock) {
+        std::fill(output.begin(), output.end(), 0.0f);
+        reverb.Process(nullptr, output.data(), kBlock, 2);
+        lastPeak = 0.0f;
+        for (float s : output) lastPeak = std::max(lastPeak, std::fabs(s));
+        ++blocks;
+    }
+    UNAUDIO_CHECK(reverb.IsIdle());
+    UNAUDIO_CHECK(blocks * kBlock > 0.3 * kRate);   // not while the tail was audible
+    UNAUDIO_CHECK(blocks * kBlock < 0.6 * kRate + kBlock);
+    UNAUDIO_CHECK(lastPeak < 1e-6f);
+
+    // Asleep it adds nothing, and new input wakes it.
+    std::fill(output.begin(), output.end(), 0.25f);
+    reverb.Process(nullptr, output.data(), kBlock, 2);
+    UNAUDIO_CHECK(std::all_of(output.begin(), output.end(), [](float s) { return s == 0.25f; }));
+    reverb.Process(input.data(), output.data(), kBlock, 2);
+    UNAUDIO_CHECK(!reverb.IsIdle());
+}
+
+UNAUDIO_TEST(ZeroSendLeavesDryMixUntouched) {
+    const UNAudioReverbParams reverb{ 16, 1.5f, 0.5f, 0.5f };
+    const std::vector<float> dry = RenderVoice(nullptr, nullptr, 0.0f, 40);
+    UNAUDIO_CHECK(!dry.empty());
+
+    UNAUDIO_CHECK(RenderVoice(&reverb, nullptr, 0.0f, 40) == dry);
+    UNAUDIO_CHECK(RenderVoice(&reverb, nullptr, 0.5f, 40) != dry);   // the send is live
+}
+
+UNAUDIO_TEST(ZeroLinesRemovesTheBus) {
+    const UNAudioReverbParams reverb{ 16, 1.5f, 0.5f, 0.5f };
+    const UNAudioReverbParams off{ 0, 1.5f, 0.5f, 0.5f };
+    const std::vector<float> dry = RenderVoice(nullptr, nullptr, 0.5f, 40);
+    UNAUDIO_CHECK(RenderVoice(&reverb, &off, 0.5f, 40) == dry);
+
+    // Line counts other than 0, 8 and 16 are rejected.
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const UNAudioReverbParams odd{ 12, 1.5f, 0.5f, 0.5f };
+    UNAUDIO_CHECK(UNAudio_SetReverb(odd) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_SetReverb(off) == UNAUDIO_OK);
+    UNAudio_Shutdown();
+    UNAUDIO_CHECK(UNAudio_SetReverb(reverb) == UNAUDIO_ERROR_NOT_INITIALIZED);
+}
+
+int main() { return test::RunAll(); }
@@ -0,0 +1,112 @@
+#ifndef UNAUDIO_TEST_HARNESS_H
+#define UNAUDIO_TEST_HARNESS_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/// Dependency-free helpers for the native tests.  Every Tests/*.cpp is its
+/// own executable (one ctest entry) built from UNAUDIO_TEST cases:
+///
+///   UNAUDIO_TEST(RoundTrip) { UNAUDIO_CHECK(x == 1); }
+///   int main() { return test::RunAll(); }
+///
+/// A failed check reports and lets the case continue; the process exits
+/// non-zero if any check failed.
+namespace test {
+
+using TestFunction = void (*)();
+
+struct TestCase {
+    const char*  name;
+    TestFunction function;
+};
+
+inline std::vector<TestCase>& Registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool Register(const char* name, TestFunction function) {
+    Registry().push_back({ name, function });
+    return true;
+}
+
+inline void Fail(const char* file, int line, const char* expression) {
+    std::printf("  FAILED %s:%d: %s\n", file, line, expression);
+    ++Failures();
+}
+
+inline int RunAll() {
+    for (const TestCase& test : Registry()) {
+        const int before = Failures();
+        test.function();
+        std::printf("%s %s\n", Failures() == before ? "[pass]" : "[FAIL]", test.name);
+    }
+    return Failures() == 0 ? 0 : 1;
+}
+
+// ── Signals ───────────────────────────────────────────────────────
+
+/// In-memory 16-bit PCM WAV file holding a sine of `amplitude` (full scale
+/// = 1) at `frequency` Hz, identical on every channel.
+inline std::vector<uint8_t> MakeSineWav(int frames, int channels, int sampleRate,
+                                        double frequency = 440.0, double amplitude = 0.5) {
+    const uint32_t dataBytes = static_cast<uint32_t>(frames) * channels * 2;
+    std::vector<uint8_t> wav(44 + dataBytes);
+    auto put32 = [&](size_t at, uint32_t v) { std::memcpy(&wav[at], &v, 4); };
+    auto put16 = [&](size_t at, uint16_t v) { std::memcpy(&wav[at], &v, 2); };
+
+    std::memcpy(&wav[0], "RIFF", 4);
+    put32(4, 36 + dataBytes);
+    std::memcpy(&wav[8], "WAVEfmt ", 8);
+    put32(16, 16);
+    put16(20, 1);                                         // PCM
+    put16(22, static_cast<uint16_t>(channels));
+    put32(24, static_cast<uint32_t>(sampleRate));
+    put32(28, static_cast<uint32_t>(sampleRate) * channels * 2);
+    put16(32, static_cast<uint16_t>(channels * 2));
+    put16(34, 16);
+    std::memcpy(&wav[36], "data", 4);
+    put32(40, dataBytes);
+
+    const double step = 2.0 * 3.14159265358979323846 * frequency / sampleRate;
+    for (int i = 0; i < frames; ++i) {
+        const int16_t s = static_cast<int16_t>(std::lround(32767.0 * amplitude * std::sin(step * i)));
+        for (int c = 0; c < channels; ++c)
+            std::memcpy(&wav[44 + (static_cast<size_t>(i) * channels + c) * 2], &s, 2);
+    }
+    return wav;
+}
+
+} // namespace test
+
+#define UNAUDIO_TEST(name)                                                    \
+    static void name();                                                       \
+    static const bool name##Registered = test::Register(#name, name);         \
+    static void name()
+
+#define UNAUDIO_CHECK(condition)                                              \
+    do {                                                                      \
+        if (!(condition)) test::Fail(__FILE__, __LINE__, #condition);         \
+    } while (0)
+
+#define UNAUDIO_CHECK_NEAR(actual, expected, tolerance)                       \
+    do {                                                                      \
+        const double unaudioActual_ = static_cast<double>(actual);            \
+        const double unaudioExpected_ = static_cast<double>(expected);        \
+        if (!(std::fabs(unaudioActual_ - unaudioExpected_) <= (tolerance))) { \
+            std::printf("  %s = %.9g, expected %.9g\n", #actual,              \
+                        unaudioActual_, unaudioExpected_);                    \
+            test::Fail(__FILE__, __LINE__, #actual " ~ " #expected);          \
+        }                                                                     \
+    } while (0)
+
+#endif // UNAUDIO_TEST_HARNESS_H
@@ -0,0 +1,123 @@
+// Instanced playback: voice handles go stale when their slot is reused,
+// overlapping instances of one clip mix independently, and finished voices
+// are reaped so their slots come back.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kBlock = 256;
+const UNAudioOutputConfig kConfig{ 48000, 2, kBlock, 2, 0 };
+
+int32_t LoadPcm(const std::vector<uint8_t>& wav) {
+    return UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()), UNAUDIO_DECOMPRESS_ON_LOAD);
+}
+
+std::vector<float> RenderBlock() {
+    std::vector<float> block(kBlock * 2);
+    AudioEngine::Instance().Render(block.data(), kBlock);
+    return block;
+}
+
+int32_t SlotOf(int32_t voice) { return voice & 0xFFFF; }
+
+} // namespace
+
+UNAUDIO_TEST(StaleHandleFailsAfterSlotReuse) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const int32_t clip = LoadPcm(test::MakeSineWav(48000, 2, 48000));
+
+    const int32_t first = UNAudio_PlayInstance(clip);
+    UNAUDIO_CHECK(first >= 0);
+    UNAUDIO_CHECK(UNAudio_StopVoice(first) == UNAUDIO_OK);
+    const int32_t second = UNAudio_PlayInstance(clip);
+    UNAUDIO_CHECK(SlotOf(second) == SlotOf(first) && second != first);
+
+    // The old handle names the slot but not its new voice.
+    UNAUDIO_CHECK(UNAudio_StopVoice(first) == UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_FadeVoiceVolume(first, 0.0f, 0.0f, UNAUDIO_FADE_LINEAR) ==
+                  UNAUDIO_ERROR_INVALID_PARAM);
+    UNAudio_SetVoiceVolume(first, 0.0f);
+    UNAUDIO_CHECK(UNAudio_GetVoiceState(first) == UNAUDIO_STATE_STOPPED);
+    UNAudioLevels levels[2];
+    const int32_t both[] = { first, second };
+    UNAUDIO_CHECK(UNAudio_GetVoiceLevels(both, 2, levels) == 1);
+    UNAUDIO_CHECK(UNAudio_GetVoiceState(second) == UNAUDIO_STATE_PLAYING);
+    const std::vector<float> block = RenderBlock();
+    UNAUDIO_CHECK(*std::max_element(block.begin(), block.end()) > 0.1f);   // not muted
+
+    // Handles stay positive through the 15-bit generation, which wraps.
+    int32_t voice = second;
+    for (int i = 0; i < 0x8000; ++i) {
+        UNAUDIO_CHECK(UNAudio_StopVoice(voice) == UNAUDIO_OK);
+        voice = UNAudio_PlayInstance(clip);
+        if (voice < 0 || SlotOf(voice) != SlotOf(first)) break;
+    }
+    UNAUDIO_CHECK(voice == second);
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(OverlappingInstancesMixIndependently) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const std::vector<uint8_t> wav = test::MakeSineWav(48000, 2, 48000, 440.0, 0.2);
+
+    // One instance alone, block by block.
+    int32_t clip = LoadPcm(wav);
+    UNAUDIO_CHECK(UNAudio_PlayInstance(clip) >= 0);
+    std::vector<std::vector<float>> reference;
+    for (int b = 0; b < 16; ++b) reference.push_back(RenderBlock());
+    UNAudio_Shutdown();
+
+    // Three instances started at blocks 0, 2 and 5; the second stops at 8.
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    clip = LoadPcm(wav);
+    const int starts[] = { 0, 2, 5 };
+    int32_t voices[3] = { -1, -1, -1 };
+    double worst = 0.0;
+    for (int b = 0; b < 16; ++b) {
+        for (int v = 0; v < 3; ++v)
+            if (b == starts[v]) voices[v] = UNAudio_PlayInstance(clip);
+        if (b == 8) UNAUDIO_CHECK(UNAudio_StopVoice(voices[1]) == UNAUDIO_OK);
+
+        const std::vector<float> block = RenderBlock();
+        for (size_t i = 0; i < block.size(); ++i) {
+            double expected = 0.0;
+            for (int v = 0; v < 3; ++v)
+                if (b >= starts[v] && (v != 1 || b < 8))
+                    expected += reference[static_cast<size_t>(b - starts[v])][i];
+            worst = std::max(worst, std::fabs(block[i] - expected));
+        }
+    }
+    UNAUDIO_CHECK(worst < 1e-6);
+    UNAUDIO_CHECK(UNAudio_GetVoiceState(voices[0]) == UNAUDIO_STATE_PLAYING);
+    UNAUDIO_CHECK(UNAudio_GetVoiceState(voices[1]) == UNAUDIO_STATE_STOPPED);
+    UNAudio_Shutdown();
+}
+
+UNAUDIO_TEST(FinishedVoicesAreReaped) {
+    UNAUDIO_CHECK(UNAudio_Initialize(kConfig) == UNAUDIO_OK);
+    const int32_t clip = LoadPcm(test::MakeSineWav(1000, 2, 48000));
+
+    std::vector<int32_t> finished;
+    for (int i = 0; i < 3; ++i) finished.push_back(UNAudio_PlayInstance(clip));
+    for (int b = 0; b < 8; ++b) RenderBlock();
+    for (int32_t voice : finished) UNAUDIO_CHECK(UNAudio_GetVoiceState(voice) == UNAUDIO_STATE_STOPPED);
+
+    // New instances take the finished voices' slots; nothing new is allocated
+    // and the old handles no longer resolve.
+    for (int i = 0; i < 3; ++i) {
+        const int32_t voice = UNAudio_PlayInstance(clip);
+        UNAUDIO_CHECK(voice >= 0 && SlotOf(voice) < 3);
+        UNAUDIO_CHECK(std::find(finished.begin(), finished.end(), voice) == finished.end());
+    }
+    for (int32_t voice : finished) UNAUDIO_CHECK(UNAudio_StopVoice(voice) == UNAUDIO_ERROR_INVALID_PARAM);
+
+    // With every slot live, the next instance needs a fresh one.
+    UNAUDIO_CHECK(SlotOf(UNAudio_PlayInstance(clip)) == 3);
+    UNAudio_Shutdown();
+}
+
+int main() { return test::RunAll(); }
@@ -0,0 +1,160 @@
+// Waveform summaries: bins against a brute-force reference, and sidecar
+// Save -> Load round trips and rejection of malformed or stale blobs.
+
+#include "TestHarness.h"
+#include "Core/AudioEngine.h"
+#include "Core/WaveformPeaks.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+
+using Header = WaveformPeaks::PeakFileHeader;
+
+// Spans several level-1 bins and a partial last bin on every level.
+constexpr int kFrames = 3 * 65536 + 1234;
+
+struct Clip {
+    std::vector<uint8_t> wav = test::MakeSineWav(kFrames, 2, 48000, 997.0, 0.8);
+    int32_t Load(int32_t mode) const {
+        return UNAudio_LoadAudio(wav.data(), static_cast<int32_t>(wav.size()), mode);
+    }
+};
+
+std::vector<uint8_t> Save(int32_t handle) {
+    const int32_t size = UNAudio_SaveWaveformPeaks(handle, nullptr, 0);
+    std::vector<uint8_t> blob(static_cast<size_t>(std::max(size, 0)));
+    if (size > 0 && UNAudio_SaveWaveformPeaks(handle, blob.data(), size) != size) blob.clear();
+    return blob;
+}
+
+std::vector<UNAudioPeakBin> Bins(int32_t handle, int32_t level) {
+    const int32_t count = UNAudio_GetWaveformPeaks(handle, level, 0, 0, nullptr);
+    std::vector<UNAudioPeakBin> bins(static_cast<size_t>(std::max(count, 0)));
+    UNAudio_GetWaveformPeaks(handle, level, 0, count, bins.data());
+    return bins;
+}
+
+bool SameBins(const std::vector<UNAudioPeakBin>& a, const std::vector<UNAudioPeakBin>& b) {
+    return a.size() == b.size() &&
+           std::memcmp(a.data(), b.data(), a.size() * sizeof(UNAudioPeakBin)) == 0;
+}
+
+/// Whether Deserialize accepts `blob` with `patch` written at `offset`.
+template <typename T>
+bool ParsesWithPatch(std::vector<uint8_t> blob, size_t offset, T patch) {
+    std::memcpy(&blob[offset], &patch, sizeof(patch));
+    return WaveformPeaks::Deserialize(blob.data(), blob.size()) != nullptr;
+}
+
+} // namespace
+
+UNAUDIO_TEST(BinsMatchReference) {
+    const Clip clip;
+    const int32_t handle = clip.Load(UNAUDIO_DECOMPRESS_ON_LOAD);
+    UNAUDIO_CHECK(UNAudio_BuildWaveformPeaks(handle) == UNAUDIO_OK);
+
+    for (int level = 0; level < WaveformPeaks::kLevelCount; ++level) {
+        const int64_t binFrames = WaveformPeaks::kBinFrames[level];
+        const std::vector<UNAudioPeakBin> bins = Bins(handle, level);
+        UNAUDIO_CHECK(static_cast<int64_t>(bins.size()) == (kFrames + binFrames - 1) / binFrames);
+        if (bins.empty()) continue;
+
+        // First and (partial) last bin against the 16-bit source samples.
+        for (size_t b : { size_t{0}, bins.size() - 1 }) {
+            const int64_t first = static_cast<int64_t>(b) * binFrames;
+            const int64_t last = std::min<int64_t>(first + binFrames, kFrames);
+            float lo = 1.0f, hi = -1.0f;
+            double squares = 0.0;
+            for (int64_t f = first; f < last; ++f) {
+                int16_t raw;
+                std::memcpy(&raw, &clip.wav[44 + static_cast<size_t>(f) * 4], 2);
+                const float s = raw / 32768.0f;
+                lo = std::min(lo, s);
+                hi = std::max(hi, s);
+                squares += 2.0 * s * s;   // both channels
+            }
+            UNAUDIO_CHECK(bins[b].min == lo);
+            UNAUDIO_CHECK(bins[b].max == hi);
+            UNAUDIO_CHECK_NEAR(bins[b].rms, std::sqrt(squares / (2.0 * (last - first))), 1e-4);
+        }
+    }
+    UNAUDIO_CHECK(UNAudio_GetWaveformPeaks(handle, WaveformPeaks::kLevelCount, 0, 0, nullptr) < 0);
+}
+
+UNAUDIO_TEST(SaveLoadRoundTrip) {
+    const Clip clip;
+    const int32_t source = clip.Load(UNAUDIO_DECOMPRESS_ON_LOAD);
+    const std::vector<uint8_t> blob = Save(source);
+    UNAUDIO_CHECK(blob.size() > sizeof(Header));
+    if (blob.size() <= sizeof(Header)) return;
+
+    // Parsing and re-serialising is lossless.
+    auto parsed = WaveformPeaks::Deserialize(blob.data(), blob.size());
+    UNAUDIO_CHECK(parsed != nullptr);
+    if (parsed) {
+        UNAUDIO_CHECK(parsed->GetTotalFrames() == kFrames);
+        UNAUDIO_CHECK(parsed->Serialize() == blob);
+    }
+
+    // A second handle of the same clip adopts the sidecar instead of building.
+    const int32_t target = clip.Load(UNAUDIO_COMPRESS_IN_MEMORY);
+    UNAUDIO_CHECK(UNAudio_LoadWaveformPeaks(target, blob.data(), static_cast<int32_t>(blob.size())) ==
+                  UNAUDIO_OK);
+    for (int level = 0; level < WaveformPeaks::kLevelCount; ++level)
+        UNAUDIO_CHECK(SameBins(Bins(source, level), Bins(target, level)));
+    UNAUDIO_CHECK(Save(target) == blob);
+
+    // Windowed reads clamp to the level.
+    UNAudioPeakBin window[8];
+    const int32_t count = UNAudio_GetWaveformPeaks(target, 2, 0, 0, nullptr);
+    UNAUDIO_CHECK(UNAudio_GetWaveformPeaks(target, 2, count - 2, 8, window) == 2);
+    UNAUDIO_CHECK(UNAudio_GetWaveformPeaks(target, 2, count, 8, window) == 0);
+}
+
+UNAUDIO_TEST(RejectsMalformedBlob) {
+    const Clip clip;
+    const int32_t handle = clip.Load(UNAUDIO_DECOMPRESS_ON_LOAD);
+    const std::vector<uint8_t> blob = Save(handle);
+    if (blob.size() <= sizeof(Header)) return;
+
+    UNAUDIO_CHECK(ParsesWithPatch(blob, 0, blob[0]));                         // unchanged
+    UNAUDIO_CHECK(!ParsesWithPatch(blob, offsetof(Header, magic), 'X'));
+    UNAUDIO_CHECK(!ParsesWithPatch(blob, offsetof(Header, version), WaveformPeaks::kVersion + 1));
+    UNAUDIO_CHECK(!ParsesWithPatch(blob, offsetof(Header, totalFrames), int64_t{-1}));
+    UNAUDIO_CHECK(!ParsesWithPatch(blob, offsetof(Header, totalFrames), int64_t{kFrames} * 2));
+    UNAUDIO_CHECK(!ParsesWithPatch(blob, offsetof(Header, levelCount), 2u));
+    UNAUDIO_CHECK(!ParsesWithPatch(blob, offsetof(Header, binFrames), 512u));
+
+    // Truncated, or with trailing bytes.
+    UNAUDIO_CHECK(WaveformPeaks::Deserialize(blob.data(), blob.size() - 1) == nullptr);
+    UNAUDIO_CHECK(WaveformPeaks::Deserialize(blob.data(), sizeof(Header) - 1) == nullptr);
+    std::vector<uint8_t> longer = blob;
+    longer.push_back(0);
+    UNAUDIO_CHECK(WaveformPeaks::Deserialize(longer.data(), longer.size()) == nullptr);
+    UNAUDIO_CHECK(UNAudio_LoadWaveformPeaks(handle, blob.data(), static_cast<int32_t>(blob.size()) - 1) ==
+                  UNAUDIO_ERROR_FORMAT_NOT_SUPPORTED);
+}
+
+UNAUDIO_TEST(RejectsStaleSidecar) {
+    const Clip clip;
+    const std::vector<uint8_t> blob = Save(clip.Load(UNAUDIO_DECOMPRESS_ON_LOAD));
+
+    // Same format, different clip length: built from another version of the clip.
+    const std::vector<uint8_t> shorter = test::MakeSineWav(kFrames - 1, 2, 48000);
+    const int32_t other = UNAudio_LoadAudio(shorter.data(), static_cast<int32_t>(shorter.size()),
+                                            UNAUDIO_DECOMPRESS_ON_LOAD);
+    UNAUDIO_CHECK(UNAudio_LoadWaveformPeaks(other, blob.data(), static_cast<int32_t>(blob.size())) ==
+                  UNAUDIO_ERROR_INVALID_PARAM);
+    UNAUDIO_CHECK(UNAudio_LoadWaveformPeaks(-1, blob.data(), static_cast<int32_t>(blob.size())) ==
+                  UNAUDIO_ERROR_INVALID_PARAM);
+}
+
+int main() {
+    const UNAudioOutputConfig config{ 48000, 2, 256, 2, 0 };
+    if (UNAudio_Initialize(config) != UNAUDIO_OK) return 1;
+    const int result = test::RunAll();
+    UNAudio_Shutdown();
+    return result;
+}
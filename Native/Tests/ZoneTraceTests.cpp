@@ -0,0 +1,112 @@
+// Trace zones: nested zones on several threads export as Chrome trace JSON,
+// a full ring keeps its newest events, and a thread that first records
+// mid-capture gets a ring without Start() running again.
+
+#include "TestHarness.h"
+#include "Core/ZoneTrace.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace {
+
+const char* const kPath = "zone_trace_test.json";
+
+std::string ReadFile(const char* path) {
+    std::string text;
+    if (FILE* file = std::fopen(path, "rb")) {
+        char chunk[4096];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) text.append(chunk, n);
+        std::fclose(file);
+    }
+    return text;
+}
+
+size_t Count(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1))
+        ++count;
+    return count;
+}
+
+/// An outer zone around two inner ones, on a thread named `name`.
+void NestedZones(const char* name) {
+    ZoneTrace::SetThreadName(name);
+    ZoneTrace::Scope outer("Outer");
+    for (int i = 0; i < 2; ++i) {
+        ZoneTrace::Scope inner("Inner");
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+} // namespace
+
+UNAUDIO_TEST(NestedZonesOnTwoThreads) {
+    // Both threads start after Start(): they join mid-capture on the spares.
+    ZoneTrace::Start(0);
+    std::thread first(NestedZones, "First \"worker\"");
+    std::thread second(NestedZones, "Second worker");
+    first.join();
+    second.join();
+    ZoneTrace::Stop();
+    UNAUDIO_CHECK(!ZoneTrace::IsActive());
+
+    UNAUDIO_CHECK(ZoneTrace::Dump(kPath) == 6);
+    const std::string json = ReadFile(kPath);
+    UNAUDIO_CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    UNAUDIO_CHECK(json.find("\n]}\n") == json.size() - 4);
+    UNAUDIO_CHECK(Count(json, "\"ph\":\"X\"") == 6);
+    UNAUDIO_CHECK(Count(json, "\"name\":\"Outer\"") == 2);
+    UNAUDIO_CHECK(Count(json, "\"name\":\"Inner\"") == 4);
+    UNAUDIO_CHECK(json.find("\"args\":{\"name\":\"First \\\"worker\\\"\"}") != std::string::npos);
+    UNAUDIO_CHECK(json.find("\"args\":{\"name\":\"Second worker\"}") != std::string::npos);
+
+    // An outer zone closes after its inner ones and spans them.
+    const size_t outer = json.find("\"name\":\"Outer\"");
+    const size_t inner = json.find("\"name\":\"Inner\"");
+    UNAUDIO_CHECK(inner < outer);
+    double innerTs = 0, innerDur = 0, outerTs = 0, outerDur = 0;
+    UNAUDIO_CHECK(std::sscanf(json.c_str() + json.find("\"ts\":", inner), "\"ts\":%lf,\"dur\":%lf",
+                              &innerTs, &innerDur) == 2);
+    UNAUDIO_CHECK(std::sscanf(json.c_str() + json.find("\"ts\":", outer), "\"ts\":%lf,\"dur\":%lf",
+                              &outerTs, &outerDur) == 2);
+    UNAUDIO_CHECK(innerDur >= 100.0);
+    UNAUDIO_CHECK(outerTs <= innerTs && innerTs + innerDur <= outerTs + outerDur);
+    std::remove(kPath);
+}
+
+UNAUDIO_TEST(OverflowKeepsNewestEvents) {
+    ZoneTrace::SetThreadName("Main");
+    ZoneTrace::Start(16);
+    for (uint64_t i = 0; i < 100; ++i) ZoneTrace::Record("Tick", i * 1000, i * 1000 + 500);
+    ZoneTrace::Stop();
+
+    // A wrapped ring gives up its oldest slot, the one the owner would
+    // overwrite next, so 15 of the 16 survive: events 85 to 99.
+    UNAUDIO_CHECK(ZoneTrace::Dump(kPath) == 15);
+    const std::string json = ReadFile(kPath);
+    UNAUDIO_CHECK(Count(json, "\"name\":\"Tick\"") == 15);
+    UNAUDIO_CHECK(json.find("\"ts\":85.000,\"dur\":0.500") != std::string::npos);
+    UNAUDIO_CHECK(json.find("\"ts\":99.000,\"dur\":0.500") != std::string::npos);
+    UNAUDIO_CHECK(json.find("\"ts\":84.000,") == std::string::npos);
+
+    // Stopped captures record nothing; a new one starts its rings over.
+    { ZoneTrace::Scope late("Late"); }
+    UNAUDIO_CHECK(ZoneTrace::Dump(kPath) == 15);
+    UNAUDIO_CHECK(ReadFile(kPath).find("Late") == std::string::npos);
+    ZoneTrace::Start(16);
+    ZoneTrace::Record("Fresh", 0, 1);
+    ZoneTrace::Stop();
+    UNAUDIO_CHECK(ZoneTrace::Dump(kPath) == 1);
+    std::remove(kPath);
+}
+
+UNAUDIO_TEST(DumpFailsOnBadPath) {
+    UNAUDIO_CHECK(ZoneTrace::Dump(nullptr) == -1);
+    UNAUDIO_CHECK(ZoneTrace::Dump("no_such_dir/zones.json") == -1);
+}
+
+int main() { return test::RunAll(); }
@@ -0,0 +1,529 @@
+// unaudio_replay – feeds a call trace (UNAudio_StartCallTrace) back through
+// the engine with an offline output and reports per-block render cost.
+//
+//   unaudio_replay <trace.untr> [--block <frames>] [--tail <seconds>]
+//                  [--device <channels>] [--format f32|s16|s24|s32]
+//                  [--decode-threads <n>] [--zones <trace.json>]
+//
+// Calls are issued at the DSP frame they were recorded at; in between, the
+// engine renders as fast as it can.  Handles returned during recording are
+// mapped to the ones returned during replay, so a trace that starts mid-
+// session simply skips calls on objects it never saw created.  --device and
+// --format render through AudioEngine::RenderDevice, so the per-block cost
+// includes the channel matrix and sample conversion of such a device.
+// Blocks are rendered back to back, faster than real time, so decode-ahead
+// workers fall behind more often than on a device; the report counts how much
+// the render thread decoded itself.  --zones captures the replay's trace
+// zones (UNAudio_DumpTrace) for chrome://tracing or Perfetto.
+
+#include "Core/AudioEngine.h"
+#include "Core/CallTrace.h"
+#include "Mixer/OutputConverter.h"
+#include "Platform/Offline/OfflineOutput.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using TraceRecord = CallTrace::TraceRecord;
+
+/// Device buffer emulated by the offline output (0 channels = the mix layout).
+struct DeviceFormat {
+    int32_t channels = 0;
+    UNAudioSampleFormat format = UNAUDIO_SAMPLE_FLOAT32;
+
+    bool IsMixFormat() const { return channels == 0 && format == UNAUDIO_SAMPLE_FLOAT32; }
+};
+
+// ── Trace file ───────────────────────────────────────────────────
+
+class TraceFile {
+public:
+    ~TraceFile() { if (file_) std::fclose(file_); }
+
+    bool Open(const char* path) {
+        file_ = std::fopen(path, "rb");
+        if (!file_) return false;
+        if (std::fread(&header_, sizeof(header_), 1, file_) != 1) return false;
+        return std::memcmp(header_.magic, "UNTR", 4) == 0 &&
+               header_.version == CallTrace::kVersion &&
+               header_.recordSize == sizeof(TraceRecord) && header_.capacity > 0;
+    }
+
+    /// Records oldest first; once the ring has wrapped the oldest sits at
+    /// slot recordCount % capacity.
+    bool ReadRecords(std::vector<TraceRecord>& out) {
+        const uint64_t count = std::min<uint64_t>(header_.recordCount, header_.capacity);
+        std::vector<TraceRecord> ring(static_cast<size_t>(count));
+        if (count && (!Seek(sizeof(header_)) ||
+                      std::fread(ring.data(), sizeof(TraceRecord), ring.size(), file_) != ring.size()))
+            return false;
+
+        const size_t first = header_.recordCount > header_.capacity
+            ? static_cast<size_t>(header_.recordCount % header_.capacity) : 0;
+        out.clear();
+        out.reserve(ring.size());
+        out.insert(out.end(), ring.begin() + first, ring.end());
+        out.insert(out.end(), ring.begin(), ring.begin() + first);
+        return true;
+    }
+
+    /// Bytes of the blob at `offset` (0 = the recorder failed to store it).
+    bool ReadBlob(uint64_t offset, std::vector<uint8_t>& out) {
+        uint64_t size = 0;
+        if (offset < header_.blobOffset || offset >= header_.blobEnd || !Seek(offset) ||
+            std::fread(&size, sizeof(size), 1, file_) != 1 ||
+            size > header_.blobEnd - offset - sizeof(size))
+            return false;
+        out.resize(static_cast<size_t>(size));
+        return size == 0 || std::fread(out.data(), 1, out.size(), file_) == out.size();
+    }
+
+    const CallTrace::TraceFileHeader& Header() const { return header_; }
+
+private:
+    bool Seek(uint64_t offset) {
+#ifdef _WIN32
+        return _fseeki64(file_, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+        return fseeko(file_, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+    FILE* file_ = nullptr;
+    CallTrace::TraceFileHeader header_{};
+};
+
+int32_t IntArg(const TraceRecord& r, int i) { return static_cast<int32_t>(r.args[i]); }
+
+float FloatArg(const TraceRecord& r, int i) {
+    const uint32_t raw = static_cast<uint32_t>(r.args[i]);
+    float value;
+    std::memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+int32_t IntResult(const TraceRecord& r) { return static_cast<int32_t>(r.result); }
+
+// ── Replay ───────────────────────────────────────────────────────
+
+class Replayer {
+public:
+    /// Decode thread count that keeps the one in the trace.
+    static constexpr int32_t kTracedDecodeThreads = -2;
+
+    Replayer(TraceFile& trace, int32_t blockOverride, DeviceFormat device,
+             int32_t decodeThreads)
+        : trace_(trace), blockOverride_(blockOverride), device_(device),
+          decodeThreads_(decodeThreads) {}
+
+    /// Render until the replay clock reaches `frame` (relative to the trace start).
+    void AdvanceTo(int64_t frame) {
+        if (!output_) {
+            clock_ = std::max(clock_, frame);   // no engine running: time just passes
+            return;
+        }
+        while (clock_ < frame) RenderBlock();
+    }
+
+    void RenderTail(double seconds) {
+        if (!output_) return;
+        AdvanceTo(clock_ + static_cast<int64_t>(seconds * config_.sampleRate));
+    }
+
+    void Issue(const TraceRecord& r) {
+        if (Dispatch(r)) ++issued_;
+        else ++skipped_;
+    }
+
+    void Finish() {
+        UNAudio_Shutdown();
+        output_.reset();
+    }
+
+    void Report() const;
+
+private:
+    static void Pull(void* buffer, int32_t frames, void* user) {
+        const auto& self = *static_cast<const Replayer*>(user);
+        if (self.device_.IsMixFormat())
+            AudioEngine::Instance().Render(static_cast<float*>(buffer), frames);
+        else
+            AudioEngine::Instance().RenderDevice(
+                buffer, frames,
+                self.device_.channels > 0 ? self.device_.channels : self.config_.channels,
+                self.device_.format);
+    }
+
+    void RenderBlock() {
+        const auto begin = std::chrono::steady_clock::now();
+        output_->RenderBlock();
+        const auto end = std::chrono::steady_clock::now();
+        blockMicros_.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+        clock_ += config_.bufferSize;
+        renderedFrames_ += config_.bufferSize;
+    }
+
+    bool Map(const std::unordered_map<int32_t, int32_t>& map, int32_t recorded,
+             int32_t& replayed) const {
+        auto it = map.find(recorded);
+        if (it == map.end()) return false;
+        replayed = it->second;
+        return true;
+    }
+
+    void Bind(std::unordered_map<int32_t, int32_t>& map, int32_t recorded, int32_t replayed) {
+        if (recorded >= 0 && replayed >= 0) map[recorded] = replayed;
+    }
+
+    bool Dispatch(const TraceRecord& r);
+
+    TraceFile& trace_;
+    int32_t blockOverride_;
+    DeviceFormat device_;
+    int32_t decodeThreads_;
+    std::unique_ptr<OfflineOutput> output_;
+    UNAudioOutputConfig config_{};
+    std::unordered_map<int32_t, int32_t> sources_, banks_, voices_;
+    std::vector<uint8_t> blob_;
+    std::vector<double> blockMicros_;
+    int64_t clock_ = 0;
+    int64_t renderedFrames_ = 0;
+    int32_t sampleRate_ = 0;
+    int32_t blockFrames_ = 0;
+    int64_t issued_ = 0;
+    int64_t skipped_ = 0;
+};
+
+bool Replayer::Dispatch(const TraceRecord& r) {
+    int32_t a = -1, b = -1;
+    switch (static_cast<TraceOp>(r.op)) {
+    case TraceOp::Initialize: {
+        if (r.argCount < 1 || !trace_.ReadBlob(r.args[0], blob_) ||
+            blob_.size() != sizeof(UNAudioOutputConfig))
+            return false;
+        std::memcpy(&config_, blob_.data(), sizeof(config_));
+        if (blockOverride_ > 0) config_.bufferSize = blockOverride_;
+        if (decodeThreads_ != kTracedDecodeThreads) UNAudio_SetDecodeThreads(decodeThreads_);
+        if (UNAudio_Initialize(config_) != UNAUDIO_OK) return false;
+        output_ = std::make_unique<OfflineOutput>(&Replayer::Pull, this);
+        output_->SetDeviceFormat(device_.channels, device_.format);
+        if (!device_.IsMixFormat())
+            AudioEngine::Instance().PrepareDevice(
+                device_.channels > 0 ? device_.channels : config_.channels, device_.format);
+        if (!output_->Initialize(config_) || !output_->Start()) {
+            output_.reset();
+            return false;
+        }
+        sampleRate_ = config_.sampleRate;
+        blockFrames_ = config_.bufferSize;
+        return true;
+    }
+    case TraceOp::Shutdown:
+        UNAudio_Shutdown();
+        output_.reset();
+        sources_.clear();
+        banks_.clear();
+        voices_.clear();
+        return true;
+
+    case TraceOp::LoadAudio:
+    case TraceOp::LoadAudioAsync: {
+        if (r.argCount < 2 || !trace_.ReadBlob(r.args[0], blob_) || blob_.empty()) return false;
+        const int32_t size = static_cast<int32_t>(blob_.size());
+        const int32_t handle = static_cast<TraceOp>(r.op) == TraceOp::LoadAudio
+            ? UNAudio_LoadAudio(blob_.data(), size, IntArg(r, 1))
+            : UNAudio_LoadAudioAsync(blob_.data(), size, IntArg(r, 1));
+        Bind(sources_, IntResult(r), handle);
+        return true;
+    }
+    case TraceOp::UnloadAudio:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_UnloadAudio(a);
+        sources_.erase(IntArg(r, 0));
+        return true;
+    case TraceOp::CancelLoad:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_CancelLoad(a);
+        return true;
+
+    case TraceOp::OpenBank: {
+        if (r.argCount < 1 || !trace_.ReadBlob(r.args[0], blob_)) return false;
+        blob_.push_back(0);
+        Bind(banks_, IntResult(r), UNAudio_OpenBank(reinterpret_cast<const char*>(blob_.data())));
+        return true;
+    }
+    case TraceOp::CloseBank:
+        if (!Map(banks_, IntArg(r, 0), a)) return false;
+        UNAudio_CloseBank(a);
+        banks_.erase(IntArg(r, 0));
+        return true;
+    case TraceOp::LoadFromBank:
+        if (!Map(banks_, IntArg(r, 0), a)) return false;
+        Bind(sources_, IntResult(r), UNAudio_LoadFromBank(a, IntArg(r, 1), IntArg(r, 2)));
+        return true;
+
+    case TraceOp::Play:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_Play(a);
+        return true;
+    case TraceOp::Pause:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_Pause(a);
+        return true;
+    case TraceOp::Stop:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_Stop(a);
+        return true;
+    case TraceOp::SetVolume:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_SetVolume(a, FloatArg(r, 1));
+        return true;
+    case TraceOp::SetLoop:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_SetLoop(a, IntArg(r, 1));
+        return true;
+    case TraceOp::SetAttackCache:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_SetAttackCache(a, FloatArg(r, 1));
+        return true;
+    case TraceOp::FadeVolume:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_FadeVolume(a, FloatArg(r, 1), FloatArg(r, 2), IntArg(r, 3));
+        return true;
+    case TraceOp::Crossfade:
+        if (!Map(sources_, IntArg(r, 0), a) || !Map(sources_, IntArg(r, 1), b)) return false;
+        UNAudio_Crossfade(a, b, FloatArg(r, 2));
+        return true;
+    case TraceOp::BuildWaveformPeaks:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_BuildWaveformPeaks(a);
+        return true;
+    case TraceOp::LoadWaveformPeaks:
+        if (!Map(sources_, IntArg(r, 0), a) || r.argCount < 2 ||
+            !trace_.ReadBlob(r.args[1], blob_))
+            return false;
+        UNAudio_LoadWaveformPeaks(a, blob_.data(), static_cast<int32_t>(blob_.size()));
+        return true;
+
+    case TraceOp::PlayInstance:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        Bind(voices_, IntResult(r), UNAudio_PlayInstance(a));
+        return true;
+    case TraceOp::StopVoice:
+        if (!Map(voices_, IntArg(r, 0), a)) return false;
+        UNAudio_StopVoice(a);
+        return true;
+    case TraceOp::SetVoiceVolume:
+        if (!Map(voices_, IntArg(r, 0), a)) return false;
+        UNAudio_SetVoiceVolume(a, FloatArg(r, 1));
+        return true;
+    case TraceOp::FadeVoiceVolume:
+        if (!Map(voices_, IntArg(r, 0), a)) return false;
+        UNAudio_FadeVoiceVolume(a, FloatArg(r, 1), FloatArg(r, 2), IntArg(r, 3));
+        return true;
+
+    case TraceOp::SetMasterVolume:
+        UNAudio_SetMasterVolume(FloatArg(r, 0));
+        return true;
+    case TraceOp::FadeMasterVolume:
+        UNAudio_FadeMasterVolume(FloatArg(r, 0), FloatArg(r, 1), IntArg(r, 2));
+        return true;
+    case TraceOp::SetBufferSize:
+        UNAudio_SetBufferSize(IntArg(r, 0));
+        return true;
+    case TraceOp::SetMemoryBudget:
+        UNAudio_SetMemoryBudget(static_cast<int64_t>(r.args[0]));
+        return true;
+
+    case TraceOp::SetReverb: {
+        UNAudioReverbParams params;
+        if (r.argCount < 1 || !trace_.ReadBlob(r.args[0], blob_) ||
+            blob_.size() != sizeof(params))
+            return false;
+        std::memcpy(&params, blob_.data(), sizeof(params));
+        UNAudio_SetReverb(params);
+        return true;
+    }
+    case TraceOp::SetSendLevel:
+        if (!Map(sources_, IntArg(r, 0), a)) return false;
+        UNAudio_SetSendLevel(a, FloatArg(r, 1));
+        return true;
+    case TraceOp::SetVoiceSendLevel:
+        if (!Map(voices_, IntArg(r, 0), a)) return false;
+        UNAudio_SetVoiceSendLevel(a, FloatArg(r, 1));
+        return true;
+    case TraceOp::ResetMasterLoudness:
+        UNAudio_ResetMasterLoudness();
+        return true;
+    case TraceOp::SetVoiceMetering:
+        UNAudio_SetVoiceMetering(IntArg(r, 0));
+        return true;
+    case TraceOp::SetDecodeThreads:
+        if (decodeThreads_ != kTracedDecodeThreads) return false;
+        UNAudio_SetDecodeThreads(IntArg(r, 0));
+        return true;
+
+    // Queries and tooling calls (transcode, bank writing) leave the mix
+    // untouched; replaying them would only add noise to the timings.
+    default:
+        return false;
+    }
+}
+
+void Replayer::Report() const {
+    std::printf("calls:     %lld replayed, %lld skipped\n",
+                static_cast<long long>(issued_), static_cast<long long>(skipped_));
+    if (blockMicros_.empty() || sampleRate_ <= 0) {
+        std::printf("no blocks rendered\n");
+        return;
+    }
+
+    std::vector<double> sorted = blockMicros_;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double us : sorted) total += us;
+    auto percentile = [&](double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+
+    const double audioSeconds = static_cast<double>(renderedFrames_) / sampleRate_;
+    const double budget = 1e6 * blockFrames_ / sampleRate_;
+    const auto overruns = std::count_if(sorted.begin(), sorted.end(),
+                                        [&](double us) { return us > budget; });
+
+    std::printf("blocks:    %zu x %d frames @ %d Hz (%.2f s of audio)\n",
+                sorted.size(), blockFrames_, sampleRate_, audioSeconds);
+    std::printf("render:    %.3f s wall, %.1fx realtime\n",
+                total / 1e6, total > 0.0 ? audioSeconds * 1e6 / total : 0.0);
+    std::printf("per block: min %.1f  mean %.1f  p50 %.1f  p99 %.1f  max %.1f us\n",
+                sorted.front(), total / sorted.size(), percentile(0.50), percentile(0.99),
+                sorted.back());
+    std::printf("budget:    %.1f us per block, %lld overruns\n",
+                budget, static_cast<long long>(overruns));
+
+    const UNAudioDecodeStats decode = UNAudio_GetDecodeStats();
+    const int64_t decoded = decode.aheadFrames + decode.inlineFrames;
+    if (decoded > 0)
+        std::printf("decode:    %d workers, %.1f%% of frames ahead, %lld fallbacks, "
+                    "%lld dropouts, %lld steals\n",
+                    decode.workerCount, 100.0 * decode.aheadFrames / decoded,
+                    static_cast<long long>(decode.fallbacks),
+                    static_cast<long long>(decode.dropouts), static_cast<long long>(decode.steals));
+}
+
+void PrintUsage() {
+    std::fprintf(stderr,
+                 "usage: unaudio_replay <trace> [--block <frames>] [--tail <seconds>]\n"
+                 "                      [--device <channels>] [--format f32|s16|s24|s32]\n"
+                 "                      [--decode-threads <n>] [--zones <trace.json>]\n"
+                 "  --block   render block size (default: the traced bufferSize)\n"
+                 "  --tail    audio rendered after the last call (default 1)\n"
+                 "  --device  device channels 1, 2, 6 or 8 (default: the mix layout)\n"
+                 "  --format  device sample format (default f32)\n"
+                 "  --decode-threads  decode-ahead workers, -1 = auto, 0 = off\n"
+                 "                    (default: as traced)\n"
+                 "  --zones   write a Chrome trace of the replay's hot paths\n");
+}
+
+bool ParseFormat(const char* name, UNAudioSampleFormat& format) {
+    static const struct { const char* name; UNAudioSampleFormat format; } kFormats[] = {
+        { "f32", UNAUDIO_SAMPLE_FLOAT32 }, { "s16", UNAUDIO_SAMPLE_S16 },
+        { "s24", UNAUDIO_SAMPLE_S24 },     { "s32", UNAUDIO_SAMPLE_S32 },
+    };
+    for (const auto& entry : kFormats) {
+        if (std::strcmp(name, entry.name) == 0) {
+            format = entry.format;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    int32_t block = 0;
+    double tail = 1.0;
+    DeviceFormat device;
+    int32_t decodeThreads = Replayer::kTracedDecodeThreads;
+    const char* zonesPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--block") == 0 && i + 1 < argc)
+            block = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--tail") == 0 && i + 1 < argc)
+            tail = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--decode-threads") == 0 && i + 1 < argc)
+            decodeThreads = std::max(std::atoi(argv[++i]), -1);
+        else if (std::strcmp(argv[i], "--zones") == 0 && i + 1 < argc)
+            zonesPath = argv[++i];
+        else if (std::strcmp(argv[i], "--device") == 0 && i + 1 < argc)
+            device.channels = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc &&
+                 ParseFormat(argv[i + 1], device.format))
+            ++i;
+        else if (!path && argv[i][0] != '-')
+            path = argv[i];
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (!path || (device.channels != 0 && !OutputConverter::IsSupportedLayout(device.channels))) {
+        PrintUsage();
+        return 2;
+    }
+
+    TraceFile trace;
+    std::vector<TraceRecord> records;
+    if (!trace.Open(path) || !trace.ReadRecords(records)) {
+        std::fprintf(stderr, "unaudio_replay: cannot read trace '%s'\n", path);
+        return 1;
+    }
+    if (trace.Header().recordCount > records.size())
+        std::printf("ring wrapped: replaying the last %zu of %llu calls\n", records.size(),
+                    static_cast<unsigned long long>(trace.Header().recordCount));
+
+    // A wrapped ring has lost the Initialize; restart from the latest config.
+    if (!records.empty() && records.front().op != static_cast<uint16_t>(TraceOp::Initialize) &&
+        trace.Header().configBlob != 0) {
+        TraceRecord init{};
+        init.dspFrame = records.front().dspFrame;
+        init.op       = static_cast<uint16_t>(TraceOp::Initialize);
+        init.argCount = 1;
+        init.args[0]  = trace.Header().configBlob;
+        records.insert(records.begin(), init);
+    }
+
+    if (zonesPath && UNAudio_StartZoneTrace(0) != UNAUDIO_OK) {
+        std::fprintf(stderr, "unaudio_replay: built without trace zones (UNAUDIO_ZONES)\n");
+        return 2;
+    }
+
+    Replayer replayer(trace, block, device, decodeThreads);
+    const int64_t firstFrame = records.empty() ? 0 : records.front().dspFrame;
+    for (const TraceRecord& record : records) {
+        replayer.AdvanceTo(record.dspFrame - firstFrame);
+        replayer.Issue(record);
+    }
+    replayer.RenderTail(tail);
+    replayer.Report();
+    if (zonesPath) {
+        UNAudio_StopZoneTrace();
+        const int32_t events = UNAudio_DumpTrace(zonesPath);
+        if (events < 0)
+            std::fprintf(stderr, "unaudio_replay: cannot write '%s'\n", zonesPath);
+        else
+            std::printf("zones:     %d events -> %s\n", events, zonesPath);
+    }
+    replayer.Finish();
+    return 0;
+}
@@ -35,6 +35,62 @@ namespace UNAudio
         [DllImport(LibName, EntryPoint = "UNAudio_UnloadAudio")]
         public static extern void UnloadAudio(int handle);
 
+        [DllImport(LibName, EntryPoint = "UNAudio_LoadAudioAsync")]
+        private static extern int UNAudio_LoadAudioAsync(byte[] data, int size, int compressionMode);
+
+        /// <summary>
+        /// Queue a clip for background decoding. Returns a pending handle immediately;
+        /// poll <see cref="GetLoadStatus"/> until it reports Loaded.
+        /// </summary>
+        public static int LoadAudioAsync(byte[] data, int compressionMode)
+        {
+            if (data == null || data.Length == 0) return -1;
+            return UNAudio_LoadAudioAsync(data, data.Length, compressionMode);
+        }
+
+        [DllImport(LibName, EntryPoint = "UNAudio_GetLoadStatus")]
+        public static extern int GetLoadStatus(int handle);
+        [DllImport(LibName, EntryPoint = "UNAudio_CancelLoad")]
+        public static extern int CancelLoad(int handle);
+
+        /// <summary>
+        /// Query many load handles under a single native lock.
+        /// Returns the number of handles whose load has completed (loaded, failed or cancelled).
+        /// </summary>
+        [DllImport(LibName, EntryPoint = "UNAudio_GetLoadStatusBatch")]
+        public static extern int GetLoadStatusBatch(int[] handles, int count, int[] outStatus);
+
+        [DllImport(LibName, EntryPoint = "UNAudio_TranscodeADPCM")]
+        private static extern int UNAudio_TranscodeADPCM(byte[] data, int size,
+                                                         byte[] outBuffer, int outCapacity);
+
+        /// <summary>
+        /// Transcode an encoded clip to the native block ADPCM container.
+        /// Returns null if the source format cannot be decoded.
+        /// </summary>
+        public static byte[] TranscodeADPCM(byte[] data)
+        {
+            if (data == null || data.Length == 0) return null;
+            int size = UNAudio_TranscodeADPCM(data, data.Length, null, 0);
+            if (size <= 0) return null;
+
+            var output = new byte[size];
+            return UNAudio_TranscodeADPCM(data, data.Length, output, size) == size ? output : null;
+        }
+
+        // ── Clip banks ───────────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_WriteBank")]
+        public static extern int WriteBank(string path, byte[] data, int[] sizes, int count);
+        [DllImport(LibName, EntryPoint = "UNAudio_OpenBank")]
+        public static extern int OpenBank(string path);
+        [DllImport(LibName, EntryPoint = "UNAudio_CloseBank")]
+        public static extern void CloseBank(int bankId);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetBankClipCount")]
+        public static extern int GetBankClipCount(int bankId);
+        [DllImport(LibName, EntryPoint = "UNAudio_LoadFromBank")]
+        public static extern int LoadFromBank(int bankId, int clipIndex, int compressionMode);
+
         // ── Playback ─────────────────────────────────────────────
 
         [DllImport(LibName, EntryPoint = "UNAudio_Play")]
@@ -44,6 +100,59 @@ namespace UNAudio
         [DllImport(LibName, EntryPoint = "UNAudio_Stop")]
         public static extern int Stop(int handle);
 
+        // ── Instanced voices ─────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_PlayInstance")]
+        public static extern int PlayInstance(int handle);
+        [DllImport(LibName, EntryPoint = "UNAudio_StopVoice")]
+        public static extern int StopVoice(int voice);
+        [DllImport(LibName, EntryPoint = "UNAudio_SetVoiceVolume")]
+        public static extern void SetVoiceVolume(int voice, float volume);
+        [DllImport(LibName, EntryPoint = "UNAudio_FadeVoiceVolume")]
+        public static extern int FadeVoiceVolume(int voice, float volume, float milliseconds, int curve);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetVoiceState")]
+        public static extern int GetVoiceState(int voice);
+
+        // ── Reverb ───────────────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_SetReverb")]
+        public static extern int SetReverb(UNAudioReverbParams parameters);
+        [DllImport(LibName, EntryPoint = "UNAudio_SetSendLevel")]
+        public static extern void SetSendLevel(int handle, float level);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetSendLevel")]
+        public static extern float GetSendLevel(int handle);
+        [DllImport(LibName, EntryPoint = "UNAudio_SetVoiceSendLevel")]
+        public static extern void SetVoiceSendLevel(int voice, float level);
+
+        // ── Metering ─────────────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_GetMasterLevels")]
+        public static extern UNAudioLevels GetMasterLevels();
+        [DllImport(LibName, EntryPoint = "UNAudio_ResetMasterLoudness")]
+        public static extern void ResetMasterLoudness();
+
+        /// <summary>
+        /// Levels of many voices in one call; stale handles read as silence.
+        /// Returns the number of valid handles.
+        /// </summary>
+        [DllImport(LibName, EntryPoint = "UNAudio_GetVoiceLevels")]
+        public static extern int GetVoiceLevels(int[] voices, int count, [Out] UNAudioLevels[] outLevels);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetSourceLevels")]
+        public static extern int GetSourceLevels(int[] handles, int count, [Out] UNAudioLevels[] outLevels);
+        [DllImport(LibName, EntryPoint = "UNAudio_SetVoiceMetering")]
+        public static extern int SetVoiceMetering(int flags);
+
+        // ── Decode-ahead ─────────────────────────────────────────
+
+        /// <summary>
+        /// Decode-ahead worker threads used by the next Initialize
+        /// (-1 = one per core but one, 0 = off).
+        /// </summary>
+        [DllImport(LibName, EntryPoint = "UNAudio_SetDecodeThreads")]
+        public static extern int SetDecodeThreads(int count);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetDecodeStats")]
+        public static extern UNAudioDecodeStats GetDecodeStats();
+
         // ── Properties ───────────────────────────────────────────
 
         [DllImport(LibName, EntryPoint = "UNAudio_SetVolume")]
@@ -54,6 +163,43 @@ namespace UNAudio
         public static extern void SetLoop(int handle, bool loop);
         [DllImport(LibName, EntryPoint = "UNAudio_GetState")]
         public static extern int GetState(int handle);
+        [DllImport(LibName, EntryPoint = "UNAudio_SetAttackCache")]
+        public static extern int SetAttackCache(int handle, float milliseconds);
+
+        // ── Waveform summaries ───────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_BuildWaveformPeaks")]
+        public static extern int BuildWaveformPeaks(int handle);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetWaveformPeaks")]
+        public static extern int GetWaveformPeaks(int handle, int level, int start, int count,
+                                                  [Out] UNAudioPeakBin[] outBins);
+        [DllImport(LibName, EntryPoint = "UNAudio_SaveWaveformPeaks")]
+        private static extern int UNAudio_SaveWaveformPeaks(int handle, byte[] outBuffer, int outCapacity);
+        [DllImport(LibName, EntryPoint = "UNAudio_LoadWaveformPeaks")]
+        private static extern int UNAudio_LoadWaveformPeaks(int handle, byte[] data, int size);
+
+        /// <summary>Serialise a clip's waveform summary as a sidecar blob (null on failure).</summary>
+        public static byte[] SaveWaveformPeaks(int handle)
+        {
+            int size = UNAudio_SaveWaveformPeaks(handle, null, 0);
+            if (size <= 0) return null;
+
+            var output = new byte[size];
+            return UNAudio_SaveWaveformPeaks(handle, output, size) == size ? output : null;
+        }
+
+        public static int LoadWaveformPeaks(int handle, byte[] data)
+        {
+            if (data == null || data.Length == 0) return -1;
+            return UNAudio_LoadWaveformPeaks(handle, data, data.Length);
+        }
+
+        // ── Gain automation ──────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_FadeVolume")]
+        public static extern int FadeVolume(int handle, float volume, float milliseconds, int curve);
+        [DllImport(LibName, EntryPoint = "UNAudio_Crossfade")]
+        public static extern int Crossfade(int from, int to, float milliseconds);
 
         // ── Engine-level ─────────────────────────────────────────
 
@@ -61,10 +207,34 @@ namespace UNAudio
         public static extern void SetMasterVolume(float volume);
         [DllImport(LibName, EntryPoint = "UNAudio_GetMasterVolume")]
         public static extern float GetMasterVolume();
+        [DllImport(LibName, EntryPoint = "UNAudio_FadeMasterVolume")]
+        public static extern int FadeMasterVolume(float volume, float milliseconds, int curve);
+        [DllImport(LibName, EntryPoint = "UNAudio_SetMemoryBudget")]
+        public static extern int SetMemoryBudget(long bytes);
+        [DllImport(LibName, EntryPoint = "UNAudio_GetMemoryStats")]
+        public static extern UNAudioMemoryStats GetMemoryStats();
+        [DllImport(LibName, EntryPoint = "UNAudio_GetClipMemory")]
+        public static extern UNAudioMemoryUsage GetClipMemory(int handle);
         [DllImport(LibName, EntryPoint = "UNAudio_SetBufferSize")]
         public static extern void SetBufferSize(int frames);
         [DllImport(LibName, EntryPoint = "UNAudio_GetCurrentLatency")]
         public static extern float GetCurrentLatency();
+
+        // ── Call trace ───────────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_StartCallTrace")]
+        public static extern int StartCallTrace(string path, int capacity);
+        [DllImport(LibName, EntryPoint = "UNAudio_StopCallTrace")]
+        public static extern void StopCallTrace();
+
+        // ── Trace zones ──────────────────────────────────────────
+
+        [DllImport(LibName, EntryPoint = "UNAudio_StartZoneTrace")]
+        public static extern int StartZoneTrace(int capacity);
+        [DllImport(LibName, EntryPoint = "UNAudio_StopZoneTrace")]
+        public static extern void StopZoneTrace();
+        [DllImport(LibName, EntryPoint = "UNAudio_DumpTrace")]
+        public static extern int DumpTrace(string path);
     }
 
     /// <summary>
@@ -80,4 +250,90 @@ namespace UNAudio
         public int bufferCount;
         public int exclusiveMode;
     }
+
+    /// <summary>
+    /// One waveform summary bin (all channels folded).
+    /// Must match the C struct UNAudioPeakBin layout.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct UNAudioPeakBin
+    {
+        public float min;
+        public float max;
+        public float rms;
+    }
+
+    /// <summary>
+    /// Native bytes held by one clip or the whole engine, by category.
+    /// Must match the C struct UNAudioMemoryUsage layout.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct UNAudioMemoryUsage
+    {
+        public long compressedBytes;
+        public long pcmBytes;
+        public long streamBytes;
+        public long decoderBytes;
+    }
+
+    /// <summary>
+    /// Engine-wide memory accounting and budget state.
+    /// Must match the C struct UNAudioMemoryStats layout.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct UNAudioMemoryStats
+    {
+        public UNAudioMemoryUsage usage;
+        public long totalBytes;
+        public long budgetBytes;
+        public int clipCount;
+        public int demotedClips;
+        public long demotions;
+        public long promotions;
+    }
+
+    /// <summary>
+    /// Send-bus reverb settings (lineCount 0 removes the reverb).
+    /// Must match the C struct UNAudioReverbParams layout.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct UNAudioReverbParams
+    {
+        public int lineCount;
+        public float decayTime;
+        public float damping;
+        public float wetLevel;
+    }
+
+    /// <summary>
+    /// Meter reading of a voice or the output: linear levels, loudness in LUFS
+    /// (negative infinity for silence or when not metered).
+    /// Must match the C struct UNAudioLevels layout.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct UNAudioLevels
+    {
+        public float rms;
+        public float peak;
+        public float truePeak;
+        public float momentaryLufs;
+        public float shortTermLufs;
+        public float integratedLufs;
+    }
+
+    /// <summary>
+    /// Decode-ahead counters since Initialize.
+    /// Must match the C struct UNAudioDecodeStats layout.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct UNAudioDecodeStats
+    {
+        public int workerCount;
+        public int streamCount;
+        public long aheadFrames;
+        public long inlineFrames;
+        public long fallbacks;
+        public long dropouts;
+        public long steals;
+    }
 }
@@ -2,6 +2,21 @@ using UnityEngine;
 
 namespace UNAudio
 {
+    /// <summary>
+    /// Optional parts of per-voice metering. Must match the C enum UNAudioMeterFlags.
+    /// </summary>
+    [System.Flags]
+    public enum MeterFlags
+    {
+        /// <summary>RMS and sample peak only.</summary>
+        None = 0,
+        /// <summary>K-weighted momentary, short-term and integrated loudness.</summary>
+        Loudness = 1,
+        /// <summary>4x oversampled true peak.</summary>
+        TruePeak = 2,
+        All = Loudness | TruePeak
+    }
+
     /// <summary>
     /// High-level singleton that manages the native audio engine lifetime
     /// and provides convenient access to engine-wide settings.
@@ -38,6 +53,36 @@ namespace UNAudio
         [Tooltip("Number of buffers (double/triple buffering).")]
         public int bufferCount = 2;
 
+        [Header("Decoding")]
+        [Tooltip("Worker threads that decode compressed voices ahead of the mix: " +
+                 "-1 = one per core but one, 0 = decode in the audio callback. Applied at initialisation.")]
+        public int decodeThreads = -1;
+
+        [Header("Memory")]
+        [Tooltip("Native audio memory budget in bytes (0 = unlimited). Over budget, " +
+                 "least recently played Decompress On Load clips fall back to compressed playback.")]
+        public long memoryBudget = 0;
+
+        [Header("Reverb")]
+        [Tooltip("Delay lines of the shared reverb: 0 = off, 8 = cheaper, 16 = denser.")]
+        public int reverbLines = 0;
+
+        [Tooltip("Seconds for the reverb tail to decay by 60 dB.")]
+        public float reverbDecayTime = 1.5f;
+
+        [Range(0f, 1f)]
+        [Tooltip("How much faster high frequencies die away than low ones.")]
+        public float reverbDamping = 0.5f;
+
+        [Range(0f, 1f)]
+        [Tooltip("Level of the reverb return in the mix.")]
+        public float reverbWetLevel = 0.3f;
+
+        [Header("Metering")]
+        [Tooltip("Optional per-voice measurements. RMS and peak are always metered; " +
+                 "true peak costs about twice as much as loudness.")]
+        public MeterFlags voiceMetering = MeterFlags.Loudness;
+
         /// <summary>Whether the native engine is currently initialised.</summary>
         public bool IsInitialized => UNAudioBridge.IsInitialized() != 0;
 
@@ -78,11 +123,17 @@ namespace UNAudio
                 exclusiveMode = 0
             };
 
+            UNAudioBridge.SetDecodeThreads(decodeThreads);
             int result = UNAudioBridge.Initialize(config);
             if (result != 0)
+            {
                 Debug.LogError($"[UNAudio] Engine initialisation failed (code {result}).");
-            else
-                Debug.Log("[UNAudio] Engine initialised successfully.");
+                return;
+            }
+            UNAudioBridge.SetMemoryBudget(memoryBudget);
+            UNAudioBridge.SetVoiceMetering((int)voiceMetering);
+            if (reverbLines > 0) ApplyReverb();
+            Debug.Log("[UNAudio] Engine initialised successfully.");
         }
 
         // ── Engine-level controls ────────────────────────────────
@@ -93,6 +144,81 @@ namespace UNAudio
         /// <summary>Get the master output volume.</summary>
         public float GetMasterVolume() => UNAudioBridge.GetMasterVolume();
 
+        /// <summary>Ramp the master volume natively over <paramref name="seconds"/>.</summary>
+        public void FadeMasterVolume(float volume, float seconds, FadeCurve curve = FadeCurve.Linear)
+            => UNAudioBridge.FadeMasterVolume(volume, seconds * 1000f, (int)curve);
+
+        /// <summary>
+        /// Set the native audio memory budget in bytes (0 = unlimited). Demotes
+        /// least recently played Decompress On Load clips immediately if over.
+        /// </summary>
+        public void SetMemoryBudget(long bytes)
+        {
+            memoryBudget = bytes;
+            UNAudioBridge.SetMemoryBudget(bytes);
+        }
+
+        /// <summary>Native memory accounting and budget state.</summary>
+        public UNAudioMemoryStats GetMemoryStats() => UNAudioBridge.GetMemoryStats();
+
+        /// <summary>
+        /// Decode-ahead counters. A rising <c>fallbacks</c> count means the
+        /// workers fall behind and the audio callback decodes voices itself.
+        /// </summary>
+        public UNAudioDecodeStats GetDecodeStats() => UNAudioBridge.GetDecodeStats();
+
+        /// <summary>
+        /// Configure the shared reverb that sources feed through
+        /// <see cref="UNAudioSource.reverbSend"/>. <paramref name="lines"/> is
+        /// 8 or 16, or 0 to remove it.
+        /// </summary>
+        public void SetReverb(int lines, float decayTime, float damping, float wetLevel)
+        {
+            reverbLines = lines;
+            reverbDecayTime = decayTime;
+            reverbDamping = damping;
+            reverbWetLevel = wetLevel;
+            ApplyReverb();
+        }
+
+        private void ApplyReverb()
+        {
+            int result = UNAudioBridge.SetReverb(new UNAudioReverbParams
+            {
+                lineCount = reverbLines,
+                decayTime = reverbDecayTime,
+                damping   = reverbDamping,
+                wetLevel  = reverbWetLevel
+            });
+            if (result != 0)
+                Debug.LogWarning($"[UNAudio] Reverb settings rejected (code {result}).");
+        }
+
+        /// <summary>Levels and loudness of the output, after master volume.</summary>
+        public UNAudioLevels GetMasterLevels() => UNAudioBridge.GetMasterLevels();
+
+        /// <summary>Restart the output's integrated loudness measurement.</summary>
+        public void ResetMasterLoudness() => UNAudioBridge.ResetMasterLoudness();
+
+        /// <summary>
+        /// Levels of many voices (from <see cref="UNAudioSource.PlayOneShot"/>)
+        /// in one native call. <paramref name="results"/> must be at least as
+        /// long as <paramref name="voices"/>. Returns how many handles were valid.
+        /// </summary>
+        public int GetVoiceLevels(int[] voices, UNAudioLevels[] results)
+        {
+            if (voices == null || results == null) return 0;
+            int count = Mathf.Min(voices.Length, results.Length);
+            return UNAudioBridge.GetVoiceLevels(voices, count, results);
+        }
+
+        /// <summary>Choose the optional per-voice measurements.</summary>
+        public void SetVoiceMetering(MeterFlags flags)
+        {
+            voiceMetering = flags;
+            UNAudioBridge.SetVoiceMetering((int)flags);
+        }
+
         /// <summary>Change the audio buffer size at runtime.</summary>
         public void SetBufferSize(int frames)
         {
@@ -0,0 +1,81 @@
+using System;
+using System.Collections.Generic;
+
+namespace UNAudio
+{
+    /// <summary>
+    /// A packed clip bank: many encoded clips in one memory-mapped file.
+    /// Opening a bank is a single mmap; loading a clip is an O(1) index lookup
+    /// with the decoder reading straight from the mapping (no managed copy).
+    /// </summary>
+    public sealed class UNAudioBank : IDisposable
+    {
+        private int bankId;
+
+        private UNAudioBank(int id)
+        {
+            bankId = id;
+        }
+
+        /// <summary>Whether the bank is open.</summary>
+        public bool IsOpen => bankId >= 0;
+
+        /// <summary>Number of clips stored in the bank.</summary>
+        public int ClipCount => IsOpen ? UNAudioBridge.GetBankClipCount(bankId) : 0;
+
+        /// <summary>
+        /// Map a bank file. The file must be directly readable on disk
+        /// (e.g. not inside a compressed Android APK). Returns null on failure.
+        /// </summary>
+        public static UNAudioBank Open(string path)
+        {
+            if (string.IsNullOrEmpty(path)) return null;
+            int id = UNAudioBridge.OpenBank(path);
+            return id >= 0 ? new UNAudioBank(id) : null;
+        }
+
+        /// <summary>
+        /// Load clip <paramref name="index"/> and return its native handle (-1 on failure).
+        /// The handle stays valid after the bank is closed.
+        /// </summary>
+        public int LoadClip(int index, AudioLoadType loadType = AudioLoadType.CompressedInMemory)
+        {
+            if (!IsOpen) return -1;
+            return UNAudioBridge.LoadFromBank(bankId, index, (int)loadType);
+        }
+
+        /// <summary>Write encoded clips to a new bank file. Returns the native result code.</summary>
+        public static int Write(string path, IList<byte[]> clips)
+        {
+            if (string.IsNullOrEmpty(path) || clips == null || clips.Count == 0)
+                return -1; // UNAUDIO_ERROR_INVALID_PARAM
+
+            long total = 0;
+            var sizes = new int[clips.Count];
+            for (int i = 0; i < clips.Count; i++)
+            {
+                if (clips[i] == null || clips[i].Length == 0) return -1;
+                sizes[i] = clips[i].Length;
+                total += sizes[i];
+            }
+
+            var blob = new byte[total];
+            long offset = 0;
+            foreach (var clip in clips)
+            {
+                Buffer.BlockCopy(clip, 0, blob, (int)offset, clip.Length);
+                offset += clip.Length;
+            }
+
+            return UNAudioBridge.WriteBank(path, blob, sizes, clips.Count);
+        }
+
+        /// <summary>Close the bank. Clips already loaded from it keep playing.</summary>
+        public void Dispose()
+        {
+            if (!IsOpen) return;
+            UNAudioBridge.CloseBank(bankId);
+            bankId = -1;
+        }
+    }
+}
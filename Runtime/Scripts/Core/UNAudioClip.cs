@@ -14,7 +14,31 @@ namespace UNAudio
         /// <summary>Decompress the full clip into PCM when it is loaded.</summary>
         DecompressOnLoad = 1,
         /// <summary>Stream audio data from disk during playback.</summary>
-        Streaming = 2
+        Streaming = 2,
+        /// <summary>
+        /// Transcode to 4-bit block ADPCM (~4:1 vs 16-bit PCM) at import or load time.
+        /// Decoding is far cheaper than MP3/Vorbis and seeks are block-granular.
+        /// </summary>
+        ADPCM = 3
+    }
+
+    /// <summary>
+    /// Native load progress of a clip. Must match the C enum UNAudioLoadStatus.
+    /// </summary>
+    public enum AudioLoadStatus
+    {
+        /// <summary>No native data (never loaded or unloaded).</summary>
+        None = 0,
+        /// <summary>Queued for a background worker.</summary>
+        Pending = 1,
+        /// <summary>Format detection / decode in progress.</summary>
+        Loading = 2,
+        /// <summary>Ready to play.</summary>
+        Loaded = 3,
+        /// <summary>Unsupported format or decode error.</summary>
+        Failed = 4,
+        /// <summary>Cancelled before completion.</summary>
+        Cancelled = 5
     }
 
     /// <summary>
@@ -54,6 +78,11 @@ namespace UNAudio
         /// <summary>Whether audio data is currently loaded in the native engine.</summary>
         public bool IsLoaded => isLoaded;
 
+        /// <summary>Native load progress (useful after <see cref="LoadAudioDataAsync"/>).</summary>
+        public AudioLoadStatus LoadStatus =>
+            nativeHandle >= 0 ? (AudioLoadStatus)UNAudioBridge.GetLoadStatus(nativeHandle)
+                              : AudioLoadStatus.None;
+
         /// <summary>Whether the data is stored in a compressed format.</summary>
         public bool IsCompressed => loadType != AudioLoadType.DecompressOnLoad;
 
@@ -79,6 +108,67 @@ namespace UNAudio
             isLoaded = nativeHandle >= 0;
         }
 
+        /// <summary>
+        /// Load audio data on a native worker thread. The clip is playable once
+        /// <see cref="LoadStatus"/> reports <see cref="AudioLoadStatus.Loaded"/>.
+        /// </summary>
+        public void LoadAudioDataAsync()
+        {
+            if (isLoaded || compressedData == null || compressedData.Length == 0) return;
+
+            nativeHandle = UNAudioBridge.LoadAudioAsync(compressedData, (int)loadType);
+            isLoaded = nativeHandle >= 0;
+        }
+
+        /// <summary>
+        /// Keep the first <paramref name="milliseconds"/> of a compressed clip decoded
+        /// so playback starts without decoder warm-up (0 disables).
+        /// The clip must be loaded. Returns true on success, false for
+        /// <see cref="AudioLoadType.DecompressOnLoad"/> clips, which need no cache.
+        /// </summary>
+        public bool SetAttackCache(float milliseconds)
+        {
+            if (!isLoaded) return false;
+            return UNAudioBridge.SetAttackCache(nativeHandle, milliseconds) == 0;
+        }
+
+        /// <summary>Frames per bin at each waveform summary level.</summary>
+        public static readonly int[] WaveformBinFrames = { 256, 4096, 65536 };
+
+        /// <summary>
+        /// Min/max/RMS bins of the loaded clip at <paramref name="level"/>
+        /// (see <see cref="WaveformBinFrames"/>). The first call builds the
+        /// summary natively unless a sidecar was loaded. Returns null on failure.
+        /// </summary>
+        public UNAudioPeakBin[] GetWaveformPeaks(int level, int start = 0, int count = -1)
+        {
+            if (!isLoaded) return null;
+            int total = UNAudioBridge.GetWaveformPeaks(nativeHandle, level, 0, 0, null);
+            if (total < 0 || start < 0 || start > total) return null;
+            if (count < 0 || count > total - start) count = total - start;
+
+            var bins = new UNAudioPeakBin[count];
+            if (count == 0) return bins;
+            int got = UNAudioBridge.GetWaveformPeaks(nativeHandle, level, start, count, bins);
+            return got == count ? bins : null;
+        }
+
+        /// <summary>Waveform summary as a sidecar blob for <see cref="LoadWaveformPeaks"/>.</summary>
+        public byte[] SaveWaveformPeaks()
+        {
+            return isLoaded ? UNAudioBridge.SaveWaveformPeaks(nativeHandle) : null;
+        }
+
+        /// <summary>
+        /// Attach a cached waveform summary instead of rebuilding it.
+        /// Fails if the blob was built from a clip of a different length.
+        /// </summary>
+        public bool LoadWaveformPeaks(byte[] sidecar)
+        {
+            if (!isLoaded) return false;
+            return UNAudioBridge.LoadWaveformPeaks(nativeHandle, sidecar) == 0;
+        }
+
         /// <summary>Unload audio data from the native engine.</summary>
         public void UnloadAudioData()
         {
@@ -88,26 +178,46 @@ namespace UNAudio
             isLoaded = false;
         }
 
-        /// <summary>Get the size of the audio data currently in memory (bytes).</summary>
+        /// <summary>
+        /// Get the size of the audio data currently in memory (bytes): the native
+        /// total once loaded (see <see cref="GetNativeMemoryUsage"/>), otherwise
+        /// the managed compressed data.
+        /// </summary>
         public long GetMemorySize()
         {
+            if (isLoaded)
+            {
+                var usage = UNAudioBridge.GetClipMemory(nativeHandle);
+                return usage.compressedBytes + usage.pcmBytes + usage.streamBytes + usage.decoderBytes;
+            }
             if (compressedData != null)
                 return compressedData.Length;
             return 0;
         }
 
+        /// <summary>
+        /// Native memory held for this clip, by category. A DecompressOnLoad clip
+        /// demoted by the engine memory budget reports no PCM until it is replayed.
+        /// </summary>
+        public UNAudioMemoryUsage GetNativeMemoryUsage()
+        {
+            return isLoaded ? UNAudioBridge.GetClipMemory(nativeHandle) : default;
+        }
+
         internal int NativeHandle => nativeHandle;
 
         // ── Editor helpers ───────────────────────────────────────
 
         /// <summary>Initialise metadata (called by the importer).</summary>
-        internal void SetMetadata(int sr, int ch, int bps, float len, byte[] data)
+        internal void SetMetadata(int sr, int ch, int bps, float len, byte[] data,
+                                  AudioLoadType type = AudioLoadType.CompressedInMemory)
         {
             sampleRateValue   = sr;
             channelsValue     = ch;
             bitsPerSampleValue = bps;
             lengthValue       = len;
             compressedData    = data;
+            loadType          = type;
         }
 
         private void OnDestroy()
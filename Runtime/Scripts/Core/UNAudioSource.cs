@@ -2,6 +2,17 @@ using UnityEngine;
 
 namespace UNAudio
 {
+    /// <summary>
+    /// Shape of a native volume fade. Must match the C enum UNAudioFadeCurve.
+    /// </summary>
+    public enum FadeCurve
+    {
+        /// <summary>Straight line in amplitude.</summary>
+        Linear = 0,
+        /// <summary>Quarter sine/cosine; keeps loudness constant across a crossfade.</summary>
+        EqualPower = 1
+    }
+
     /// <summary>
     /// Component that plays back a <see cref="UNAudioClip"/> via the native engine.
     /// Attach to any GameObject – analogous to Unity's AudioSource.
@@ -18,6 +29,10 @@ namespace UNAudio
         [Tooltip("Loop playback.")]
         public bool loop;
 
+        [Range(0f, 1f)]
+        [Tooltip("Level sent to the engine's shared reverb (after volume).")]
+        public float reverbSend;
+
         [Range(0f, 1f)]
         [Tooltip("Spatial blend (0 = 2D, 1 = full 3D).")]
         public float spatialBlend;
@@ -45,6 +60,7 @@ namespace UNAudio
             EnsureLoaded();
             UNAudioBridge.SetVolume(clip.NativeHandle, volume);
             UNAudioBridge.SetLoop(clip.NativeHandle, loop);
+            UNAudioBridge.SetSendLevel(clip.NativeHandle, reverbSend);
             UNAudioBridge.Play(clip.NativeHandle);
         }
 
@@ -62,14 +78,60 @@ namespace UNAudio
             UNAudioBridge.Stop(clip.NativeHandle);
         }
 
+        /// <summary>
+        /// Fade the volume natively to <paramref name="target"/> over
+        /// <paramref name="seconds"/>; no per-frame script work is needed.
+        /// </summary>
+        public void FadeTo(float target, float seconds, FadeCurve curve = FadeCurve.Linear)
+        {
+            volume = target;
+            if (clip == null || clip.NativeHandle < 0) return;
+            UNAudioBridge.FadeVolume(clip.NativeHandle, target, seconds * 1000f, (int)curve);
+        }
+
+        /// <summary>
+        /// Equal-power crossfade from this source to <paramref name="other"/>,
+        /// which starts playing if needed. This source stops when the fade ends.
+        /// </summary>
+        public void CrossfadeTo(UNAudioSource other, float seconds)
+        {
+            if (other == null || other.clip == null) return;
+            if (clip == null || clip.NativeHandle < 0)
+            {
+                other.Play();
+                return;
+            }
+            other.EnsureLoaded();
+            UNAudioBridge.SetVolume(other.clip.NativeHandle, other.volume);
+            UNAudioBridge.SetLoop(other.clip.NativeHandle, other.loop);
+            UNAudioBridge.SetSendLevel(other.clip.NativeHandle, other.reverbSend);
+            UNAudioBridge.Crossfade(clip.NativeHandle, other.clip.NativeHandle, seconds * 1000f);
+        }
+
+        /// <summary>
+        /// Current levels and loudness of this source after its volume
+        /// (silent while not playing; integrated loudness covers the last play).
+        /// </summary>
+        public UNAudioLevels GetLevels()
+        {
+            if (clip == null || clip.NativeHandle < 0) return Silence;
+            levelHandle[0] = clip.NativeHandle;
+            UNAudioBridge.GetSourceLevels(levelHandle, 1, levelResult);
+            return levelResult[0];
+        }
+
         // ── Convenience statics ──────────────────────────────────
 
-        /// <summary>Play a clip once without needing a persistent component.</summary>
-        public static void PlayOneShot(UNAudioClip clip)
+        /// <summary>
+        /// Play a clip once without needing a persistent component.  Each call
+        /// starts a new voice, so overlapping one-shots of the same clip layer.
+        /// Returns the voice handle (-1 on failure).
+        /// </summary>
+        public static int PlayOneShot(UNAudioClip clip)
         {
-            if (clip == null) return;
+            if (clip == null) return -1;
             clip.LoadAudioData();
-            UNAudioBridge.Play(clip.NativeHandle);
+            return UNAudioBridge.PlayInstance(clip.NativeHandle);
         }
 
         /// <summary>Play a clip at a world position (3D).</summary>
@@ -90,6 +152,17 @@ namespace UNAudio
 
         // ── Internal ─────────────────────────────────────────────
 
+        // Reused by GetLevels so polling every frame does not allocate.
+        private static readonly int[] levelHandle = new int[1];
+        private static readonly UNAudioLevels[] levelResult = new UNAudioLevels[1];
+
+        private static readonly UNAudioLevels Silence = new UNAudioLevels
+        {
+            momentaryLufs  = float.NegativeInfinity,
+            shortTermLufs  = float.NegativeInfinity,
+            integratedLufs = float.NegativeInfinity
+        };
+
         private void EnsureLoaded()
         {
             if (clip != null && !clip.IsLoaded)
@@ -103,6 +176,7 @@ namespace UNAudio
             // Sync volume to native side
             UNAudioBridge.SetVolume(clip.NativeHandle, volume);
             UNAudioBridge.SetLoop(clip.NativeHandle, loop);
+            UNAudioBridge.SetSendLevel(clip.NativeHandle, reverbSend);
         }
 
         private void OnDestroy()
@@ -26,13 +26,73 @@ namespace UNAudio
             Debug.Log($"[UNAudio] Latency: {UNAudioBridge.GetCurrentLatency():F1} ms");
         }
 
+        /// <summary>
+        /// Record every native API call to <paramref name="path"/> for replay
+        /// with the unaudio_replay tool. Keeps the last <paramref name="capacity"/>
+        /// calls (0 = default).
+        /// </summary>
+        public static bool StartCallTrace(string path, int capacity = 0)
+        {
+            int result = UNAudioBridge.StartCallTrace(path, capacity);
+            if (result != 0)
+                Debug.LogWarning($"[UNAudio] StartCallTrace failed ({result}): {path}");
+            return result == 0;
+        }
+
+        /// <summary>Flush and close the call trace.</summary>
+        public static void StopCallTrace()
+        {
+            UNAudioBridge.StopCallTrace();
+        }
+
+        /// <summary>
+        /// Start timing the engine's hot paths (render, mix, decode) into
+        /// per-thread rings of the last <paramref name="capacity"/> zones
+        /// (0 = default). Fails in native builds without UNAUDIO_ZONES.
+        /// </summary>
+        public static bool StartZoneTrace(int capacity = 0)
+        {
+            int result = UNAudioBridge.StartZoneTrace(capacity);
+            if (result != 0)
+                Debug.LogWarning($"[UNAudio] StartZoneTrace failed ({result})");
+            return result == 0;
+        }
+
+        /// <summary>Stop timing zones; the captured ones stay available to DumpTrace.</summary>
+        public static void StopZoneTrace()
+        {
+            UNAudioBridge.StopZoneTrace();
+        }
+
+        /// <summary>
+        /// Write the captured zones as Chrome trace-event JSON (open in Perfetto
+        /// or chrome://tracing). Returns the number of zones written, or -1.
+        /// </summary>
+        public static int DumpTrace(string path)
+        {
+            int result = UNAudioBridge.DumpTrace(path);
+            if (result < 0)
+            {
+                Debug.LogWarning($"[UNAudio] DumpTrace failed ({result}): {path}");
+                return -1;
+            }
+            return result;
+        }
+
         /// <summary>Get a snapshot of engine performance stats.</summary>
         public static AudioPerformanceStats GetPerformanceStats()
         {
+            var memory = UNAudioBridge.GetMemoryStats();
+            var decode = UNAudioBridge.GetDecodeStats();
             return new AudioPerformanceStats
             {
-                latencyMs    = UNAudioBridge.GetCurrentLatency(),
-                masterVolume = UNAudioBridge.GetMasterVolume()
+                latencyMs       = UNAudioBridge.GetCurrentLatency(),
+                masterVolume    = UNAudioBridge.GetMasterVolume(),
+                memoryUsage     = memory.totalBytes,
+                memoryBudget    = memory.budgetBytes,
+                demotedClips    = memory.demotedClips,
+                decodeWorkers   = decode.workerCount,
+                decodeFallbacks = decode.fallbacks
             };
         }
     }
@@ -44,6 +104,11 @@ namespace UNAudio
     {
         public float latencyMs;
         public float masterVolume;
-        // TODO: cpuUsage, bufferUnderruns, activeVoices, memoryUsage
+        public long memoryUsage;    // native bytes, see UNAudioMemoryStats
+        public long memoryBudget;   // 0 = unlimited
+        public int demotedClips;
+        public int decodeWorkers;     // 0 = compressed voices decode in the audio callback
+        public long decodeFallbacks;  // blocks in which a voice's read-ahead ran dry
+        // TODO: cpuUsage, bufferUnderruns, activeVoices
     }
 }